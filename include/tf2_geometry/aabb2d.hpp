@@ -0,0 +1,142 @@
+#ifndef TF2_GEOMETRY__AABB2D_HPP
+#define TF2_GEOMETRY__AABB2D_HPP
+
+#include "tf2_geometry/linesegment2d.hpp"
+#include "tf2_geometry/point2d.hpp"
+
+namespace tf2 {
+
+/**
+ * class to represent an axis aligned bounding box [x_min, x_max] x [y_min, y_max], e.g. for culling in costmaps.
+ * A default box is empty with min = +inf and max = -inf so extending it with the first point sets both.
+ * The extend() overloads for arrays are min/max reductions with four scalar lanes (simd::min4, simd::max4), over the
+ * [x, y, z, w] records of Point2D or over four x and four y values at a time for structure of arrays input.
+ * Every extend() overload ignores NaN coordinates on every architecture, the other coordinate of the point is still used.
+ **/
+class AABB2D {
+  public:
+    /**
+     * constructor, empty box
+     **/
+    AABB2D();
+
+    /**
+     * constructor
+     * @param x_min
+     * @param y_min
+     * @param x_max
+     * @param y_max
+     **/
+    AABB2D(tf2Scalar x_min, tf2Scalar y_min, tf2Scalar x_max, tf2Scalar y_max);
+
+    /**
+     * sets the box
+     * @param x_min
+     * @param y_min
+     * @param x_max
+     * @param y_max
+     * @return ref to this
+     **/
+    AABB2D &set(tf2Scalar x_min, tf2Scalar y_min, tf2Scalar x_max, tf2Scalar y_max);
+
+    /**
+     * resets the box to empty
+     * @return ref to this
+     **/
+    AABB2D &clear();
+
+    /**
+     * @return true if the box holds no point
+     **/
+    bool empty() const;
+
+    tf2Scalar x_min() const;
+    tf2Scalar y_min() const;
+    tf2Scalar x_max() const;
+    tf2Scalar y_max() const;
+
+    /**
+     * @return center of the box
+     **/
+    Point2D center() const;
+
+    /**
+     * @return extent along x, 0 if empty
+     **/
+    tf2Scalar size_x() const;
+
+    /**
+     * @return extent along y, 0 if empty
+     **/
+    tf2Scalar size_y() const;
+
+    /**
+     * @return area, 0 if empty
+     **/
+    tf2Scalar area() const;
+
+    /**
+     * grows the box on all sides
+     * @param margin distance
+     * @return ref to this
+     **/
+    AABB2D &inflate(tf2Scalar margin);
+
+    /**
+     * extends the box to contain a point
+     * @param p point
+     * @return ref to this
+     **/
+    AABB2D &extend(const Point2D &p);
+
+    /**
+     * extends the box to contain an other box
+     * @param b box
+     * @return ref to this
+     **/
+    AABB2D &extend(const AABB2D &b);
+
+    /**
+     * extends the box to contain points
+     * @param points point array
+     * @param n number of points
+     * @return ref to this
+     **/
+    AABB2D &extend(const Point2D *points, size_t n);
+
+    /**
+     * extends the box to contain points
+     * @param xs x components, array with n elements
+     * @param ys y components, array with n elements
+     * @param n number of points
+     * @return ref to this
+     **/
+    AABB2D &extend(const tf2Scalar *xs, const tf2Scalar *ys, size_t n);
+
+    /**
+     * extends the box to contain line segments
+     * @param segments segment array
+     * @param n number of segments
+     * @return ref to this
+     **/
+    AABB2D &extend(const LineSegment2D *segments, size_t n);
+
+    /**
+     * @param p point
+     * @return true if the point is inside or on the border
+     **/
+    bool contains(const Point2D &p) const;
+
+    /**
+     * @param b box
+     * @return true if the boxes overlap or touch
+     **/
+    bool intersects(const AABB2D &b) const;
+
+  private:
+    tf2Scalar m_min[2]; /// x_min, y_min
+    tf2Scalar m_max[2]; /// x_max, y_max
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__AABB2D_HPP
@@ -0,0 +1,126 @@
+#ifndef TF2_GEOMETRY__CONVEX_HULL2D_HPP
+#define TF2_GEOMETRY__CONVEX_HULL2D_HPP
+
+#include <vector>
+#include "tf2_geometry/point2d.hpp"
+#include "tf2_geometry/transform2d.hpp"
+
+namespace tf2 {
+
+/**
+ * class to compute the convex hull of 2D points and the minimum area or minimum width bounding rectangle, e.g. of the
+ * clusters of a scan for object tracking. compute() uses Andrew's monotone chain in O(n log n), compute_ordered()
+ * uses Melkman's algorithm in O(n) for points which form a simple polyline, such as the points of a scan ordered by
+ * angle. The hull is stored counter clockwise without collinear points as structure of arrays together with the
+ * indices of its vertices in the input, all buffers are reused so the hulls of many clusters cause no allocations.
+ * The rectangles are found with rotating calipers in O(h) for h hull vertices.
+ **/
+class ConvexHull2D {
+  public:
+    /**
+     * constructor, empty hull
+     **/
+    ConvexHull2D();
+
+    /**
+     * computes the hull of unordered points
+     * @param points point array
+     * @param n number of points
+     * @return number of hull vertices
+     **/
+    size_t compute(const Point2D *points, size_t n);
+
+    /**
+     * computes the hull of unordered points
+     * @param xs x components, array with n elements
+     * @param ys y components, array with n elements
+     * @param n number of points
+     * @return number of hull vertices
+     **/
+    size_t compute(const tf2Scalar *xs, const tf2Scalar *ys, size_t n);
+
+    /**
+     * computes the hull of points which form a simple polyline in their order, e.g. scan points ordered by angle
+     * @param points point array
+     * @param n number of points
+     * @return number of hull vertices
+     **/
+    size_t compute_ordered(const Point2D *points, size_t n);
+
+    /**
+     * computes the hull of points which form a simple polyline in their order, e.g. scan points ordered by angle
+     * @param xs x components, array with n elements
+     * @param ys y components, array with n elements
+     * @param n number of points
+     * @return number of hull vertices
+     **/
+    size_t compute_ordered(const tf2Scalar *xs, const tf2Scalar *ys, size_t n);
+
+    /**
+     * @return number of hull vertices
+     **/
+    size_t size() const;
+
+    /**
+     * @return x of the hull vertices counter clockwise, array with size() elements
+     **/
+    const tf2Scalar *x() const;
+
+    /**
+     * @return y of the hull vertices counter clockwise, array with size() elements
+     **/
+    const tf2Scalar *y() const;
+
+    /**
+     * @return indices of the hull vertices in the input, array with size() elements
+     **/
+    const size_t *indices() const;
+
+    /**
+     * @param i hull vertex index
+     * @return hull vertex
+     **/
+    Point2D point(size_t i) const;
+
+    /**
+     * @return area of the hull
+     **/
+    tf2Scalar area() const;
+
+    /**
+     * finds the bounding rectangle with the minimal area, one side is collinear with a hull edge
+     * @param pose center of the rectangle, its x axis is along the length
+     * @param length extent along the x axis of pose, the longer side
+     * @param width extent along the y axis of pose
+     * @return area of the rectangle
+     **/
+    tf2Scalar min_area_rectangle(Transform2D &pose, tf2Scalar &length, tf2Scalar &width) const;
+
+    /**
+     * finds the bounding rectangle with the minimal width, the width of the hull
+     * @param pose center of the rectangle, its x axis is along the length
+     * @param length extent along the x axis of pose, the longer side
+     * @param width extent along the y axis of pose
+     * @return width of the rectangle
+     **/
+    tf2Scalar min_width_rectangle(Transform2D &pose, tf2Scalar &length, tf2Scalar &width) const;
+
+  private:
+    std::vector<tf2Scalar> m_x, m_y;       /// hull vertices
+    std::vector<size_t> m_indices;         /// hull vertices in the input
+    std::vector<tf2Scalar> m_px, m_py;     /// buffer for Point2D input
+    std::vector<size_t> m_buffer;          /// sorted points or deque
+
+    /**
+     * copies the hull vertices
+     **/
+    size_t assign(const tf2Scalar *xs, const tf2Scalar *ys, const size_t *indices, size_t n);
+
+    /**
+     * rotating calipers over the hull edges
+     **/
+    tf2Scalar calipers(bool area, Transform2D &pose, tf2Scalar &length, tf2Scalar &width) const;
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__CONVEX_HULL2D_HPP
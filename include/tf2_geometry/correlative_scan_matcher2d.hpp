@@ -0,0 +1,161 @@
+#ifndef TF2_GEOMETRY__CORRELATIVE_SCAN_MATCHER2D_HPP
+#define TF2_GEOMETRY__CORRELATIVE_SCAN_MATCHER2D_HPP
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/transform2d.hpp"
+
+namespace tf2 {
+
+class DistanceField2D; /// Prototype
+
+/**
+ * class to search the best pose of a scan in a window around a prior, e.g. for global relocalization or loop closure.
+ * The score of a pose is the mean grid value at the cells of the scan points, such as a likelihood field.
+ * The window is searched exhaustively in cell steps and heading steps with branch and bound (Olson, Hess et al.):
+ * level k of a pyramid holds for every cell the max of the 2^k x 2^k cells starting there, so the score of a
+ * point set on level k is an upper bound for all 2^k x 2^k translations it covers. Candidates are refined from the
+ * coarsest level downwards and pruned as soon as their bound is below the best full resolution score found.
+ * The scan is rotated once per heading with one sin/cos pair and discretized to cells, candidate translations are
+ * then integer offsets. The headings are prepared and the coarsest candidates scored in parallel on the execution
+ * policy, ThreadPool::shared() by default.
+ **/
+class CorrelativeScanMatcher2D {
+  public:
+    /**
+     * search parameters
+     **/
+    struct Config {
+        tf2Scalar linear_window = 1.0;   /// half size of the search window in x and y around the prior, at least 0
+        tf2Scalar angular_window = 0.5;  /// half size of the search window in rad around the prior, within [0, PI]
+        tf2Scalar angular_step = 0.0;    /// heading step in rad, zero moves the furthest scan point by one cell per step,
+                                         /// coarsened to at most 2^12 steps to each side
+        size_t levels = 7;               /// max pyramid levels, a cell of the coarsest covers 2^(levels - 1) cells
+        tf2Scalar min_score = 0.5;       /// candidates need a mean score above this value
+    };
+
+    /**
+     * search result
+     **/
+    struct Result {
+        Transform2D pose;         /// best pose of the scan in the map frame
+        tf2Scalar score = 0.0;    /// mean grid value of the scan points at pose
+        size_t candidates = 0;    /// number of candidates scored on all levels
+    };
+
+    /**
+     * constructor with default parameters
+     **/
+    CorrelativeScanMatcher2D();
+
+    /**
+     * constructor
+     * @param config search parameters
+     **/
+    CorrelativeScanMatcher2D(const Config &config);
+
+    /**
+     * changes the parameters
+     * @param config search parameters
+     **/
+    void configure(const Config &config);
+
+    /**
+     * @return current parameters
+     **/
+    const Config &config() const;
+
+    /**
+     * sets the execution policy for the preparation of the headings and the coarsest candidates
+     * @param policy execution policy
+     **/
+    void set_execution_policy(const ExecutionPolicy &policy);
+
+    /**
+     * sets the map and computes the pyramid, cells outside of the grid score zero
+     * @param grid cell values stored row wise, cell (x, y) at y * width + x, higher is better
+     * @param width number of columns
+     * @param height number of rows
+     * @param resolution cell size
+     * @param origin pose of the corner of cell (0, 0) in the map frame
+     * @return false and the map is cleared if the resolution is not finite and positive
+     **/
+    bool set_map(const float *grid, uint32_t width, uint32_t height, tf2Scalar resolution, const Transform2D &origin);
+
+    /**
+     * sets the map from the likelihood table of a distance field, or from 1 - d / max_distance if it has none
+     * @param field distance field
+     * @return false and the map is cleared if the resolution is not finite and positive
+     **/
+    bool set_map(const DistanceField2D &field);
+
+    /**
+     * @param level pyramid level
+     * @return cell maxima of level, cell (x, y) covers the cells [x, x + 2^level) x [y, y + 2^level) of level 0 and
+     * is stored at (y + 2^level - 1) * (width + 2^level - 1) + x + 2^level - 1
+     **/
+    const std::vector<float> &level(size_t level) const;
+
+    /**
+     * number of pyramid levels, at most Config::levels and no more than needed until a coarse cell spans the grid
+     * or the search window
+     * @return number of pyramid levels
+     **/
+    size_t levels() const;
+
+    /**
+     * searches the window around a prior
+     * @param scan scan points in the scan frame
+     * @param n number of points
+     * @param prior pose of the scan in the map frame, center of the window
+     * @param des result
+     * @return true if a pose with a score above min_score was found
+     **/
+    bool match(const Point2D *scan, size_t n, const Transform2D &prior, Result &des);
+
+  private:
+    /**
+     * candidate pose, offsets in cells
+     **/
+    struct Candidate {
+        int32_t heading;
+        int32_t dx, dy;
+        float score;
+    };
+
+    Config m_config;
+    std::optional<ExecutionPolicy> m_execution;  /// policy for the parallel parts, ThreadPool::shared() if not set
+    uint32_t m_width, m_height;
+    tf2Scalar m_resolution;
+    Transform2D m_origin;
+    std::vector<std::vector<float>> m_levels;    /// max pyramid
+    std::vector<tf2Scalar> m_cos, m_sin;         /// sin/cos table of the headings
+    std::vector<int32_t> m_cells;                /// scan cells per heading, x and y interleaved
+    size_t m_points;                             /// number of scan points of the current match
+
+    /**
+     * computes the pyramid levels above level 0
+     **/
+    void build_pyramid();
+
+    /**
+     * mean value of the scan cells of a heading shifted by an offset on a level
+     **/
+    float score(size_t level, int32_t heading, int32_t dx, int32_t dy) const;
+
+    /**
+     * refines candidates sorted by score until their bound drops to the best score
+     * @param level level of the candidates
+     * @param candidates candidates sorted by descending score
+     * @param n number of candidates
+     * @param window max offset
+     * @param best best level 0 candidate so far
+     * @param count number of candidates scored
+     **/
+    void search(size_t level, const Candidate *candidates, size_t n, int32_t window, Candidate &best, size_t &count) const;
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__CORRELATIVE_SCAN_MATCHER2D_HPP
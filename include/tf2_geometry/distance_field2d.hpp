@@ -0,0 +1,164 @@
+#ifndef TF2_GEOMETRY__DISTANCE_FIELD2D_HPP
+#define TF2_GEOMETRY__DISTANCE_FIELD2D_HPP
+
+#include <cstdint>
+#include <vector>
+#include "tf2_geometry/linesegment2d.hpp"
+#include "tf2_geometry/segment_rasterizer2d.hpp"
+#include "tf2_geometry/transform2d.hpp"
+
+namespace tf2 {
+
+/**
+ * class to precompute the distance to the closest segment of a map for every grid cell, e.g. a likelihood field
+ * for localization. The segments are rasterized and an exact Euclidean distance transform
+ * (Felzenszwalb and Huttenlocher) computes the distance of every cell center to the closest occupied cell in
+ * linear time. Scoring a point is then a single lookup instead of a search over the segments.
+ * Distances are truncated at max_distance, so a change of a few segments only affects the cells within
+ * max_distance of them and update() recomputes just that window.
+ * The grid layout matches SegmentRasterizer2D: cell (x, y) is stored at y * width + x and the origin is the
+ * pose of the corner of cell (0, 0) in the map frame.
+ **/
+class DistanceField2D {
+  public:
+    /**
+     * grid geometry and field parameters
+     **/
+    struct Config {
+        tf2Scalar resolution = 0.05;    /// cell size, values <= 0 or non-finite use the default
+        uint32_t width = 0;             /// number of columns
+        uint32_t height = 0;            /// number of rows
+        Transform2D origin;             /// pose of the corner of cell (0, 0) in the map frame
+        tf2Scalar max_distance = 2.0;   /// distances are truncated at this value, values <= 0 or non-finite use the default
+        tf2Scalar sigma = 0.0;          /// standard deviation of the Gaussian likelihood table, zero disables the table
+        size_t levels = 1;              /// resolution levels, cells of level k cover 2^k x 2^k cells of level 0,
+                                        /// no more than needed until a level has a single cell
+    };
+
+    /**
+     * constructor with default parameters
+     **/
+    DistanceField2D();
+
+    /**
+     * constructor
+     * @param config grid geometry and field parameters
+     **/
+    DistanceField2D(const Config &config);
+
+    /**
+     * changes the parameters, the field is empty until the next build()
+     * @param config grid geometry and field parameters
+     **/
+    void configure(const Config &config);
+
+    /**
+     * @return current parameters
+     **/
+    const Config &config() const;
+
+    /**
+     * computes the field of a segment map, the segments are copied for later updates
+     * @param segments segments in the map frame
+     * @param n number of segments
+     **/
+    void build(const LineSegment2D *segments, size_t n);
+
+    /**
+     * replaces the segment map and recomputes only the cells within max_distance of the segments
+     * which were added or removed compared to the last build() or update()
+     * @param segments all segments of the new map in the map frame
+     * @param n number of segments
+     * @return number of cells recomputed
+     **/
+    size_t update(const LineSegment2D *segments, size_t n);
+
+    /**
+     * distance of a point to the closest segment
+     * @param p point in the map frame
+     * @return distance of the cell center, max_distance outside of the grid
+     **/
+    tf2Scalar distance(const Point2D &p) const;
+
+    /**
+     * Gaussian likelihood exp(-d^2 / (2 sigma^2)) of a point
+     * @param p point in the map frame
+     * @return likelihood of the cell, 0 if sigma is not positive
+     **/
+    tf2Scalar likelihood(const Point2D &p) const;
+
+    /**
+     * distances of points to the closest segment
+     * @param points points in the map frame
+     * @param n number of points
+     * @param des distances, array with n elements
+     **/
+    void distances(const Point2D *points, size_t n, tf2Scalar *des) const;
+
+    /**
+     * sum of the likelihoods of points
+     * @param points points in the map frame
+     * @param n number of points
+     * @return sum of the likelihoods, 0 if sigma is not positive
+     **/
+    tf2Scalar score(const Point2D *points, size_t n) const;
+
+    /**
+     * cell index of a point
+     * @param p point in the map frame
+     * @param x column
+     * @param y row
+     * @return false if the point is outside of the grid
+     **/
+    bool cell(const Point2D &p, int64_t &x, int64_t &y) const;
+
+    /**
+     * @param level resolution level
+     * @return number of columns of a level
+     **/
+    uint32_t width(size_t level = 0) const;
+
+    /**
+     * @param level resolution level
+     * @return number of rows of a level
+     **/
+    uint32_t height(size_t level = 0) const;
+
+    /**
+     * distances of a level stored row wise, a cell of level k holds the minimal distance of the cells it covers
+     * so it is a lower bound for every point within the cell
+     * @param level resolution level
+     * @return distances with width(level) * height(level) elements
+     **/
+    const std::vector<float> &distances(size_t level = 0) const;
+
+    /**
+     * likelihood table of level 0 stored row wise, empty if sigma is zero
+     * @return likelihoods with width() * height() elements
+     **/
+    const std::vector<float> &likelihoods() const;
+
+  private:
+    Config m_config;
+    SegmentRasterizer2D m_rasterizer;          /// draws the segments into m_occupied
+    std::vector<LineSegment2D> m_segments;     /// segments of the current map
+    std::vector<int8_t> m_occupied;            /// rasterized segments
+    std::vector<std::vector<float>> m_levels;  /// distances per level
+    std::vector<float> m_likelihood;           /// likelihood table
+    std::vector<tf2Scalar> m_f, m_d, m_z;      /// distance transform buffers
+    std::vector<int64_t> m_v;                  /// distance transform buffer
+    std::vector<float> m_sq;                   /// squared distances of the window being recomputed
+
+    /**
+     * recomputes the distances of the cells in [x0, x1] x [y0, y1] and the dependent likelihoods and levels
+     **/
+    void compute(int64_t x0, int64_t y0, int64_t x1, int64_t y1);
+
+    /**
+     * one dimensional squared distance transform of m_f[0, n) into m_d[0, n)
+     **/
+    void transform_1d(size_t n);
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__DISTANCE_FIELD2D_HPP
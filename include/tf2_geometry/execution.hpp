@@ -0,0 +1,177 @@
+#ifndef TF2_GEOMETRY__EXECUTION_HPP
+#define TF2_GEOMETRY__EXECUTION_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tf2 {
+
+/**
+ * class to run index ranges on a fixed set of worker threads.
+ * The threads are started once and reused by every call. A call splits the range into chunks,
+ * every worker owns a contiguous share of the chunks and takes them one after the other,
+ * a worker which finished its share steals the remaining chunks of the others.
+ * The calling thread works as worker zero, so a pool with one thread runs everything inline.
+ * Calls from several threads are serialized, nested calls from within a task run inline.
+ **/
+class ThreadPool {
+  public:
+    /**
+     * pool parameters
+     **/
+    struct Config {
+        size_t num_threads = 0;  /// number of workers including the caller, zero uses the hardware concurrency
+        std::vector<int> cpus;   /// cpu for worker k is cpus[k % cpus.size()], the caller is not pinned, empty to disable pinning
+        size_t chunk_size = 0;   /// default number of indices per chunk, zero selects about four chunks per worker
+    };
+
+    /**
+     * constructor with default parameters
+     **/
+    ThreadPool();
+
+    /**
+     * constructor
+     * @param config pool parameters
+     **/
+    ThreadPool(const Config &config);
+
+    /**
+     * destructor, joins the workers
+     **/
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @return pool parameters
+     **/
+    const Config &config() const;
+
+    /**
+     * @return number of workers including the caller
+     **/
+    size_t size() const;
+
+    /**
+     * calls fn(begin, end) for consecutive chunks of [0, n) and returns after all chunks are done
+     * the first exception thrown by a task is rethrown after all workers stopped
+     * @param n number of indices
+     * @param chunk_size number of indices per chunk, zero uses the configured chunk size
+     * @param fn task
+     **/
+    void parallel_for(size_t n, size_t chunk_size, const std::function<void(size_t, size_t)> &fn);
+
+    /**
+     * @return process wide pool with the hardware concurrency, created on first use
+     **/
+    static ThreadPool &shared();
+
+  private:
+    /**
+     * chunks owned by one worker, padded to avoid false sharing
+     **/
+    struct alignas(64) Share {
+        std::atomic<size_t> next{0};  /// next chunk
+        size_t end = 0;               /// end of the chunks
+    };
+
+    void run(size_t worker);
+    void work(size_t worker);
+
+    Config m_config;
+    std::vector<std::thread> m_threads;             /// workers 1 .. size() - 1
+    std::unique_ptr<Share[]> m_shares;              /// chunk shares, one per worker
+    std::mutex m_call;                              /// serializes calls
+    std::mutex m_mutex;                             /// guards the job state below
+    std::condition_variable m_start, m_done;
+    uint64_t m_generation = 0;                      /// incremented for every job
+    size_t m_active = 0;                            /// workers still running the current job
+    bool m_stop = false;
+    const std::function<void(size_t, size_t)> *m_fn = nullptr;  /// current task
+    size_t m_n = 0, m_chunk = 0;                    /// range and chunk size of the current job
+    std::exception_ptr m_exception;                 /// first exception of the current job
+};
+
+/**
+ * class to select how a batch kernel runs: sequential on the calling thread, with the parallel
+ * standard algorithms or on a ThreadPool.
+ * The standard algorithms are only used if the library is built with TF2_GEOMETRY_ENABLE_STD_EXECUTION,
+ * otherwise parallel_unsequenced() runs on ThreadPool::shared().
+ * parallel_unsequenced() keeps its name but runs the chunks with std::execution::par, the chunks allocate,
+ * lock and count per thread and are therefore not safe for vectorization across chunks.
+ * Kernels split their input into chunks and process each chunk like the sequential overload,
+ * so the results do not depend on the policy.
+ **/
+class ExecutionPolicy {
+  public:
+    enum Kind {
+        kSequential = 0,       /// calling thread
+        kParallelUnsequenced,  /// std::execution::par, see above
+        kThreadPool,           /// ThreadPool
+    };
+
+    /**
+     * constructor, sequential execution
+     **/
+    ExecutionPolicy();
+
+    /**
+     * @return sequential execution on the calling thread
+     **/
+    static ExecutionPolicy sequential();
+
+    /**
+     * @param chunk_size number of indices per chunk, zero selects about four chunks per hardware thread
+     * @return execution with std::execution::par
+     **/
+    static ExecutionPolicy parallel_unsequenced(size_t chunk_size = 0);
+
+    /**
+     * @param pool pool which outlives the policy
+     * @param chunk_size number of indices per chunk, zero uses the chunk size of the pool
+     * @return execution on a thread pool
+     **/
+    static ExecutionPolicy thread_pool(ThreadPool &pool, size_t chunk_size = 0);
+
+    /**
+     * @return kind of execution
+     **/
+    Kind kind() const;
+
+    /**
+     * @return number of chunks which may run at the same time
+     **/
+    size_t concurrency() const;
+
+    /**
+     * calls fn(begin, end) for consecutive chunks of [0, n) using the chunk size of the policy
+     * @param n number of indices
+     * @param fn task, must be safe to call concurrently for disjoint chunks
+     **/
+    void for_each(size_t n, const std::function<void(size_t, size_t)> &fn) const;
+
+    /**
+     * calls fn(begin, end) for consecutive chunks of [0, n)
+     * @param n number of indices
+     * @param chunk_size number of indices per chunk, zero uses the chunk size of the policy
+     * @param fn task, must be safe to call concurrently for disjoint chunks
+     **/
+    void for_each(size_t n, size_t chunk_size, const std::function<void(size_t, size_t)> &fn) const;
+
+  private:
+    Kind m_kind;
+    ThreadPool *m_pool;   /// pool for kThreadPool
+    size_t m_chunk_size;  /// zero for automatic
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__EXECUTION_HPP
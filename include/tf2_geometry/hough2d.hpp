@@ -0,0 +1,192 @@
+#ifndef TF2_GEOMETRY__HOUGH2D_HPP
+#define TF2_GEOMETRY__HOUGH2D_HPP
+
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/line2d.hpp"
+
+namespace tf2 {
+
+/**
+ * class to detect lines in a 2D point set using a Hough transform.
+ * The points vote in a (theta, rho) accumulator with theta in [0, PI) and rho in [-rho_max, rho_max].
+ * Detected lines are returned in Hesse normal form x*cos(theta) + y*sin(theta) - rho = 0,
+ * which is a normalized Line2D with a = cos(theta), b = sin(theta) and c = -rho.
+ * All buffers are allocated on construction or on configure() and reused by detect().
+ * The voting is split into num_threads tasks which run on the execution policy, ThreadPool::shared() by default.
+ **/
+class HoughLines2D {
+  public:
+    /**
+     * detector parameters
+     **/
+    struct Config {
+        size_t theta_bins = 180;          /// number of angular cells over [0, PI)
+        tf2Scalar rho_resolution = 0.02;  /// size of a distance cell, values <= 0 use the default, at most 2^15 cells per side
+        tf2Scalar rho_max = 10.0;         /// points further away from the origin are ignored, non-finite values use the default
+        uint32_t threshold = 20;          /// minimal number of votes for a line
+        size_t nms_theta = 2;             /// half window size of the non-maximum suppression in theta cells
+        size_t nms_rho = 3;               /// half window size of the non-maximum suppression in rho cells
+        size_t max_lines = 32;            /// maximal number of lines returned, strongest first
+        size_t num_threads = 1;           /// number of voting tasks, each one owns a partial accumulator
+        size_t block_size = 256;          /// points processed per block while a tile of theta rows is hot in cache
+        size_t tile_bytes = 128 * 1024;   /// targeted size of an accumulator tile in bytes
+    };
+
+    /**
+     * detected accumulator peak
+     **/
+    struct Peak {
+        size_t theta_idx;  /// theta cell
+        size_t rho_idx;    /// rho cell
+        uint32_t votes;    /// votes in cell
+    };
+
+    /**
+     * constructor with default parameters
+     **/
+    HoughLines2D();
+
+    /**
+     * constructor
+     * @param config detector parameters
+     **/
+    HoughLines2D(const Config &config);
+
+    /**
+     * constructor, the internal buffers are allocated from a memory resource
+     * @param config detector parameters
+     * @param resource memory resource which outlives the detector, e.g. a pool filled at startup
+     **/
+    HoughLines2D(const Config &config, std::pmr::memory_resource *resource);
+
+    /**
+     * changes the parameters and reallocates the internal buffers
+     * @param config detector parameters
+     **/
+    void configure(const Config &config);
+
+    /**
+     * @return current parameters
+     **/
+    const Config &config() const;
+
+    /**
+     * sets the policy used to run the voting tasks
+     * @param policy execution policy
+     **/
+    void set_execution_policy(const ExecutionPolicy &policy);
+
+    /**
+     * detects lines
+     * @param points point array
+     * @param n number of points
+     * @param des detected lines, strongest first, caller owned array
+     * @param capacity number of elements of des, at most config().max_lines lines are detected
+     * @return number of detected lines
+     **/
+    size_t detect(const Point2D *points, size_t n, Line2D *des, size_t capacity);
+
+    /**
+     * detects lines
+     * the vector can use any allocator e.g. std::pmr::vector on an arena
+     * @param points point array
+     * @param n number of points
+     * @param des detected lines, strongest first, the vector is resized but its capacity reused
+     * @return number of detected lines
+     **/
+    template<typename Allocator>
+    size_t detect(const Point2D *points, size_t n, std::vector<Line2D, Allocator> &des) {
+        des.resize(m_config.max_lines);
+        des.resize(detect(points, n, des.data(), des.size()));
+        return des.size();
+    }
+
+    /**
+     * detects lines
+     * @param points points
+     * @param des detected lines, strongest first, the vector is resized but its capacity reused
+     * @return number of detected lines
+     **/
+    template<typename PointAllocator, typename Allocator>
+    size_t detect(const std::vector<Point2D, PointAllocator> &points, std::vector<Line2D, Allocator> &des) {
+        return detect(points.data(), points.size(), des);
+    }
+
+    /**
+     * peaks of the last detection matching the lines returned
+     * @return peaks, strongest first
+     **/
+    const std::pmr::vector<Peak> &peaks() const;
+
+    /**
+     * accumulator of the last detection stored row wise with theta_bins() rows and rho_bins() columns
+     * @return accumulator
+     **/
+    const std::pmr::vector<uint32_t> &accumulator() const;
+
+    /**
+     * @return number of theta cells
+     **/
+    size_t theta_bins() const;
+
+    /**
+     * @return number of rho cells
+     **/
+    size_t rho_bins() const;
+
+    /**
+     * angle of a theta cell
+     * @param theta_idx cell index
+     * @return angle in rad
+     **/
+    tf2Scalar theta(size_t theta_idx) const;
+
+    /**
+     * distance of a rho cell
+     * @param rho_idx cell index
+     * @return distance
+     **/
+    tf2Scalar rho(size_t rho_idx) const;
+
+    /**
+     * line of a accumulator cell in Hesse normal form
+     * @param theta_idx theta cell index
+     * @param rho_idx rho cell index
+     * @param des line
+     * @return ref to des
+     **/
+    Line2D &line(size_t theta_idx, size_t rho_idx, Line2D &des) const;
+
+  private:
+    Config m_config;
+    size_t m_rho_bins;                                /// number of rho cells
+    size_t m_rho_offset;                              /// rho cell of rho = 0
+    size_t m_tile_rows;                               /// theta rows per cache tile
+    std::pmr::vector<tf2Scalar> m_cos, m_sin;             /// precomputed cos/sin table pre-scaled by 1/rho_resolution
+    std::pmr::vector<tf2Scalar> m_points_x, m_points_y;   /// points in range as structure of arrays
+    std::pmr::vector<uint32_t> m_accumulator;             /// theta major accumulator
+    std::pmr::vector<std::pmr::vector<uint32_t>> m_partial; /// per task partial accumulators
+    std::pmr::vector<Peak> m_peaks;                       /// peaks of the last detection
+    std::optional<ExecutionPolicy> m_execution;           /// policy for the voting tasks, ThreadPool::shared() if not set
+
+    /**
+     * votes a range of points into an accumulator
+     * @param xs x components
+     * @param ys y components
+     * @param n number of points
+     * @param accumulator accumulator to vote into
+     **/
+    void vote(const tf2Scalar *xs, const tf2Scalar *ys, size_t n, uint32_t *accumulator) const;
+
+    /**
+     * finds local maxima above the threshold
+     **/
+    void suppress_non_maxima();
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__HOUGH2D_HPP
@@ -0,0 +1,154 @@
+#ifndef TF2_GEOMETRY__INSTRUMENTATION_HPP
+#define TF2_GEOMETRY__INSTRUMENTATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tf2 {
+namespace instrumentation {
+
+/**
+ * event counters
+ **/
+enum Counter : size_t {
+    kTransform2DCacheHit = 0,       /// cos/sin cache was valid on use
+    kTransform2DCacheRecompute,     /// recompute_cached_cos_sin calls
+    kTransform2DCacheInvalidate,    /// cache invalidations by set*()
+    kTransform2DCopy,               /// copy constructions
+    kCounterCount
+};
+
+/**
+ * batch kernels with call and element counters
+ **/
+enum Kernel : size_t {
+    kPlane3DDistances = 0,
+    kPlane3DClassify,
+    kPlane3DArrayContains,
+    kHoughLines2DDetect,
+    kRansacPlane3DEstimate,
+    kMoments3DAdd,
+    kPixelRayTableProject,
+    kMap2DToMap,
+    kMap2DToWorld,
+    kSegmentRasterizer2DRasterize,
+    kScanMatcher2DMatch,
+    kCorrelativeScanMatcher2DMatch,
+    kParticleSet2DMove,
+    kComposePrefix,
+    kConvexHull2DCompute,
+    kAABB2DExtend,
+    kOBB2DIntersects,
+    kKernelCount
+};
+
+/**
+ * counter values at a point in time, summed over all threads
+ **/
+struct Snapshot {
+    uint64_t counters[kCounterCount];  /// event counters
+    uint64_t calls[kKernelCount];      /// kernel calls
+    uint64_t elements[kKernelCount];   /// elements processed by the kernels
+};
+
+/**
+ * callback for tracepoints at kernel entry and exit, e.g. to forward them to LTTng
+ * @param kernel kernel
+ * @param elements number of elements processed by the call
+ * @param begin true on entry and false on exit
+ **/
+using TraceCallback = void (*)(Kernel kernel, size_t elements, bool begin);
+
+/**
+ * @return true if the library was built with TF2_GEOMETRY_ENABLE_COUNTERS
+ **/
+bool enabled();
+
+/**
+ * sums the counters of all threads, the counters are only updated if enabled()
+ * @param des snapshot
+ * @return ref to des
+ **/
+Snapshot &snapshot(Snapshot &des);
+
+/**
+ * sets all counters to zero
+ **/
+void reset();
+
+/**
+ * @param counter
+ * @return name of a counter
+ **/
+const char *name(Counter counter);
+
+/**
+ * @param kernel
+ * @return name of a kernel
+ **/
+const char *name(Kernel kernel);
+
+/**
+ * sets the tracepoint callback, tracepoints are only emitted with TF2_GEOMETRY_ENABLE_TRACEPOINTS
+ * @param callback callback or nullptr to disable
+ **/
+void set_trace_callback(TraceCallback callback);
+
+/**
+ * @return tracepoint callback or nullptr
+ **/
+TraceCallback trace_callback();
+
+/**
+ * adds to an event counter of the calling thread, use TF2_GEOMETRY_COUNT
+ **/
+void count(Counter counter, uint64_t n);
+
+/**
+ * adds a kernel call to the counters of the calling thread, use TF2_GEOMETRY_KERNEL
+ **/
+void count(Kernel kernel, uint64_t elements);
+
+/**
+ * emits the entry and exit tracepoints of a kernel call, use TF2_GEOMETRY_KERNEL
+ **/
+class TraceScope {
+    Kernel m_kernel;
+    size_t m_elements;
+    TraceCallback m_callback;
+
+  public:
+    TraceScope(Kernel kernel, size_t elements) : m_kernel(kernel), m_elements(elements), m_callback(trace_callback()) {
+        if (m_callback) m_callback(m_kernel, m_elements, true);
+    }
+    ~TraceScope() {
+        if (m_callback) m_callback(m_kernel, m_elements, false);
+    }
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+};
+
+}  // namespace instrumentation
+}  // namespace tf2
+
+/**
+ * instrumentation macros, they compile to nothing unless the library is built with
+ * TF2_GEOMETRY_ENABLE_COUNTERS or TF2_GEOMETRY_ENABLE_TRACEPOINTS
+ **/
+#if defined(TF2_GEOMETRY_ENABLE_COUNTERS)
+#define TF2_GEOMETRY_COUNT(counter) tf2::instrumentation::count(tf2::instrumentation::counter, 1)
+#define TF2_GEOMETRY_KERNEL_COUNT(kernel, elements) tf2::instrumentation::count(tf2::instrumentation::kernel, elements)
+#else
+#define TF2_GEOMETRY_COUNT(counter) ((void)0)
+#define TF2_GEOMETRY_KERNEL_COUNT(kernel, elements) ((void)0)
+#endif
+
+#if defined(TF2_GEOMETRY_ENABLE_TRACEPOINTS)
+#define TF2_GEOMETRY_KERNEL(kernel, elements)                                                      \
+    TF2_GEOMETRY_KERNEL_COUNT(kernel, elements);                                                   \
+    const tf2::instrumentation::TraceScope tf2_geometry_trace_scope(tf2::instrumentation::kernel, elements)
+#else
+#define TF2_GEOMETRY_KERNEL(kernel, elements) TF2_GEOMETRY_KERNEL_COUNT(kernel, elements)
+#endif
+
+#endif  // TF2_GEOMETRY__INSTRUMENTATION_HPP
@@ -0,0 +1,226 @@
+#ifndef TF2_GEOMETRY__KD_TREE2D_HPP
+#define TF2_GEOMETRY__KD_TREE2D_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "tf2_geometry/point2d.hpp"
+
+namespace tf2 {
+
+class ExecutionPolicy; /// Prototype
+
+/**
+ * static kd-tree for nearest neighbour queries on 2D points, e.g. scan to scan matching, clustering or outlier filters.
+ * The points are copied into a flat array of compact records and sorted in place so every node covers a contiguous
+ * range: a node splits its range at the median of the axis with the larger extent, the left child gets the first half.
+ * The nodes are stored in heap order (children of node i are 2 i + 1 and 2 i + 2) and hold only the split value and
+ * axis, the ranges follow from the median rule during the descent.
+ * All distances are squared to avoid the sqrt, results refer to the index of the point in the array passed to build().
+ **/
+class KdTree2D {
+  public:
+    /// returned by the queries if no point is found
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /**
+     * constructor, empty tree
+     **/
+    KdTree2D();
+
+    /**
+     * builds the tree, points with non-finite coordinates are skipped
+     * @param points point array
+     * @param n number of points
+     * @param leaf_size ranges with up to leaf_size points are not split further
+     **/
+    void build(const Point2D *points, size_t n, size_t leaf_size = 8);
+
+    /**
+     * builds the tree, the nodes of a level are split in chunks on an execution policy,
+     * points with non-finite coordinates are skipped
+     * @param policy execution policy
+     * @param points point array
+     * @param n number of points
+     * @param leaf_size ranges with up to leaf_size points are not split further
+     **/
+    void build(const ExecutionPolicy &policy, const Point2D *points, size_t n, size_t leaf_size = 8);
+
+    /**
+     * @return number of points in the tree, without the skipped non-finite ones
+     **/
+    size_t size() const;
+
+    /**
+     * @return max number of points in a leaf
+     **/
+    size_t leaf_size() const;
+
+    /**
+     * finds the closest point
+     * @param p point
+     * @param max_distance_sqrt squared search radius, points at or beyond are ignored
+     * @param distance_sqrt optional squared distance to the closest point
+     * @return index of the closest point or npos if there is none within the radius
+     **/
+    size_t nearest(const Point2D &p, tf2Scalar max_distance_sqrt = std::numeric_limits<tf2Scalar>::infinity(),
+                   tf2Scalar *distance_sqrt = nullptr) const;
+
+    /**
+     * finds a point which is at most (1 + epsilon) times further away than the closest point,
+     * subtrees which cannot improve the result by this factor are skipped
+     * @param p point
+     * @param epsilon relative error bound, zero gives the exact result
+     * @param max_distance_sqrt squared search radius, points at or beyond are ignored
+     * @param distance_sqrt optional squared distance to the point found
+     * @return index of the point found or npos if there is none within the radius
+     **/
+    size_t approximate_nearest(const Point2D &p, tf2Scalar epsilon,
+                               tf2Scalar max_distance_sqrt = std::numeric_limits<tf2Scalar>::infinity(),
+                               tf2Scalar *distance_sqrt = nullptr) const;
+
+    /**
+     * finds the k closest points
+     * @param p point
+     * @param k number of neighbours
+     * @param indices indices of the neighbours sorted by distance, array with k elements
+     * @param distances_sqrt squared distances of the neighbours, array with k elements
+     * @param max_distance_sqrt squared search radius, points at or beyond are ignored
+     * @return number of neighbours found, the remaining elements are set to npos and infinity
+     **/
+    size_t knn(const Point2D &p, size_t k, size_t *indices, tf2Scalar *distances_sqrt,
+               tf2Scalar max_distance_sqrt = std::numeric_limits<tf2Scalar>::infinity()) const;
+
+    /**
+     * finds all points within a radius
+     * @param p point
+     * @param radius_sqrt squared radius, points on the circle are included
+     * @param des indices of the points in ascending order, the vector is cleared but its capacity reused
+     * @return number of points found
+     **/
+    template<typename Allocator>
+    size_t radius(const Point2D &p, tf2Scalar radius_sqrt, std::vector<size_t, Allocator> &des) const {
+        des.clear();
+        radius(0, 0, m_items.size(), p.x(), p.y(), radius_sqrt, des);
+        std::sort(des.begin(), des.end());
+        return des.size();
+    }
+
+    /**
+     * finds the closest point of every point
+     * @param points point array
+     * @param n number of points
+     * @param max_distance_sqrt squared search radius
+     * @param indices index of the closest point or npos, array with n elements
+     * @param distances_sqrt optional squared distances to the closest point or infinity, array with n elements
+     * @return number of points with a neighbour within the radius
+     **/
+    size_t nearest(const Point2D *points, size_t n, tf2Scalar max_distance_sqrt, size_t *indices,
+                   tf2Scalar *distances_sqrt = nullptr) const;
+
+    /**
+     * finds the closest point of every point in chunks on an execution policy
+     * @param policy execution policy
+     * @param points point array
+     * @param n number of points
+     * @param max_distance_sqrt squared search radius
+     * @param indices index of the closest point or npos, array with n elements
+     * @param distances_sqrt optional squared distances to the closest point or infinity, array with n elements
+     * @return number of points with a neighbour within the radius
+     **/
+    size_t nearest(const ExecutionPolicy &policy, const Point2D *points, size_t n, tf2Scalar max_distance_sqrt,
+                   size_t *indices, tf2Scalar *distances_sqrt = nullptr) const;
+
+    /**
+     * finds the k closest points of every point
+     * @param points point array
+     * @param n number of points
+     * @param k number of neighbours
+     * @param indices neighbours of point i at i * k, array with n * k elements
+     * @param distances_sqrt squared distances of the neighbours, array with n * k elements
+     * @param max_distance_sqrt squared search radius
+     **/
+    void knn(const Point2D *points, size_t n, size_t k, size_t *indices, tf2Scalar *distances_sqrt,
+             tf2Scalar max_distance_sqrt = std::numeric_limits<tf2Scalar>::infinity()) const;
+
+    /**
+     * finds the k closest points of every point in chunks on an execution policy
+     * @param policy execution policy
+     * @param points point array
+     * @param n number of points
+     * @param k number of neighbours
+     * @param indices neighbours of point i at i * k, array with n * k elements
+     * @param distances_sqrt squared distances of the neighbours, array with n * k elements
+     * @param max_distance_sqrt squared search radius
+     **/
+    void knn(const ExecutionPolicy &policy, const Point2D *points, size_t n, size_t k, size_t *indices,
+             tf2Scalar *distances_sqrt, tf2Scalar max_distance_sqrt = std::numeric_limits<tf2Scalar>::infinity()) const;
+
+  private:
+    /**
+     * point record in tree order
+     **/
+    struct Item {
+        tf2Scalar x, y;
+        size_t index;    /// index in the array passed to build()
+    };
+
+    /**
+     * inner node
+     **/
+    struct Node {
+        tf2Scalar split;  /// coordinate of the median
+        uint32_t axis;    /// 0 for x and 1 for y
+    };
+
+    std::vector<Item> m_items;  /// points sorted into the node ranges
+    std::vector<Node> m_nodes;  /// inner nodes in heap order
+    size_t m_leaf_size;
+
+    /**
+     * splits the range of an inner node
+     **/
+    void split(size_t node, size_t begin, size_t end);
+
+    /**
+     * descends to the closest point, subtrees closer than best_sqrt / scale are visited
+     **/
+    void nearest(size_t node, size_t begin, size_t end, tf2Scalar x, tf2Scalar y, tf2Scalar scale, size_t &best,
+                 tf2Scalar &best_sqrt) const;
+
+    /**
+     * descends to the k closest points, count neighbours are already in indices and distances_sqrt
+     **/
+    void knn(size_t node, size_t begin, size_t end, tf2Scalar x, tf2Scalar y, size_t k, size_t *indices,
+             tf2Scalar *distances_sqrt, size_t &count, tf2Scalar max_distance_sqrt) const;
+
+    /**
+     * descends to all points within a radius
+     **/
+    template<typename Allocator>
+    void radius(size_t node, size_t begin, size_t end, tf2Scalar x, tf2Scalar y, tf2Scalar radius_sqrt,
+                std::vector<size_t, Allocator> &des) const {
+        if (end - begin <= m_leaf_size) {
+            for (size_t i = begin; i < end; i++) {
+                const tf2Scalar dx = m_items[i].x - x, dy = m_items[i].y - y;
+                if (dx * dx + dy * dy <= radius_sqrt) {
+                    des.push_back(m_items[i].index);
+                }
+            }
+            return;
+        }
+        const Node &n = m_nodes[node];
+        const size_t mid = begin + (end - begin) / 2;
+        const tf2Scalar diff = (n.axis == 0 ? x : y) - n.split;
+        if (diff <= 0.0 || diff * diff <= radius_sqrt) {
+            radius(2 * node + 1, begin, mid, x, y, radius_sqrt, des);
+        }
+        if (diff >= 0.0 || diff * diff <= radius_sqrt) {
+            radius(2 * node + 2, mid, end, x, y, radius_sqrt, des);
+        }
+    }
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__KD_TREE2D_HPP
@@ -0,0 +1,118 @@
+#ifndef TF2_GEOMETRY__LINE2D_T_HPP
+#define TF2_GEOMETRY__LINE2D_T_HPP
+
+#include "tf2_geometry/line2d.hpp"
+#include "tf2_geometry/pack.hpp"
+
+namespace tf2 {
+
+/**
+ * class to represent a line equation a*x + b*y + c = 0 for a scalar type T.
+ * T can be float, double or a simd::Pack, the latter evaluates N independent lines at once.
+ **/
+template<typename T>
+class Line2DT {
+  protected:
+    T m_a, m_b, m_c;  /// line equation
+
+  public:
+    using Scalar = T;
+
+    /**
+     * constructor
+     **/
+    Line2DT() : m_a(0.), m_b(0.), m_c(0.) {}
+
+    /**
+     * constructor to create a line from points
+     * @param x0
+     * @param y0
+     * @param x1
+     * @param y1
+     * @param normalize normalizes equation on true
+     **/
+    Line2DT(const T &x0, const T &y0, const T &x1, const T &y1, bool normalize = true) {
+        create(x0, y0, x1, y1, normalize);
+    }
+
+    /**
+     * constructor from a Line2D, a pack gets the same line in all lanes
+     * @param src line
+     **/
+    explicit Line2DT(const Line2D &src) : m_a(src.a()), m_b(src.b()), m_c(src.c()) {}
+
+    /**
+     * creates a line from points
+     * @param x0
+     * @param y0
+     * @param x1
+     * @param y1
+     * @param normalize normalizes equation on true
+     * @return ref to this
+     **/
+    Line2DT &create(const T &x0, const T &y0, const T &x1, const T &y1, bool normalize = true) {
+        m_a = y0 - y1, m_b = x1 - x0, m_c = x0 * y1 - y0 * x1; /// cross product with homogenios vectors
+        if (normalize) {
+            this->normalize();
+        }
+        return *this;
+    }
+
+    const T &a() const {
+        return m_a;
+    }
+    const T &b() const {
+        return m_b;
+    }
+    const T &c() const {
+        return m_c;
+    }
+
+    /**
+     * normalizes the equation so that a*a + b*b = 1
+     **/
+    void normalize() {
+        const T r = T(1.) / simd::sqrt(m_a * m_a + m_b * m_b);
+        m_a = m_a * r, m_b = m_b * r, m_c = m_c * r;
+    }
+
+    /**
+     * computes the signed distance to a point, requires a normalized equation
+     * @param x
+     * @param y
+     * @return distance
+     **/
+    T distance_to(const T &x, const T &y) const {
+        return m_a * x + m_b * y + m_c;
+    }
+
+    /**
+     * computes the closest point on the line, requires a normalized equation
+     * @param x
+     * @param y
+     * @param des_x closest point x
+     * @param des_y closest point y
+     **/
+    void point_on_line(const T &x, const T &y, T &des_x, T &des_y) const {
+        const T d = distance_to(x, y);
+        des_x = x - d * m_a, des_y = y - d * m_b;
+    }
+
+    /**
+     * computes the intersection with a line
+     * @param l line
+     * @param des_x intersection x, inf or nan for parallel lines
+     * @param des_y intersection y, inf or nan for parallel lines
+     **/
+    void intersection(const Line2DT &l, T &des_x, T &des_y) const {
+        const T w = m_a * l.m_b - m_b * l.m_a;
+        des_x = (m_b * l.m_c - m_c * l.m_b) / w;
+        des_y = (m_c * l.m_a - m_a * l.m_c) / w;
+    }
+};
+
+using Line2Df = Line2DT<float>;
+using Line2Dd = Line2DT<double>;
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__LINE2D_T_HPP
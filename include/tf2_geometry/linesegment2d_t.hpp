@@ -0,0 +1,142 @@
+#ifndef TF2_GEOMETRY__LINESEGMENT2D_T_HPP
+#define TF2_GEOMETRY__LINESEGMENT2D_T_HPP
+
+#include "tf2_geometry/line2d_t.hpp"
+#include "tf2_geometry/linesegment2d.hpp"
+
+namespace tf2 {
+
+/**
+ * class to represent a 2D line with its endpoints for a scalar type T.
+ * T can be float, double or a simd::Pack, the latter evaluates N independent segments at once.
+ * The endpoint clamping uses min/max instead of branches so that all lanes follow the same path.
+ **/
+template<typename T>
+class LineSegment2DT : public Line2DT<T> {
+  protected:
+    T m_x0, m_y0, m_x1, m_y1; /// the lines endpoints
+
+  public:
+    // This is the type of the base class
+    using Base = Line2DT<T>;
+
+    /**
+     * constructor
+     **/
+    LineSegment2DT() : m_x0(0.), m_y0(0.), m_x1(0.), m_y1(0.) {}
+
+    /**
+     * constructor to create a line from points
+     * @param x0
+     * @param y0
+     * @param x1
+     * @param y1
+     **/
+    LineSegment2DT(const T &x0, const T &y0, const T &x1, const T &y1) {
+        set(x0, y0, x1, y1);
+    }
+
+    /**
+     * constructor from a LineSegment2D, a pack gets the same segment in all lanes
+     * @param src segment
+     **/
+    explicit LineSegment2DT(const LineSegment2D &src) {
+        set(T(src.x0()), T(src.y0()), T(src.x1()), T(src.y1()));
+    }
+
+    /**
+     * sets the endpoints and the normalized line equation
+     * @param x0
+     * @param y0
+     * @param x1
+     * @param y1
+     * @return ref to this
+     **/
+    LineSegment2DT &set(const T &x0, const T &y0, const T &x1, const T &y1) {
+        Base::create(x0, y0, x1, y1, true);
+        m_x0 = x0, m_y0 = y0, m_x1 = x1, m_y1 = y1;
+        return *this;
+    }
+
+    const T &x0() const {
+        return m_x0;
+    }
+    const T &y0() const {
+        return m_y0;
+    }
+    const T &x1() const {
+        return m_x1;
+    }
+    const T &y1() const {
+        return m_y1;
+    }
+
+    /**
+     * @return distance between the endpoints
+     **/
+    T length() const {
+        const T dx = m_x1 - m_x0, dy = m_y1 - m_y0;
+        return simd::sqrt(dx * dx + dy * dy);
+    }
+
+    /**
+     * orientation of the line in space
+     * @retun angle between -PI and PI
+     **/
+    T angle() const {
+        return simd::atan2(m_y1 - m_y0, m_x1 - m_x0);
+    }
+
+    /**
+     * ratio of the closest point on the segment, 0 at p0 and 1 at p1
+     * @param x
+     * @param y
+     * @return ratio between 0 and 1
+     **/
+    T closest_point_to_ratio(const T &x, const T &y) const {
+        const T px = m_x1 - m_x0, py = m_y1 - m_y0;
+        const T u = ((x - m_x0) * px + (y - m_y0) * py) / (px * px + py * py);
+        return simd::min(simd::max(u, T(0.)), T(1.));
+    }
+
+    /**
+     * closest point on the segment
+     * @param x
+     * @param y
+     * @param des_x closest point x
+     * @param des_y closest point y
+     **/
+    void closest_point_to(const T &x, const T &y, T &des_x, T &des_y) const {
+        const T u = closest_point_to_ratio(x, y);
+        des_x = m_x0 + u * (m_x1 - m_x0), des_y = m_y0 + u * (m_y1 - m_y0);
+    }
+
+    /**
+     * computes squared distance to line segment
+     * @param x
+     * @param y
+     * @return squared distance to line between the segment endpoints or to the nearest endpoint
+     **/
+    T distance_to_sqrt(const T &x, const T &y) const {
+        T xk, yk;
+        closest_point_to(x, y, xk, yk);
+        const T dx = xk - x, dy = yk - y;
+        return dx * dx + dy * dy;
+    }
+
+    /**
+     * computes distance to line segment
+     * @param x
+     * @param y
+     * @return distance to line between the segment endpoints or to the nearest endpoint
+     **/
+    T distance_to(const T &x, const T &y) const {
+        return simd::sqrt(distance_to_sqrt(x, y));
+    }
+};
+
+using LineSegment2Df = LineSegment2DT<float>;
+using LineSegment2Dd = LineSegment2DT<double>;
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__LINESEGMENT2D_T_HPP
@@ -1,34 +1,155 @@
-#ifndef TUW2_GEOMETRY__MAP2D_HPP
-#define TUW2_GEOMETRY__MAP2D_HPP
+#ifndef TF2_GEOMETRY__MAP2D_HPP
+#define TF2_GEOMETRY__MAP2D_HPP
 
-#include <Eigen/Dense>
 #include <memory>
-#include <tuw2_geometry/core.hpp>
+#include "tf2_geometry/plane3d.hpp"
+#include "tf2_geometry/transform2d.hpp"
 
-namespace tuw2 {
+namespace tf2 {
 
 class Map2D; /// Prototype
+class ExecutionPolicy; /// Prototype
 using Map2DPtr = std::shared_ptr<Map2D>;
 using Map2DConstPtr = std::shared_ptr<Map2D const>;
 
 /**
- * class to represent a Map 2D in a 3D space
+ * class to represent a Map 2D in a 3D space.
+ * The map lies on a Plane3D. The plane frame has its origin on the plane and two orthonormal in-plane axes,
+ * the map origin is a Transform2D within the plane frame. Both are fused into two projection vectors,
+ * so mapping a point costs three dot products and lifting it back three scaled additions.
  **/
 class Map2D {
-    Plane2D plane_; // plane of the map
-    t origin_; // origin on the plane
-  public:
+  protected:
+    Plane3D m_plane;          /// plane of the map with a normalized normal
+    Point3D m_plane_origin;   /// origin of the plane frame
+    Vector3 m_ex, m_ey;       /// in-plane axes of the plane frame
+    Transform2D m_origin;     /// map origin within the plane frame
+    Vector3 m_u, m_v;         /// map axes in 3D
+    Vector3 m_map_origin;     /// map origin in 3D
+    tf2Scalar m_u0, m_v0;     /// map coordinates of the 3D origin
+
+    /**
+     * updates the fused map axes after the plane or the origin changed
+     **/
+    void update();
+
+    /**
+     * projects 3D points into map coordinates without heights, not instrumented
+     **/
+    void to_map_range(const Point3D *src, size_t n, Point2D *des) const;
 
+    /**
+     * lifts map points back into 3D, not instrumented
+     **/
+    void to_world_range(const Point2D *src, size_t n, Point3D *des, const tf2Scalar *heights) const;
+
+  public:
+    /**
+     * constructor, the map is the x-y plane with z = 0
+     **/
     Map2D();
 
     /**
      * creates the map plane from a point which is also the origin and a normal
+     * the x axis of the plane frame is the projection of the global x axis onto the plane
      * @param p point on the plane and origin of the map
      * @param n normal of the plane
      **/
     void create(const Vector3 &p, const Vector3 &n);
-    
+
+    /**
+     * creates the map plane from a point which is also the origin, a normal and the direction of the x axis
+     * @param p point on the plane and origin of the map
+     * @param n normal of the plane
+     * @param x_axis direction of the x axis, it is projected onto the plane
+     *               if it is zero, non-finite or parallel to the normal the default x axis of create(p, n) is used
+     **/
+    void create(const Vector3 &p, const Vector3 &n, const Vector3 &x_axis);
+
+    /**
+     * sets the map origin within the plane frame
+     * @param origin pose of the map origin
+     **/
+    void set_origin(const Transform2D &origin);
+
+    /**
+     * @return map origin within the plane frame
+     **/
+    const Transform2D &origin() const;
+
+    /**
+     * @return plane of the map
+     **/
+    const Plane3D &plane() const;
+
+    /**
+     * projects a 3D point into map coordinates
+     * @param src point in 3D
+     * @param des point in map coordinates
+     * @return ref to des
+     **/
+    Point2D &to_map(const Point3D &src, Point2D &des) const;
+
+    /**
+     * projects a 3D point into map coordinates
+     * @param src point in 3D
+     * @return point in map coordinates
+     **/
+    Point2D to_map(const Point3D &src) const;
+
+    /**
+     * lifts a map point onto the plane
+     * @param src point in map coordinates
+     * @param des point in 3D
+     * @return ref to des
+     **/
+    Point3D &to_world(const Point2D &src, Point3D &des) const;
+
+    /**
+     * lifts a map point onto the plane
+     * @param src point in map coordinates
+     * @return point in 3D
+     **/
+    Point3D to_world(const Point2D &src) const;
+
+    /**
+     * projects 3D points into map coordinates
+     * @param src points in 3D
+     * @param n number of points
+     * @param des points in map coordinates, array with n elements
+     * @param heights optional signed distances to the plane, array with n elements
+     **/
+    void to_map(const Point3D *src, size_t n, Point2D *des, tf2Scalar *heights = nullptr) const;
+
+    /**
+     * lifts map points back into 3D
+     * @param src points in map coordinates
+     * @param n number of points
+     * @param des points in 3D, array with n elements
+     * @param heights optional signed distances to the plane, array with n elements, the points are lifted onto the plane if null
+     **/
+    void to_world(const Point2D *src, size_t n, Point3D *des, const tf2Scalar *heights = nullptr) const;
+
+    /**
+     * projects 3D points into map coordinates in chunks on an execution policy
+     * @param policy execution policy
+     * @param src points in 3D
+     * @param n number of points
+     * @param des points in map coordinates, array with n elements
+     * @param heights optional signed distances to the plane, array with n elements
+     **/
+    void to_map(const ExecutionPolicy &policy, const Point3D *src, size_t n, Point2D *des, tf2Scalar *heights = nullptr) const;
+
+    /**
+     * lifts map points back into 3D in chunks on an execution policy
+     * @param policy execution policy
+     * @param src points in map coordinates
+     * @param n number of points
+     * @param des points in 3D, array with n elements
+     * @param heights optional signed distances to the plane, array with n elements, the points are lifted onto the plane if null
+     **/
+    void to_world(const ExecutionPolicy &policy, const Point2D *src, size_t n, Point3D *des, const tf2Scalar *heights = nullptr) const;
 };
-}; // namespace tuw2
+}; // namespace tf2
 
-#endif // TUW2_GEOMETRY__MAP2D_HPP
\ No newline at end of file
+#endif // TF2_GEOMETRY__MAP2D_HPP
@@ -0,0 +1,72 @@
+#ifndef TF2_GEOMETRY__MEMORY_HPP
+#define TF2_GEOMETRY__MEMORY_HPP
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace tf2 {
+
+/**
+ * class to provide a per-cycle monotonic arena for std::pmr containers.
+ * The buffer is allocated once at construction, an allocation is a pointer bump and
+ * deallocations are ignored. reset() at the start of every control cycle releases
+ * all memory handed out in the previous cycle at once.
+ * Allocations beyond the capacity are forwarded to the upstream resource, by default
+ * std::pmr::null_memory_resource() which throws std::bad_alloc, so an undersized arena
+ * is detected instead of silently allocating on the heap.
+ * The arena is not thread safe, use one arena per thread.
+ **/
+class MonotonicArena : public std::pmr::memory_resource {
+  public:
+    /**
+     * constructor
+     * @param capacity size of the buffer in bytes
+     * @param upstream resource for allocations exceeding the buffer
+     **/
+    MonotonicArena(size_t capacity, std::pmr::memory_resource *upstream = std::pmr::null_memory_resource());
+
+    MonotonicArena(const MonotonicArena &) = delete;
+    MonotonicArena &operator=(const MonotonicArena &) = delete;
+
+    /**
+     * releases all allocations, containers using the arena must not be used afterwards
+     **/
+    void reset();
+
+    /**
+     * @return size of the buffer in bytes
+     **/
+    size_t capacity() const;
+
+    /**
+     * @return bytes allocated from the buffer since the last reset
+     **/
+    size_t used() const;
+
+    /**
+     * @return maximal number of bytes used in a cycle since construction, including upstream allocations
+     **/
+    size_t peak() const;
+
+    /**
+     * @return bytes allocated from the upstream resource since the last reset
+     **/
+    size_t overflow() const;
+
+  protected:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+  private:
+    std::unique_ptr<std::byte[]> m_buffer;   /// arena buffer
+    size_t m_capacity;                       /// size of the buffer
+    size_t m_used;                           /// bytes used in the current cycle
+    size_t m_overflow;                       /// upstream bytes in the current cycle
+    size_t m_peak;                           /// maximal bytes used in a cycle
+    std::pmr::memory_resource *m_upstream;   /// resource for allocations exceeding the buffer
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__MEMORY_HPP
@@ -0,0 +1,116 @@
+#ifndef TF2_GEOMETRY__MOMENTS3D_HPP
+#define TF2_GEOMETRY__MOMENTS3D_HPP
+
+#include <cstddef>
+#include "tf2_geometry/plane3d.hpp"
+
+namespace tf2 {
+
+/**
+ * class to accumulate the first and second moments of a 3D point set.
+ * Points can be added, removed and accumulators merged in constant time using the
+ * numerically stable updates of Welford and Chan, which makes it suitable for region growing and
+ * per voxel normals. The best fitting plane is the eigenvector of the smallest eigenvalue of the
+ * scatter matrix, computed in closed form.
+ **/
+class Moments3D {
+  protected:
+    size_t m_n;              /// number of points
+    Vector3 m_mean;          /// mean
+    tf2Scalar m_scatter[6];  /// sum of squared deviations from the mean xx, xy, xz, yy, yz, zz
+
+  public:
+    /**
+     * constructor
+     **/
+    Moments3D();
+
+    /**
+     * removes all points
+     * @return this reference
+     **/
+    Moments3D &clear();
+
+    /**
+     * adds a point
+     * @param p point
+     * @return this reference
+     **/
+    Moments3D &add(const Point3D &p);
+
+    /**
+     * adds points, the block is accumulated in two passes and merged
+     * @param points point array
+     * @param n number of points
+     * @return this reference
+     **/
+    Moments3D &add(const Point3D *points, size_t n);
+
+    /**
+     * removes a point which was added before
+     * @param p point
+     * @return this reference
+     **/
+    Moments3D &remove(const Point3D &p);
+
+    /**
+     * merges the moments of an other point set
+     * @param o moments
+     * @return this reference
+     **/
+    Moments3D &merge(const Moments3D &o);
+
+    /**
+     * @return number of points
+     **/
+    size_t count() const;
+
+    /**
+     * @return mean of the points
+     **/
+    const Vector3 &mean() const;
+
+    /**
+     * covariance matrix
+     * @param des matrix
+     **/
+    void covariance(tf2Scalar des[3][3]) const;
+
+    /**
+     * eigenvalues of the covariance matrix
+     * @param des eigenvalues in ascending order
+     **/
+    void eigenvalues(tf2Scalar des[3]) const;
+
+    /**
+     * surface variation lambda_min / (lambda_0 + lambda_1 + lambda_2), zero for planar points
+     * @return curvature
+     **/
+    tf2Scalar curvature() const;
+
+    /**
+     * computes the least squares plane through the points
+     * @param des plane with a normalized normal through the mean
+     * @return false if the points do not define a plane
+     **/
+    bool fit(Plane3D &des) const;
+
+    /**
+     * computes the eigenvalues of a symmetric 3x3 matrix in closed form
+     * @see https://en.wikipedia.org/wiki/Eigenvalue_algorithm#3%C3%973_matrices
+     * @param A symmetric matrix
+     * @param des eigenvalues in ascending order
+     **/
+    static void eigenvalues(const tf2Scalar A[3][3], tf2Scalar des[3]);
+
+    /**
+     * computes the eigenvector to the smallest eigenvalue of a symmetric 3x3 matrix in closed form
+     * @param A symmetric matrix
+     * @param des eigenvector with unit length
+     * @return false if the smallest eigenvalue is not distinct
+     **/
+    static bool smallest_eigenvector(const tf2Scalar A[3][3], Vector3 &des);
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__MOMENTS3D_HPP
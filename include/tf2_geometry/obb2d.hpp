@@ -0,0 +1,160 @@
+#ifndef TF2_GEOMETRY__OBB2D_HPP
+#define TF2_GEOMETRY__OBB2D_HPP
+
+#include <cstdint>
+#include "tf2_geometry/aabb2d.hpp"
+#include "tf2_geometry/linesegment2d.hpp"
+#include "tf2_geometry/transform2d.hpp"
+
+namespace tf2 {
+
+class ExecutionPolicy; /// Prototype
+
+/**
+ * class to represent an oriented bounding box as center pose with length along its x axis and width along its y axis,
+ * e.g. robot footprints for conflict checks or the rectangles of ConvexHull2D.
+ * The center, cos and sin of the rotation and the half extents are stored so the separating axis tests need no
+ * trigonometry: two boxes are disjoint if their projections on one of the four box axes do not overlap, a box and a
+ * segment if they are separated along one of the two box axes or the segment normal.
+ * Boxes and segments which touch intersect. A box built from an empty AABB2D is empty, it contains and intersects
+ * nothing.
+ **/
+class OBB2D {
+  public:
+    /**
+     * constructor, box of size zero at the origin
+     **/
+    OBB2D();
+
+    /**
+     * constructor
+     * @param pose center and rotation
+     * @param length extent along the x axis of pose
+     * @param width extent along the y axis of pose
+     **/
+    OBB2D(const Transform2D &pose, tf2Scalar length, tf2Scalar width);
+
+    /**
+     * constructor, axis aligned box
+     * @param box box, an empty box gives an empty box at the origin
+     **/
+    OBB2D(const AABB2D &box);
+
+    /**
+     * sets the box
+     * @param pose center and rotation
+     * @param length extent along the x axis of pose
+     * @param width extent along the y axis of pose
+     * @return ref to this
+     **/
+    OBB2D &set(const Transform2D &pose, tf2Scalar length, tf2Scalar width);
+
+    /**
+     * @return true if the box was built from an empty AABB2D or with a negative extent
+     **/
+    bool empty() const;
+
+    /**
+     * @return center and rotation
+     **/
+    Transform2D pose() const;
+
+    /**
+     * @return center
+     **/
+    Point2D center() const;
+
+    /**
+     * @return extent along the x axis of the pose, 0 if empty
+     **/
+    tf2Scalar length() const;
+
+    /**
+     * @return extent along the y axis of the pose, 0 if empty
+     **/
+    tf2Scalar width() const;
+
+    /**
+     * corners counter clockwise starting at -length/2, -width/2
+     * @param i corner index 0 - 3
+     * @return corner, the center if empty
+     **/
+    Point2D corner(size_t i) const;
+
+    /**
+     * @return axis aligned bounding box, empty if this is empty
+     **/
+    AABB2D aabb() const;
+
+    /**
+     * @param p point
+     * @return true if the point is inside or on the border
+     **/
+    bool contains(const Point2D &p) const;
+
+    /**
+     * separating axis test with an other box
+     * @param o box
+     * @return true if the boxes overlap or touch
+     **/
+    bool intersects(const OBB2D &o) const;
+
+    /**
+     * separating axis test with a line segment
+     * @param s segment
+     * @return true if the segment overlaps or touches the box
+     **/
+    bool intersects(const LineSegment2D &s) const;
+
+    /**
+     * separating axis tests with many boxes
+     * @param boxes box array
+     * @param n number of boxes
+     * @param mask set to 1 if the box intersects, array with n elements
+     * @return number of intersecting boxes
+     **/
+    size_t intersects(const OBB2D *boxes, size_t n, uint8_t *mask) const;
+
+    /**
+     * separating axis tests with many boxes in chunks on an execution policy
+     * @param policy execution policy
+     * @param boxes box array
+     * @param n number of boxes
+     * @param mask set to 1 if the box intersects, array with n elements
+     * @return number of intersecting boxes
+     **/
+    size_t intersects(const ExecutionPolicy &policy, const OBB2D *boxes, size_t n, uint8_t *mask) const;
+
+    /**
+     * separating axis tests with many line segments
+     * @param segments segment array
+     * @param n number of segments
+     * @param mask set to 1 if the segment intersects, array with n elements
+     * @return number of intersecting segments
+     **/
+    size_t intersects(const LineSegment2D *segments, size_t n, uint8_t *mask) const;
+
+    /**
+     * separating axis tests with many line segments in chunks on an execution policy
+     * @param policy execution policy
+     * @param segments segment array
+     * @param n number of segments
+     * @param mask set to 1 if the segment intersects, array with n elements
+     * @return number of intersecting segments
+     **/
+    size_t intersects(const ExecutionPolicy &policy, const LineSegment2D *segments, size_t n, uint8_t *mask) const;
+
+  private:
+    tf2Scalar m_x, m_y;                      /// center
+    tf2Scalar m_rotation, m_cos, m_sin;      /// rotation
+    tf2Scalar m_half_length, m_half_width;   /// half extents
+
+    /**
+     * tests an array of boxes or segments, not instrumented
+     * @return number of intersecting elements
+     **/
+    template<typename T> size_t intersects_range(const T *src, size_t n, uint8_t *mask) const;
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__OBB2D_HPP
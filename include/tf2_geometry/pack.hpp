@@ -0,0 +1,202 @@
+#ifndef TF2_GEOMETRY__PACK_HPP
+#define TF2_GEOMETRY__PACK_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include "tf2_geometry/simd.hpp"
+
+namespace tf2 {
+namespace simd {
+
+/**
+ * N independent scalars which are processed as one value.
+ * The templated geometry classes e.g. Transform2DT<Pack<float, 8>> use it to evaluate N poses,
+ * lines or planes at once. The operators are plain loops over a fixed size aligned array,
+ * which the compiler maps onto SIMD registers of the target architecture.
+ * N has to be a power of two since the pack is aligned to its size.
+ **/
+template<typename T, size_t N>
+struct alignas(sizeof(T) * N) Pack {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "Pack: N has to be a power of two");
+    T v[N];
+
+    /**
+     * constructor, the values are uninitialized
+     **/
+    Pack() = default;
+
+    /**
+     * constructor, sets all values to s
+     * @param s scalar
+     **/
+    Pack(const T &s) {
+        for (size_t i = 0; i < N; i++) v[i] = s;
+    }
+
+    /**
+     * loads N values
+     * @param src array with N elements
+     * @return pack
+     **/
+    static Pack load(const T *src) {
+        Pack p;
+        for (size_t i = 0; i < N; i++) p.v[i] = src[i];
+        return p;
+    }
+
+    /**
+     * stores N values
+     * @param des array with N elements
+     **/
+    void store(T *des) const {
+        for (size_t i = 0; i < N; i++) des[i] = v[i];
+    }
+
+    /**
+     * @return number of values
+     **/
+    static constexpr size_t size() {
+        return N;
+    }
+
+    T &operator[](size_t i) {
+        return v[i];
+    }
+    const T &operator[](size_t i) const {
+        return v[i];
+    }
+
+    Pack &operator+=(const Pack &o) {
+        for (size_t i = 0; i < N; i++) v[i] += o.v[i];
+        return *this;
+    }
+    Pack &operator-=(const Pack &o) {
+        for (size_t i = 0; i < N; i++) v[i] -= o.v[i];
+        return *this;
+    }
+    Pack &operator*=(const Pack &o) {
+        for (size_t i = 0; i < N; i++) v[i] *= o.v[i];
+        return *this;
+    }
+    Pack &operator/=(const Pack &o) {
+        for (size_t i = 0; i < N; i++) v[i] /= o.v[i];
+        return *this;
+    }
+    Pack operator-() const {
+        Pack p;
+        for (size_t i = 0; i < N; i++) p.v[i] = -v[i];
+        return p;
+    }
+    friend Pack operator+(Pack a, const Pack &b) {
+        return a += b;
+    }
+    friend Pack operator-(Pack a, const Pack &b) {
+        return a -= b;
+    }
+    friend Pack operator*(Pack a, const Pack &b) {
+        return a *= b;
+    }
+    friend Pack operator/(Pack a, const Pack &b) {
+        return a /= b;
+    }
+};
+
+using Pack4f = Pack<float, 4>;
+using Pack8f = Pack<float, 8>;
+using Pack2d = Pack<double, 2>;
+using Pack4d = Pack<double, 4>;
+
+/**
+ * applies a scalar function to all values of a pack
+ **/
+template<typename T, size_t N, typename F>
+Pack<T, N> apply(const Pack<T, N> &a, F f) {
+    Pack<T, N> p;
+    for (size_t i = 0; i < N; i++) p.v[i] = f(a.v[i]);
+    return p;
+}
+
+/**
+ * applies a scalar function to all value pairs of two packs
+ **/
+template<typename T, size_t N, typename F>
+Pack<T, N> apply(const Pack<T, N> &a, const Pack<T, N> &b, F f) {
+    Pack<T, N> p;
+    for (size_t i = 0; i < N; i++) p.v[i] = f(a.v[i], b.v[i]);
+    return p;
+}
+
+/**
+ * math functions for scalars and packs, templated code calls them with the simd:: prefix
+ **/
+template<typename T> T sqrt(const T &a) { return std::sqrt(a); }
+template<typename T> T sin(const T &a) { return std::sin(a); }
+template<typename T> T cos(const T &a) { return std::cos(a); }
+template<typename T> T floor(const T &a) { return std::floor(a); }
+template<typename T> T abs(const T &a) { return std::abs(a); }
+template<typename T> T asin(const T &a) { return std::asin(a); }
+template<typename T> T atan2(const T &y, const T &x) { return std::atan2(y, x); }
+template<typename T> T min(const T &a, const T &b) { return std::min(a, b); }
+template<typename T> T max(const T &a, const T &b) { return std::max(a, b); }
+
+template<typename T, size_t N> Pack<T, N> sqrt(const Pack<T, N> &a) {
+    return apply(a, [](T x) { return std::sqrt(x); });
+}
+template<typename T, size_t N> Pack<T, N> sin(const Pack<T, N> &a) {
+    return apply(a, [](T x) { return std::sin(x); });
+}
+template<typename T, size_t N> Pack<T, N> cos(const Pack<T, N> &a) {
+    return apply(a, [](T x) { return std::cos(x); });
+}
+template<typename T, size_t N> Pack<T, N> floor(const Pack<T, N> &a) {
+    return apply(a, [](T x) { return std::floor(x); });
+}
+template<typename T, size_t N> Pack<T, N> abs(const Pack<T, N> &a) {
+    return apply(a, [](T x) { return std::abs(x); });
+}
+template<typename T, size_t N> Pack<T, N> atan2(const Pack<T, N> &y, const Pack<T, N> &x) {
+    return apply(y, x, [](T a, T b) { return std::atan2(a, b); });
+}
+template<typename T, size_t N> Pack<T, N> asin(const Pack<T, N> &a) {
+    return apply(a, [](T x) { return std::asin(x); });
+}
+
+/**
+ * packs of tf2Scalar use the polynomial simd::atan2_4 and simd::asin4 for groups of four lanes,
+ * within 1 ULP of std::atan2 and 3 ULP of std::asin, remaining lanes call std::
+ **/
+template<size_t N> Pack<tf2Scalar, N> atan2(const Pack<tf2Scalar, N> &y, const Pack<tf2Scalar, N> &x) {
+    Pack<tf2Scalar, N> r;
+    size_t i = 0;
+    for (; i + 4 <= N; i += 4) atan2_4(y.v + i, x.v + i, r.v + i);
+    for (; i < N; i++) r.v[i] = std::atan2(y.v[i], x.v[i]);
+    return r;
+}
+template<size_t N> Pack<tf2Scalar, N> asin(const Pack<tf2Scalar, N> &a) {
+    Pack<tf2Scalar, N> r;
+    size_t i = 0;
+    for (; i + 4 <= N; i += 4) asin4(a.v + i, r.v + i);
+    for (; i < N; i++) r.v[i] = std::asin(a.v[i]);
+    return r;
+}
+template<typename T, size_t N> Pack<T, N> min(const Pack<T, N> &a, const Pack<T, N> &b) {
+    return apply(a, b, [](T x, T y) { return x < y ? x : y; });
+}
+template<typename T, size_t N> Pack<T, N> max(const Pack<T, N> &a, const Pack<T, N> &b) {
+    return apply(a, b, [](T x, T y) { return x > y ? x : y; });
+}
+
+/**
+ * normalizes an angle between -PI and PI without branches, for any magnitude
+ * @param a angle
+ * @return normalized angle
+ **/
+template<typename T> T angle_normalize(const T &a) {
+    const T two_pi(2.0 * M_PI), pi(M_PI);
+    return a - two_pi * simd::floor((a + pi) / two_pi);
+}
+
+}  // namespace simd
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__PACK_HPP
@@ -0,0 +1,190 @@
+#ifndef TF2_GEOMETRY__PARTICLE_SET2D_HPP
+#define TF2_GEOMETRY__PARTICLE_SET2D_HPP
+
+#include <functional>
+#include <random>
+#include <vector>
+#include "tf2_geometry/transform2d.hpp"
+
+namespace tf2 {
+
+class ExecutionPolicy; /// Prototype
+
+/**
+ * class to hold the particles of a 2D particle filter in structure of arrays layout.
+ * Every particle is a pose x, y, theta with cos(theta), sin(theta) and a weight, six scalars in separate arrays
+ * instead of a Transform2D object each. The motion update composes the particles with an odometry delta in
+ * packs of four with Transform2DT<simd::Pack>, without noise the cos and sin of the particles are updated with the
+ * angle addition theorem so no trigonometry is needed at all. The measurement update calls a model on ranges of
+ * particles which fills their likelihoods, e.g. by scoring a scan against a DistanceField2D.
+ **/
+class ParticleSet2D {
+  public:
+    /**
+     * standard deviations of the motion noise, applied to the odometry delta in the frame of the particle
+     **/
+    struct Noise {
+        tf2Scalar x = 0.0;
+        tf2Scalar y = 0.0;
+        tf2Scalar theta = 0.0;
+    };
+
+    /**
+     * measurement model, writes the likelihoods of the particles [begin, end) to likelihoods[0, end - begin)
+     **/
+    using MeasurementModel = std::function<void(const ParticleSet2D &particles, size_t begin, size_t end, tf2Scalar *likelihoods)>;
+
+    /**
+     * constructor, empty set
+     **/
+    ParticleSet2D();
+
+    /**
+     * constructor
+     * @param n number of particles, at the identity with equal weights
+     **/
+    ParticleSet2D(size_t n);
+
+    /**
+     * changes the number of particles, new particles are at the identity and all weights are reset to 1 / n
+     * @param n number of particles
+     **/
+    void resize(size_t n);
+
+    /**
+     * @return number of particles
+     **/
+    size_t size() const;
+
+    /**
+     * sets all particles to a pose with equal weights
+     * @param pose pose
+     **/
+    void fill(const Transform2D &pose);
+
+    /**
+     * sets a particle
+     * @param i particle index
+     * @param pose pose
+     **/
+    void set(size_t i, const Transform2D &pose);
+
+    /**
+     * @param i particle index
+     * @return pose of a particle
+     **/
+    Transform2D pose(size_t i) const;
+
+    /**
+     * @return array with size() elements
+     **/
+    const tf2Scalar *x() const;
+    /**
+     * @return array with size() elements
+     **/
+    const tf2Scalar *y() const;
+    /**
+     * @return array with size() elements
+     **/
+    const tf2Scalar *theta() const;
+    /**
+     * @return cos(theta), array with size() elements
+     **/
+    const tf2Scalar *cos() const;
+    /**
+     * @return sin(theta), array with size() elements
+     **/
+    const tf2Scalar *sin() const;
+    /**
+     * @return weights, array with size() elements
+     **/
+    const tf2Scalar *weights() const;
+    /**
+     * @return weights, array with size() elements
+     **/
+    tf2Scalar *weights();
+
+    /**
+     * composes every particle with an odometry delta, pose = pose * delta
+     * @param delta motion in the frame of the particle
+     **/
+    void move(const Transform2D &delta);
+
+    /**
+     * composes every particle with an odometry delta plus noise, pose = pose * (delta + noise)
+     * @param delta motion in the frame of the particle
+     * @param noise_x noise added to the x of delta, array with size() elements
+     * @param noise_y noise added to the y of delta, array with size() elements
+     * @param noise_theta noise added to the rotation of delta, array with size() elements
+     **/
+    void move(const Transform2D &delta, const tf2Scalar *noise_x, const tf2Scalar *noise_y, const tf2Scalar *noise_theta);
+
+    /**
+     * composes every particle with an odometry delta plus normal distributed noise
+     * @param delta motion in the frame of the particle
+     * @param noise standard deviations of the noise
+     * @param generator random number generator e.g. std::mt19937
+     **/
+    template<typename Generator>
+    void move(const Transform2D &delta, const Noise &noise, Generator &generator) {
+        const size_t n = size();
+        m_noise.resize(3 * n);
+        std::normal_distribution<tf2Scalar> normal;
+        const tf2Scalar sigma[3] = {noise.x, noise.y, noise.theta};
+        for (size_t k = 0; k < 3; k++) {
+            tf2Scalar *des = m_noise.data() + k * n;
+            for (size_t i = 0; i < n; i++) {
+                des[i] = sigma[k] > 0.0 ? sigma[k] * normal(generator) : 0.0;
+            }
+        }
+        move(delta, m_noise.data(), m_noise.data() + n, m_noise.data() + 2 * n);
+    }
+
+    /**
+     * multiplies the weights with the likelihoods of a measurement model
+     * @param model measurement model, called once for all particles
+     **/
+    void weigh(const MeasurementModel &model);
+
+    /**
+     * multiplies the weights with the likelihoods of a measurement model called on chunks of particles
+     * @param policy execution policy
+     * @param model measurement model, called concurrently for disjoint ranges
+     **/
+    void weigh(const ExecutionPolicy &policy, const MeasurementModel &model);
+
+    /**
+     * scales the weights to a sum of one, zero weights become equal weights
+     * @return sum of the weights before the scaling
+     **/
+    tf2Scalar normalize();
+
+    /**
+     * @return effective sample size 1 / sum(w^2) of normalized weights
+     **/
+    tf2Scalar effective_size() const;
+
+    /**
+     * weighted mean pose, the rotation is the circular mean
+     * @return mean pose
+     **/
+    Transform2D mean() const;
+
+    /**
+     * low variance resampling, draws size() particles proportional to their normalized weights
+     * @param u random offset in [0, 1)
+     **/
+    void resample(tf2Scalar u);
+
+  private:
+    std::vector<tf2Scalar> m_x, m_y, m_theta;  /// poses
+    std::vector<tf2Scalar> m_cos, m_sin;       /// cos and sin of theta
+    std::vector<tf2Scalar> m_weight;           /// weights
+    std::vector<tf2Scalar> m_noise;            /// buffer of the sampled noise
+    std::vector<tf2Scalar> m_likelihood;       /// buffer of the measurement model
+    std::vector<tf2Scalar> m_swap;             /// buffer for resampling
+    std::vector<size_t> m_source;              /// particles drawn by resampling
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__PARTICLE_SET2D_HPP
@@ -0,0 +1,171 @@
+#ifndef TF2_GEOMETRY__PIXEL_RAY_TABLE_HPP
+#define TF2_GEOMETRY__PIXEL_RAY_TABLE_HPP
+
+#include <cstdint>
+#include <vector>
+#include "tf2/LinearMath/Transform.hpp"
+#include "tf2_geometry/plane3d.hpp"
+#include "tf2_geometry/point2d.hpp"
+
+namespace tf2 {
+
+class ExecutionPolicy; /// Prototype
+
+/**
+ * class to project image pixels of a pinhole camera onto a plane, e.g. the ground.
+ * The ray direction of every pixel is computed once from the intrinsics and rotated into the
+ * parent frame whenever the camera pose changes. A projection is then a single pass over the
+ * ray table stored as structure of arrays, with one division per pixel and no trigonometry.
+ * The intersections are returned as 2D coordinates in the frame of the plane, see plane_frame(),
+ * which equal the parent x, y coordinates for horizontal planes such as the ground.
+ * The camera uses the optical frame convention with z forward, x right and y down.
+ **/
+class PixelRayTable {
+  public:
+    /**
+     * pinhole camera intrinsics
+     **/
+    struct Intrinsics {
+        tf2Scalar fx = 1.0;  /// focal length x in pixels, zero or non-finite values use the default
+        tf2Scalar fy = 1.0;  /// focal length y in pixels, zero or non-finite values use the default
+        tf2Scalar cx = 0.0;  /// principal point x in pixels, non-finite values use the default
+        tf2Scalar cy = 0.0;  /// principal point y in pixels, non-finite values use the default
+        size_t width = 0;    /// image width in pixels
+        size_t height = 0;   /// image height in pixels
+    };
+
+    /**
+     * constructor
+     **/
+    PixelRayTable();
+
+    /**
+     * constructor, the camera pose is set to identity
+     * @param intrinsics camera intrinsics
+     **/
+    PixelRayTable(const Intrinsics &intrinsics);
+
+    /**
+     * sets the intrinsics and precomputes the pixel rays
+     * @param intrinsics camera intrinsics
+     **/
+    void set_intrinsics(const Intrinsics &intrinsics);
+
+    /**
+     * @return camera intrinsics
+     **/
+    const Intrinsics &intrinsics() const;
+
+    /**
+     * sets the camera pose and rotates the rays into the parent frame
+     * @param pose camera pose in the parent frame
+     **/
+    void set_pose(const Transform &pose);
+
+    /**
+     * @return camera pose in the parent frame
+     **/
+    const Transform &pose() const;
+
+    /**
+     * @return number of pixels
+     **/
+    size_t size() const;
+
+    /**
+     * ray direction of a pixel in the parent frame, the z component of the ray in the camera frame is one
+     * @param u column
+     * @param v row
+     * @return ray direction
+     **/
+    Vector3 ray(size_t u, size_t v) const;
+
+    /**
+     * frame of a plane in which the intersections are expressed.
+     * The origin is the point of the plane closest to the parent origin, the z axis is the plane normal turned
+     * upwards, the x axis is the parent x axis projected onto the plane or the parent y axis if x is nearly normal
+     * to the plane. For horizontal planes the x and y axes are those of the parent frame.
+     * @param plane plane in the parent frame
+     * @return pose of the plane frame in the parent frame, maps x, y, 0 to the point on the plane
+     **/
+    static Transform plane_frame(const Plane3D &plane);
+
+    /**
+     * intersects the rays of all pixels with a plane
+     * @param plane plane in the parent frame
+     * @param des x, y coordinates of the intersections in the plane frame, array with size() elements
+     * @param valid set to 1 if the ray hits the plane in front of the camera, array with size() elements
+     * @return number of valid intersections
+     **/
+    size_t project(const Plane3D &plane, Point2D *des, uint8_t *valid) const;
+
+    /**
+     * intersects the rays of a pixel set with a plane
+     * @param plane plane in the parent frame
+     * @param pixels pixel indices v * width + u
+     * @param n number of pixels
+     * @param des x, y coordinates of the intersections in the plane frame, array with n elements
+     * @param valid set to 1 if the ray hits the plane in front of the camera, array with n elements
+     * @return number of valid intersections
+     **/
+    size_t project(const Plane3D &plane, const uint32_t *pixels, size_t n, Point2D *des, uint8_t *valid) const;
+
+    /**
+     * intersects the rays of all pixels with a plane in chunks on an execution policy
+     * @param policy execution policy
+     * @param plane plane in the parent frame
+     * @param des x, y coordinates of the intersections in the plane frame, array with size() elements
+     * @param valid set to 1 if the ray hits the plane in front of the camera, array with size() elements
+     * @return number of valid intersections
+     **/
+    size_t project(const ExecutionPolicy &policy, const Plane3D &plane, Point2D *des, uint8_t *valid) const;
+
+    /**
+     * intersects the rays of a pixel set with a plane in chunks on an execution policy
+     * @param policy execution policy
+     * @param plane plane in the parent frame
+     * @param pixels pixel indices v * width + u
+     * @param n number of pixels
+     * @param des x, y coordinates of the intersections in the plane frame, array with n elements
+     * @param valid set to 1 if the ray hits the plane in front of the camera, array with n elements
+     * @return number of valid intersections
+     **/
+    size_t project(const ExecutionPolicy &policy, const Plane3D &plane, const uint32_t *pixels, size_t n, Point2D *des,
+                   uint8_t *valid) const;
+
+  private:
+    /**
+     * plane normal and plane frame axes, the coordinates on the plane of the ray o + t * r are
+     * x0 + t * (ex * r) and y0 + t * (ey * r) for t = k / (n * r)
+     **/
+    struct Projection {
+        Vector3 n, ex, ey;
+        tf2Scalar k, x0, y0;
+    };
+
+    /**
+     * @param plane plane in the parent frame
+     * @return projection for the current camera pose
+     **/
+    Projection projection(const Plane3D &plane) const;
+
+    /**
+     * intersects the rays [begin, end), not instrumented
+     * @return number of valid intersections
+     **/
+    size_t project_range(const Projection &p, size_t begin, size_t end, Point2D *des, uint8_t *valid) const;
+
+    /**
+     * intersects the rays of a pixel set, not instrumented
+     * @return number of valid intersections
+     **/
+    size_t project_pixels(const Projection &p, const uint32_t *pixels, size_t n, Point2D *des, uint8_t *valid) const;
+
+    Intrinsics m_intrinsics;
+    Transform m_pose;                            /// camera pose in the parent frame
+    std::vector<tf2Scalar> m_cx, m_cy;           /// ray x, y in the camera frame, z is one
+    std::vector<tf2Scalar> m_rx, m_ry, m_rz;     /// rays in the parent frame
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__PIXEL_RAY_TABLE_HPP
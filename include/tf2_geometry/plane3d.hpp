@@ -1,12 +1,16 @@
 #ifndef TF2_GEOMETRY__PLANE3D_HPP
 #define TF2_GEOMETRY__PLANE3D_HPP
 
+#include <cstdint>
+#include <vector>
 #include "tf2/LinearMath/Scalar.hpp"
 #include "tf2_geometry/point3d.hpp"
 #include "tf2_geometry/vector4.hpp"
 
 namespace tf2 {
 
+class ExecutionPolicy; /// Prototype
+
 /**
  * class to represent a 3D plane as equation a*x + b*y + c*z + d  = 0
  **/
@@ -64,6 +68,87 @@ class Plane3D : public Vector4 {
      **/
     tf2Scalar distance_to(const Point3D &p) const;
 
+    /** Computes the signed distances of a point array to the plane
+     * the points are processed in 4-wide (AVX) or 2-wide (SSE2, NEON) lanes if available
+     * @param src points
+     * @param n number of points
+     * @param des distances, array with n elements
+     **/
+    void distances_to(const Point3D *src, size_t n, tf2Scalar *des) const;
+
+    /** Computes the signed distances of a point array to the plane in chunks on an execution policy
+     * @param policy execution policy
+     * @param src points
+     * @param n number of points
+     * @param des distances, array with n elements
+     **/
+    void distances_to(const ExecutionPolicy &policy, const Point3D *src, size_t n, tf2Scalar *des) const;
+
+    /** Classifies points as inliers with |distance| <= threshold
+     * @param src points
+     * @param n number of points
+     * @param threshold maximal distance of an inlier
+     * @param mask array with n elements, set to 1 for inliers and 0 for outliers
+     * @return number of inliers
+     **/
+    size_t classify(const Point3D *src, size_t n, tf2Scalar threshold, uint8_t *mask) const;
+
+    /** Classifies points as inliers with |distance| <= threshold in chunks on an execution policy
+     * @param policy execution policy
+     * @param src points
+     * @param n number of points
+     * @param threshold maximal distance of an inlier
+     * @param mask array with n elements, set to 1 for inliers and 0 for outliers
+     * @return number of inliers
+     **/
+    size_t classify(const ExecutionPolicy &policy, const Point3D *src, size_t n, tf2Scalar threshold, uint8_t *mask) const;
+
+    /** Splits points into inliers with |distance| <= threshold and outliers
+     * @param src points
+     * @param n number of points
+     * @param threshold maximal distance of an inlier
+     * @param inliers indices of inliers, caller owned array with n elements
+     * @param outliers optional indices of outliers, caller owned array with n elements
+     * @return number of inliers, the number of outliers is n minus the number of inliers
+     **/
+    size_t inliers(const Point3D *src, size_t n, tf2Scalar threshold, uint32_t *inliers, uint32_t *outliers = nullptr) const;
+
+    /** Splits points into inliers with |distance| <= threshold and outliers
+     * the vectors can use any allocator e.g. std::pmr::vector on an arena
+     * @param src points
+     * @param n number of points
+     * @param threshold maximal distance of an inlier
+     * @param inliers indices of inliers, the vector is resized but its capacity reused
+     * @param outliers optional indices of outliers, the vector is resized but its capacity reused
+     * @return number of inliers
+     **/
+    template<typename Allocator>
+    size_t inliers(const Point3D *src, size_t n, tf2Scalar threshold, std::vector<uint32_t, Allocator> &inliers,
+                   std::vector<uint32_t, Allocator> *outliers = nullptr) const {
+        inliers.resize(n);
+        if (outliers) {
+            outliers->resize(n);
+        }
+        const size_t count = this->inliers(src, n, threshold, inliers.data(), outliers ? outliers->data() : nullptr);
+        inliers.resize(count);
+        if (outliers) {
+            outliers->resize(n - count);
+        }
+        return count;
+    }
+
+    /** Classifies points against several planes at once
+     * bit j of mask[i] is set if point i is an inlier of plane j with |distance| <= threshold
+     * @param planes plane array with at most 8 planes
+     * @param m number of planes
+     * @param src points
+     * @param n number of points
+     * @param threshold maximal distance of an inlier
+     * @param mask array with n elements
+     * @return false if m > 8, the mask is not written then
+     **/
+    static bool classify(const Plane3D *planes, size_t m, const Point3D *src, size_t n, tf2Scalar threshold, uint8_t *mask);
+
     /** Finds a line plane intersection
      * @param p1 line start
      * @param p2 line end
@@ -120,5 +205,9 @@ class Plane3D : public Vector4 {
     tf2Scalar &d();
 
 };
+
+TF2SIMD_FORCE_INLINE tf2Scalar Plane3D::distance_to(const Point3D &p) const {
+    return simd::plane4(m_floats, p.m_floats);
+}
 } // namespace tf2
 #endif // TF2_GEOMETRY__PLANE3D_HPP
@@ -0,0 +1,120 @@
+#ifndef TF2_GEOMETRY__PLANE3D_ARRAY_HPP
+#define TF2_GEOMETRY__PLANE3D_ARRAY_HPP
+
+#include <cstdint>
+#include <vector>
+#include "tf2_geometry/plane3d.hpp"
+
+namespace tf2 {
+
+/**
+ * class to store a set of planes in lanes of four, e.g. the faces of a frustum or a box.
+ * Each lane holds the a, b, c and d components of four planes in separate aligned registers,
+ * so one point is tested against four planes with a single SIMD instruction per component.
+ * Unused lanes are padded with the plane 0*x + 0*y + 0*z + 1 = 0 which never rejects a point.
+ * A point is inside if its signed distance to every plane is >= -tolerance, i.e. the normals point inwards.
+ **/
+class Plane3DArray {
+  public:
+    /**
+     * four planes as structure of arrays
+     **/
+    struct alignas(simd::kAlignment) Lane {
+        tf2Scalar a[4], b[4], c[4], d[4];
+    };
+
+    /**
+     * constructor
+     **/
+    Plane3DArray();
+
+    /**
+     * constructor
+     * @param planes plane array
+     * @param n number of planes
+     **/
+    Plane3DArray(const Plane3D *planes, size_t n);
+
+    /**
+     * replaces the planes
+     * @param planes plane array
+     * @param n number of planes
+     **/
+    void assign(const Plane3D *planes, size_t n);
+
+    /**
+     * adds a plane
+     * @param plane
+     **/
+    void push_back(const Plane3D &plane);
+
+    /**
+     * removes all planes
+     **/
+    void clear();
+
+    /**
+     * @return number of planes
+     **/
+    size_t size() const;
+
+    /**
+     * @param i index
+     * @return plane at index i
+     **/
+    Plane3D plane(size_t i) const;
+
+    /**
+     * @return lanes with four planes each
+     **/
+    const std::vector<Lane> &lanes() const;
+
+    /**
+     * signed distances of a point to all planes
+     * @param p point
+     * @param des distances, array with size() elements
+     **/
+    void distances_to(const Point3D &p, tf2Scalar *des) const;
+
+    /**
+     * checks if a point is on the positive side of all planes
+     * @param p point
+     * @param tolerance distance a point may be behind a plane
+     * @return true if inside
+     **/
+    bool contains(const Point3D &p, tf2Scalar tolerance = 0.0) const;
+
+    /**
+     * checks if points are on the positive side of all planes
+     * @param points point array
+     * @param n number of points
+     * @param mask set to 1 if the point is inside, array with n elements
+     * @param tolerance distance a point may be behind a plane
+     * @return number of points inside
+     **/
+    size_t contains(const Point3D *points, size_t n, uint8_t *mask, tf2Scalar tolerance = 0.0) const;
+
+    /**
+     * checks if points are on the positive side of all planes in chunks on an execution policy
+     * @param policy execution policy
+     * @param points point array
+     * @param n number of points
+     * @param mask set to 1 if the point is inside, array with n elements
+     * @param tolerance distance a point may be behind a plane
+     * @return number of points inside
+     **/
+    size_t contains(const ExecutionPolicy &policy, const Point3D *points, size_t n, uint8_t *mask, tf2Scalar tolerance = 0.0) const;
+
+  private:
+    std::vector<Lane> m_lanes;  /// planes in lanes of four
+    size_t m_size;              /// number of planes
+
+    /**
+     * marks the points inside all planes, not instrumented
+     * @return number of points inside
+     **/
+    size_t contains_range(const Point3D *points, size_t n, uint8_t *mask, tf2Scalar tolerance) const;
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__PLANE3D_ARRAY_HPP
@@ -0,0 +1,107 @@
+#ifndef TF2_GEOMETRY__PLANE3D_T_HPP
+#define TF2_GEOMETRY__PLANE3D_T_HPP
+
+#include "tf2_geometry/pack.hpp"
+#include "tf2_geometry/plane3d.hpp"
+
+namespace tf2 {
+
+/**
+ * class to represent a 3D plane as equation a*x + b*y + c*z + d = 0 for a scalar type T.
+ * T can be float, double or a simd::Pack, the latter evaluates N independent planes at once.
+ **/
+template<typename T>
+class Plane3DT {
+  protected:
+    T m_a, m_b, m_c, m_d;  /// plane equation
+
+  public:
+    using Scalar = T;
+
+    /**
+     * constructor
+     **/
+    Plane3DT() : m_a(0.), m_b(0.), m_c(0.), m_d(0.) {}
+
+    /**
+     * constructor
+     * @param a
+     * @param b
+     * @param c
+     * @param d
+     **/
+    Plane3DT(const T &a, const T &b, const T &c, const T &d) : m_a(a), m_b(b), m_c(c), m_d(d) {}
+
+    /**
+     * constructor from a Plane3D, a pack gets the same plane in all lanes
+     * @param src plane
+     **/
+    explicit Plane3DT(const Plane3D &src) : m_a(src.a()), m_b(src.b()), m_c(src.c()), m_d(src.d()) {}
+
+    /** computes the plane equation, based a point on the plane and the plane normal
+     * @param x point on the plane
+     * @param y point on the plane
+     * @param z point on the plane
+     * @param nx plane normal
+     * @param ny plane normal
+     * @param nz plane normal
+     * @return ref to object
+     **/
+    Plane3DT &create(const T &x, const T &y, const T &z, const T &nx, const T &ny, const T &nz) {
+        const T r = T(1.) / simd::sqrt(nx * nx + ny * ny + nz * nz);
+        m_a = nx * r, m_b = ny * r, m_c = nz * r;
+        m_d = -(m_a * x + m_b * y + m_c * z);
+        return *this;
+    }
+
+    const T &a() const {
+        return m_a;
+    }
+    const T &b() const {
+        return m_b;
+    }
+    const T &c() const {
+        return m_c;
+    }
+    const T &d() const {
+        return m_d;
+    }
+
+    /** normalizes the plane equation
+     * @return ref to object
+     **/
+    Plane3DT &normalize() {
+        const T r = T(1.) / simd::sqrt(m_a * m_a + m_b * m_b + m_c * m_c);
+        m_a = m_a * r, m_b = m_b * r, m_c = m_c * r, m_d = m_d * r;
+        return *this;
+    }
+
+    /** signed distance to a point, requires a normalized equation
+     * @param x
+     * @param y
+     * @param z
+     * @return distance
+     **/
+    T distance_to(const T &x, const T &y, const T &z) const {
+        return m_a * x + m_b * y + m_c * z + m_d;
+    }
+
+    /** closest point on the plane, requires a normalized equation
+     * @param x
+     * @param y
+     * @param z
+     * @param des_x closest point x
+     * @param des_y closest point y
+     * @param des_z closest point z
+     **/
+    void point_on_plane(const T &x, const T &y, const T &z, T &des_x, T &des_y, T &des_z) const {
+        const T d = distance_to(x, y, z);
+        des_x = x - d * m_a, des_y = y - d * m_b, des_z = z - d * m_c;
+    }
+};
+
+using Plane3Df = Plane3DT<float>;
+using Plane3Dd = Plane3DT<double>;
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__PLANE3D_T_HPP
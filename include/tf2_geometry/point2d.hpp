@@ -61,6 +61,16 @@ class Point2D : public Vector2 {
      * @return disance
      **/
     tf2Scalar distance_to(const tf2Scalar &x0, const tf2Scalar &y0) const;
+    /**
+     * returns the squared distance to an other point, avoids the sqrt of distance_to
+     * @return squared distance
+     **/
+    tf2Scalar distance_to_sqrt(const Point2D &p0) const;
+    /**
+     * returns the squared distance to an other point, avoids the sqrt of distance_to
+     * @return squared distance
+     **/
+    tf2Scalar distance_to_sqrt(const tf2Scalar &x0, const tf2Scalar &y0) const;
 
     /**
      * assignment operator from Vector3
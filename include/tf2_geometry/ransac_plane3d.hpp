@@ -0,0 +1,139 @@
+#ifndef TF2_GEOMETRY__RANSAC_PLANE3D_HPP
+#define TF2_GEOMETRY__RANSAC_PLANE3D_HPP
+
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/plane3d.hpp"
+
+namespace tf2 {
+
+/**
+ * class to estimate a dominant plane in a point cloud with RANSAC or MSAC.
+ * Hypotheses are created from three points with Plane3D::create and scored with the batch distance kernel.
+ * They are evaluated in parallel batches, a hypothesis is dropped as soon as its partial cost exceeds the best
+ * cost of the previous batches and the number of iterations is adapted to the inlier ratio found.
+ * Sampling depends only on the seed and the hypothesis index, so the result is deterministic for a given seed
+ * and independent of the number of threads and the execution policy.
+ * The winning plane is refined by a least squares fit to its inliers using Moments3D.
+ **/
+class RansacPlane3D {
+  public:
+    /**
+     * estimator parameters
+     **/
+    struct Config {
+        tf2Scalar threshold = 0.02;     /// maximal distance of an inlier
+        size_t max_iterations = 1000;   /// upper limit of hypotheses
+        tf2Scalar confidence = 0.99;    /// probability to draw at least one outlier free sample, used to adapt the iterations
+        bool msac = true;               /// scores with the truncated quadratic MSAC cost on true, counts outliers on false
+        bool refine = true;             /// refines the best plane with a least squares fit to its inliers
+        size_t batch_size = 32;         /// hypotheses evaluated in parallel before the termination criteria is checked
+        size_t num_threads = 1;         /// number of tasks used to evaluate a batch, they run on the execution policy
+        uint64_t seed = 0;              /// seed for the sampling
+    };
+
+    /**
+     * constructor with default parameters
+     **/
+    RansacPlane3D();
+
+    /**
+     * constructor
+     * @param config estimator parameters
+     **/
+    RansacPlane3D(const Config &config);
+
+    /**
+     * constructor, the internal buffers are allocated from a memory resource
+     * @param config estimator parameters
+     * @param resource memory resource which outlives the estimator, e.g. a pool filled at startup
+     **/
+    RansacPlane3D(const Config &config, std::pmr::memory_resource *resource);
+
+    /**
+     * changes the parameters
+     * @param config estimator parameters
+     **/
+    void configure(const Config &config);
+
+    /**
+     * @return current parameters
+     **/
+    const Config &config() const;
+
+    /**
+     * sets the policy used to evaluate a batch, ThreadPool::shared() is used if no policy is set
+     * @param policy execution policy
+     **/
+    void set_execution_policy(const ExecutionPolicy &policy);
+
+    /**
+     * estimates a plane
+     * @param points point array
+     * @param n number of points
+     * @param des estimated plane with a normalized normal
+     * @return true if a plane was found
+     **/
+    bool estimate(const Point3D *points, size_t n, Plane3D &des);
+
+    /**
+     * estimates a plane
+     * @param points points
+     * @param des estimated plane with a normalized normal
+     * @return true if a plane was found
+     **/
+    bool estimate(const std::vector<Point3D> &points, Plane3D &des);
+
+    /**
+     * inliers of the last estimate
+     * @return indices of the inliers
+     **/
+    const std::pmr::vector<uint32_t> &inliers() const;
+
+    /**
+     * @return number of hypotheses evaluated by the last estimate
+     **/
+    size_t iterations() const;
+
+    /**
+     * @return cost of the best hypothesis of the last estimate
+     **/
+    tf2Scalar cost() const;
+
+    /**
+     * fits a plane to points with least squares
+     * @param points point array
+     * @param indices indices of the points to use
+     * @param n number of indices
+     * @param des fitted plane with a normalized normal
+     * @return false if the points do not define a plane
+     **/
+    static bool fit(const Point3D *points, const uint32_t *indices, size_t n, Plane3D &des);
+
+  private:
+    Config m_config;
+    std::pmr::vector<tf2Scalar> m_batch_cost;     /// cost of the hypotheses in the current batch
+    std::pmr::vector<size_t> m_batch_inliers;     /// inliers of the hypotheses in the current batch
+    std::pmr::vector<Plane3D> m_batch_planes;     /// hypotheses of the current batch
+    std::pmr::vector<uint32_t> m_inliers;         /// inliers of the last estimate
+    std::pmr::vector<uint32_t> m_refined_inliers; /// inliers of the refined plane
+    size_t m_iterations;                    /// hypotheses evaluated by the last estimate
+    tf2Scalar m_cost;                       /// cost of the last estimate
+    std::optional<ExecutionPolicy> m_execution;   /// policy for the batch tasks
+
+    /**
+     * draws a sample and scores the resulting hypothesis
+     * @param points point array
+     * @param n number of points
+     * @param k hypothesis index
+     * @param bailout cost at which the evaluation stops
+     * @param slot index in the batch buffers
+     **/
+    void evaluate(const Point3D *points, size_t n, uint64_t k, tf2Scalar bailout, size_t slot);
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__RANSAC_PLANE3D_HPP
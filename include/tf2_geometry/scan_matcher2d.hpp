@@ -0,0 +1,113 @@
+#ifndef TF2_GEOMETRY__SCAN_MATCHER2D_HPP
+#define TF2_GEOMETRY__SCAN_MATCHER2D_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "tf2_geometry/segment_index2d.hpp"
+#include "tf2_geometry/transform2d.hpp"
+
+namespace tf2 {
+
+/**
+ * class to align a 2D scan to a segment map or to a previous scan with point-to-line ICP (PL-ICP).
+ * Every scan point is paired with the closest segment found by a SegmentIndex2D and its residual is the
+ * signed distance to the line through that segment. Each iteration linearizes the residuals around the
+ * current Transform2D and solves the 3 x 3 Gauss-Newton normal equations in closed form.
+ * Large residuals are down weighted with a Huber kernel. The iterations stop on convergence, after
+ * max_iterations or when the time budget is used up, the result reports whether the increments converged
+ * and the covariance of the pose estimate.
+ * A previous scan is used as reference by connecting neighbouring points to segments.
+ **/
+class ScanMatcher2D {
+  public:
+    /**
+     * matcher parameters
+     **/
+    struct Config {
+        size_t max_iterations = 30;                  /// upper limit of Gauss-Newton iterations
+        tf2Scalar max_correspondence_distance = 0.5; /// points further away from every segment are ignored
+        tf2Scalar huber = 0.05;                      /// residuals above are down weighted, zero disables the kernel
+        tf2Scalar epsilon_translation = 1e-4;        /// convergence threshold of the translation increment
+        tf2Scalar epsilon_rotation = 1e-4;           /// convergence threshold of the rotation increment in rad
+        tf2Scalar time_budget = 0.001;               /// time in seconds after which the iterations stop, zero, negative, non-finite or above 1e6 for no limit
+        size_t min_correspondences = 10;             /// fewer correspondences let the match fail
+        tf2Scalar max_gap = 0.3;                     /// neighbouring reference scan points further apart are not connected
+        tf2Scalar cell_size = 0.5;                   /// grid cell size of the reference scan index
+    };
+
+    /**
+     * match result
+     **/
+    struct Result {
+        Transform2D pose;                     /// pose of the scan in the map or reference scan frame
+        std::array<tf2Scalar, 9> covariance;  /// covariance of x, y, theta stored row wise
+        size_t iterations = 0;                /// iterations run
+        size_t correspondences = 0;           /// correspondences of the last iteration
+        tf2Scalar error = 0.0;                /// root mean square residual of the last iteration
+        bool converged = false;               /// true if the increments fell below the thresholds
+    };
+
+    /**
+     * constructor with default parameters
+     **/
+    ScanMatcher2D();
+
+    /**
+     * constructor
+     * @param config matcher parameters
+     **/
+    ScanMatcher2D(const Config &config);
+
+    /**
+     * changes the parameters
+     * @param config matcher parameters
+     **/
+    void configure(const Config &config);
+
+    /**
+     * @return current parameters
+     **/
+    const Config &config() const;
+
+    /**
+     * sets a scan as reference, neighbouring points closer than max_gap are connected to segments
+     * @param points scan points ordered as scanned
+     * @param n number of points
+     **/
+    void set_reference(const Point2D *points, size_t n);
+
+    /**
+     * @return segments of the reference scan
+     **/
+    const SegmentIndex2D &reference() const;
+
+    /**
+     * aligns a scan to the reference scan
+     * @param scan scan points
+     * @param n number of points
+     * @param guess initial pose of the scan in the reference scan frame
+     * @param des result
+     * @return true if the match converged with enough correspondences
+     **/
+    bool match(const Point2D *scan, size_t n, const Transform2D &guess, Result &des);
+
+    /**
+     * aligns a scan to a segment map
+     * @param map segment map
+     * @param scan scan points
+     * @param n number of points
+     * @param guess initial pose of the scan in the map frame
+     * @param des result
+     * @return true if the match converged with enough correspondences
+     **/
+    bool match(const SegmentIndex2D &map, const Point2D *scan, size_t n, const Transform2D &guess, Result &des);
+
+  private:
+    Config m_config;
+    SegmentIndex2D m_reference;                     /// segments of the reference scan
+    std::vector<SegmentIndex2D::Segment> m_segments; /// buffer to connect the reference scan points
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__SCAN_MATCHER2D_HPP
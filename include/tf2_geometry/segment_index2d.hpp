@@ -0,0 +1,199 @@
+#ifndef TF2_GEOMETRY__SEGMENT_INDEX2D_HPP
+#define TF2_GEOMETRY__SEGMENT_INDEX2D_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "tf2_geometry/linesegment2d.hpp"
+
+namespace tf2 {
+
+class ExecutionPolicy; /// Prototype
+
+/**
+ * class to find line segments near a point, e.g. the walls of a map.
+ * The segments are registered in a uniform grid stored in compressed sparse row form:
+ * cells()[i] to cells()[i + 1] is the range in items() with the segments passing cell i.
+ * All data is plain arrays, so the index can either own them after build() or
+ * refer to external memory such as a memory mapped SegmentMapFile without copying.
+ **/
+class SegmentIndex2D {
+  public:
+    /**
+     * line segment record with a fixed layout of four scalars
+     **/
+    struct Segment {
+        tf2Scalar x0, y0, x1, y1;
+    };
+
+    /**
+     * grid geometry
+     **/
+    struct Grid {
+        tf2Scalar origin_x = 0.;   /// x of the lower left corner of cell 0
+        tf2Scalar origin_y = 0.;   /// y of the lower left corner of cell 0
+        tf2Scalar cell_size = 1.;  /// edge length of a cell
+        uint32_t cols = 0;         /// number of cells along x
+        uint32_t rows = 0;         /// number of cells along y
+    };
+
+    /// returned by nearest if no segment is found
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /**
+     * constructor, empty index
+     **/
+    SegmentIndex2D();
+
+    SegmentIndex2D(const SegmentIndex2D &) = delete;
+    SegmentIndex2D &operator=(const SegmentIndex2D &) = delete;
+    SegmentIndex2D(SegmentIndex2D &&) = default;
+    SegmentIndex2D &operator=(SegmentIndex2D &&) = default;
+
+    /**
+     * builds the index into internal storage
+     * @param segments segment array
+     * @param n number of segments
+     * @param cell_size edge length of a grid cell, about the typical query radius
+     * @return false if cell_size is not positive, a segment is not finite or the grid has more than 2^24 cells,
+     * the index is empty then
+     **/
+    bool build(const LineSegment2D *segments, size_t n, tf2Scalar cell_size);
+
+    /**
+     * builds the index into internal storage
+     * @param segments segment records
+     * @param n number of segments
+     * @param cell_size edge length of a grid cell, about the typical query radius
+     * @return false if cell_size is not positive, a segment is not finite or the grid has more than 2^24 cells,
+     * the index is empty then
+     **/
+    bool build(const Segment *segments, size_t n, tf2Scalar cell_size);
+
+    /**
+     * uses external arrays, they must outlive the index
+     * @param grid grid geometry
+     * @param segments segment records
+     * @param n number of segments
+     * @param cells cell offsets, array with grid.cols * grid.rows + 1 elements
+     * @param items segment indices of all cells
+     **/
+    void view(const Grid &grid, const Segment *segments, size_t n, const uint32_t *cells, const uint32_t *items);
+
+    /**
+     * @return number of segments
+     **/
+    size_t size() const;
+
+    /**
+     * @return grid geometry
+     **/
+    const Grid &grid() const;
+
+    /**
+     * @return segment records, array with size() elements
+     **/
+    const Segment *segments() const;
+
+    /**
+     * @return cell offsets, array with grid().cols * grid().rows + 1 elements
+     **/
+    const uint32_t *cells() const;
+
+    /**
+     * @return segment indices of all cells, array with cells()[grid().cols * grid().rows] elements
+     **/
+    const uint32_t *items() const;
+
+    /**
+     * @param i segment index
+     * @return segment i
+     **/
+    LineSegment2D segment(size_t i) const;
+
+    /**
+     * finds the segments which may be within a radius of a point, each segment is reported once
+     * @param p point
+     * @param radius search radius
+     * @param des indices of the candidate segments in ascending order, the vector is cleared but its capacity reused
+     * @return number of candidates
+     **/
+    template<typename Allocator>
+    size_t query(const Point2D &p, tf2Scalar radius, std::vector<uint32_t, Allocator> &des) const {
+        des.clear();
+        uint32_t c0, r0, c1, r1;
+        if (cell_range(p.x() - radius, p.y() - radius, p.x() + radius, p.y() + radius, c0, r0, c1, r1)) {
+            for (uint32_t r = r0; r <= r1; r++) {
+                for (uint32_t c = c0; c <= c1; c++) {
+                    const size_t cell = static_cast<size_t>(r) * m_grid.cols + c;
+                    des.insert(des.end(), m_items + m_cells[cell], m_items + m_cells[cell + 1]);
+                }
+            }
+        }
+        std::sort(des.begin(), des.end());
+        des.erase(std::unique(des.begin(), des.end()), des.end());
+        return des.size();
+    }
+
+    /**
+     * finds the closest segment
+     * @param p point
+     * @param max_distance search radius, may be infinity
+     * @param distance optional distance to the closest segment
+     * @return index of the closest segment or npos if there is none within max_distance or p is not finite
+     **/
+    size_t nearest(const Point2D &p, tf2Scalar max_distance, tf2Scalar *distance = nullptr) const;
+
+    /**
+     * finds the closest segment of every point, e.g. to score a scan against a map
+     * @param points point array
+     * @param n number of points
+     * @param max_distance search radius
+     * @param indices index of the closest segment or npos, array with n elements
+     * @param distances optional distances to the closest segment or infinity, array with n elements
+     * @return number of points with a segment within max_distance
+     **/
+    size_t nearest(const Point2D *points, size_t n, tf2Scalar max_distance, size_t *indices, tf2Scalar *distances = nullptr) const;
+
+    /**
+     * finds the closest segment of every point in chunks on an execution policy
+     * @param policy execution policy
+     * @param points point array
+     * @param n number of points
+     * @param max_distance search radius
+     * @param indices index of the closest segment or npos, array with n elements
+     * @param distances optional distances to the closest segment or infinity, array with n elements
+     * @return number of points with a segment within max_distance
+     **/
+    size_t nearest(const ExecutionPolicy &policy, const Point2D *points, size_t n, tf2Scalar max_distance, size_t *indices,
+                   tf2Scalar *distances = nullptr) const;
+
+    /**
+     * squared distance of a point to a segment record
+     * @param s segment
+     * @param x
+     * @param y
+     * @return squared distance
+     **/
+    static tf2Scalar distance_sqrt(const Segment &s, tf2Scalar x, tf2Scalar y);
+
+  private:
+    Grid m_grid;
+    const Segment *m_segments;               /// segment records
+    size_t m_size;                           /// number of segments
+    const uint32_t *m_cells;                 /// cell offsets
+    const uint32_t *m_items;                 /// segment indices of all cells
+    std::vector<Segment> m_segment_storage;  /// storage used by build()
+    std::vector<uint32_t> m_cell_storage;    /// storage used by build()
+    std::vector<uint32_t> m_item_storage;    /// storage used by build()
+
+    /**
+     * clamps a box to the grid
+     * @return false if the box is outside of the grid
+     **/
+    bool cell_range(tf2Scalar x0, tf2Scalar y0, tf2Scalar x1, tf2Scalar y1, uint32_t &c0, uint32_t &r0, uint32_t &c1, uint32_t &r1) const;
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__SEGMENT_INDEX2D_HPP
@@ -0,0 +1,132 @@
+#ifndef TF2_GEOMETRY__SEGMENT_MAP_FILE_HPP
+#define TF2_GEOMETRY__SEGMENT_MAP_FILE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "tf2_geometry/segment_index2d.hpp"
+
+namespace tf2 {
+
+/**
+ * class to store a segment map with its prebuilt SegmentIndex2D in a binary file.
+ * The file is a header followed by the segment records, the cell offsets and the cell items,
+ * every block starts at a multiple of 64 bytes. open() memory maps the file and the index refers
+ * directly to the mapped pages, so there is no parsing, no copy and all processes share one physical copy.
+ * The header stores a magic, a version and an endianness marker, a file written on a machine with
+ * another byte order is rejected by open() and converted by read().
+ *
+ * | offset           | content                                                   |
+ * |------------------|-----------------------------------------------------------|
+ * | 0                | Header                                                    |
+ * | segments_offset  | SegmentIndex2D::Segment[segment_count], four doubles each |
+ * | cells_offset     | uint32_t[cols * rows + 1]                                 |
+ * | items_offset     | uint32_t[item_count]                                      |
+ **/
+class SegmentMapFile {
+  public:
+    /**
+     * file header
+     **/
+    struct Header {
+        char magic[8];             /// "TF2SEGM" with a terminating zero
+        uint32_t version;          /// format version
+        uint32_t endian;           /// kEndianMarker in the byte order of the writer
+        uint64_t file_size;        /// size of the file in bytes
+        uint64_t segment_count;    /// number of segments
+        uint64_t item_count;       /// number of cell items
+        uint64_t segments_offset;  /// offset of the segment records
+        uint64_t cells_offset;     /// offset of the cell offsets
+        uint64_t items_offset;     /// offset of the cell items
+        double origin_x;           /// grid origin x
+        double origin_y;           /// grid origin y
+        double cell_size;          /// grid cell size
+        uint32_t cols;             /// grid columns
+        uint32_t rows;             /// grid rows
+    };
+
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kEndianMarker = 0x01020304;
+
+    /**
+     * constructor
+     **/
+    SegmentMapFile();
+
+    /**
+     * destructor, unmaps the file
+     **/
+    ~SegmentMapFile();
+
+    SegmentMapFile(const SegmentMapFile &) = delete;
+    SegmentMapFile &operator=(const SegmentMapFile &) = delete;
+
+    /**
+     * writes an index into a file
+     * @param path file name
+     * @param index segment index
+     * @param swap_byte_order writes the file for a machine with the other byte order on true
+     * @return false on error, see error()
+     **/
+    bool write(const std::string &path, const SegmentIndex2D &index, bool swap_byte_order = false);
+
+    /**
+     * memory maps a file read only, files with the other byte order are rejected.
+     * The header and the block bounds are always checked, the verification of the cell offsets and items
+     * reads the whole index and can be skipped for trusted files to keep the mapping lazy.
+     * @param path file name
+     * @param verify checks that the cell offsets ascend and all items refer to a segment
+     * @return false on error, see error()
+     **/
+    bool open(const std::string &path, bool verify = true);
+
+    /**
+     * reads a file into memory, converts the byte order if needed and verifies the index
+     * @param path file name
+     * @return false on error, see error()
+     **/
+    bool read(const std::string &path);
+
+    /**
+     * unmaps or releases the file, the index becomes empty
+     **/
+    void close();
+
+    /**
+     * @return true if the index refers to memory mapped pages
+     **/
+    bool mapped() const;
+
+    /**
+     * @return header of the loaded file
+     **/
+    const Header &header() const;
+
+    /**
+     * @return index of the loaded file
+     **/
+    const SegmentIndex2D &index() const;
+
+    /**
+     * @return description of the last error
+     **/
+    const std::string &error() const;
+
+  private:
+    Header m_header;
+    SegmentIndex2D m_index;
+    void *m_mapping;               /// memory mapped file
+    size_t m_mapping_size;         /// size of the mapping
+    std::vector<uint64_t> m_data;  /// file content loaded by read(), 8 byte aligned
+    std::string m_error;
+
+    /**
+     * checks the header and points the index into the file data
+     * @param verify checks the cell offsets and items
+     * @return false on error
+     **/
+    bool attach(const uint8_t *data, size_t size, bool verify);
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__SEGMENT_MAP_FILE_HPP
@@ -0,0 +1,145 @@
+#ifndef TF2_GEOMETRY__SEGMENT_RASTERIZER2D_HPP
+#define TF2_GEOMETRY__SEGMENT_RASTERIZER2D_HPP
+
+#include <cstdint>
+#include <vector>
+#include "tf2_geometry/linesegment2d.hpp"
+#include "tf2_geometry/transform2d.hpp"
+
+namespace tf2 {
+
+class ExecutionPolicy; /// Prototype
+
+/**
+ * class to burn line segments, e.g. the walls of a vector map, into an occupancy grid.
+ * The grid uses the nav_msgs::msg::OccupancyGrid layout: row major int8 cells, cell (x, y) is
+ * data[y * width + x] and the origin is the pose of the corner of cell (0, 0) in the map frame.
+ * The center line of a segment is drawn as an 8-connected line between the cells of its end points with an
+ * integer Bresenham DDA, segments with a thickness additionally fill all cells with a center within
+ * thickness / 2 of the segment.
+ * The grid is split into square tiles and the segments are binned into the tiles they pass,
+ * every tile is rasterized independently so tiles can run in parallel without write contention.
+ * A segment crossing several tiles produces the same cells as if it was drawn in one piece.
+ **/
+class SegmentRasterizer2D {
+  public:
+    /**
+     * grid geometry and drawing parameters
+     **/
+    struct Config {
+        tf2Scalar resolution = 0.05;  /// cell size, values <= 0 or non-finite use the default
+        uint32_t width = 0;           /// number of columns
+        uint32_t height = 0;          /// number of rows
+        Transform2D origin;           /// pose of the corner of cell (0, 0) in the map frame
+        tf2Scalar thickness = 0.0;    /// width of the segments, zero draws the center line only, negative or non-finite values use zero, at most 2^31 cells
+        int8_t value = 100;           /// value written into filled cells
+        uint32_t tile_size = 64;      /// width and height of a tile in cells
+    };
+
+    /**
+     * constructor with default parameters
+     **/
+    SegmentRasterizer2D();
+
+    /**
+     * constructor
+     * @param config grid geometry and drawing parameters
+     **/
+    SegmentRasterizer2D(const Config &config);
+
+    /**
+     * changes the grid geometry and drawing parameters
+     * @param config grid geometry and drawing parameters
+     **/
+    void configure(const Config &config);
+
+    /**
+     * @return current parameters
+     **/
+    const Config &config() const;
+
+    /**
+     * @return number of cells, width * height
+     **/
+    size_t size() const;
+
+    /**
+     * burns segments into a grid, cells which are not passed keep their value
+     * @param segments segments in the map frame
+     * @param n number of segments
+     * @param grid cells, array with size() elements
+     **/
+    void rasterize(const LineSegment2D *segments, size_t n, int8_t *grid);
+
+    /**
+     * burns segments into a grid, the tiles are rasterized in parallel on an execution policy
+     * @param policy execution policy
+     * @param segments segments in the map frame
+     * @param n number of segments
+     * @param grid cells, array with size() elements
+     **/
+    void rasterize(const ExecutionPolicy &policy, const LineSegment2D *segments, size_t n, int8_t *grid);
+
+    /**
+     * burns segments into a window of a grid, e.g. to redraw a region after the map changed
+     * the cells are the same as the ones of a rasterization of the whole grid, cells outside of the window are not touched
+     * @param segments segments in the map frame
+     * @param n number of segments
+     * @param grid cells, array with size() elements
+     * @param x0 first column of the window
+     * @param y0 first row of the window
+     * @param x1 last column of the window
+     * @param y1 last row of the window
+     **/
+    void rasterize(const LineSegment2D *segments, size_t n, int8_t *grid, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1);
+
+    /**
+     * burns segments into a grid, e.g. the data of a nav_msgs::msg::OccupancyGrid
+     * @param segments segments in the map frame
+     * @param grid cells, resized to size() elements with new cells set to -1 (unknown)
+     **/
+    template<typename Allocator>
+    void rasterize(const std::vector<LineSegment2D> &segments, std::vector<int8_t, Allocator> &grid) {
+        grid.resize(size(), -1);
+        rasterize(segments.data(), segments.size(), grid.data());
+    }
+
+  private:
+    /**
+     * segment in cell coordinates clipped to the grid
+     **/
+    struct Record {
+        tf2Scalar x0, y0, x1, y1;  /// end points in cell coordinates, cell (x, y) covers [x, x + 1) x [y, y + 1)
+        int64_t a0, b0;            /// start cell on the major and minor axis
+        int64_t length;            /// steps along the major axis
+        int64_t minor;             /// cells along the minor axis
+        int32_t sa, sb;            /// step directions on the major and minor axis
+        bool x_major;              /// true if x is the major axis
+    };
+
+    Config m_config;
+    uint32_t m_tiles_x, m_tiles_y;     /// number of tiles
+    tf2Scalar m_radius;                /// half thickness in cells
+    std::vector<Record> m_records;     /// clipped segments
+    std::vector<uint32_t> m_tiles;     /// offsets into m_items, tiles + 1 elements
+    std::vector<uint32_t> m_items;     /// record indices of all tiles
+
+    /**
+     * transforms and clips the segments and bins them into the tiles
+     **/
+    void prepare(const LineSegment2D *segments, size_t n);
+
+    /**
+     * calls f(tile) for every tile a record passes
+     **/
+    template<typename F>
+    void for_each_tile(const Record &r, F f) const;
+
+    /**
+     * rasterizes the records of a tile within the cells [x0, x1] x [y0, y1]
+     **/
+    void rasterize_tile(size_t tile, int8_t *grid, int64_t x0, int64_t y0, int64_t x1, int64_t y1) const;
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__SEGMENT_RASTERIZER2D_HPP
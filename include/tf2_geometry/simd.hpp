@@ -0,0 +1,342 @@
+#ifndef TF2_GEOMETRY__SIMD_HPP
+#define TF2_GEOMETRY__SIMD_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include "tf2/LinearMath/Scalar.hpp"
+
+/**
+ * selection of the instruction set used for four scalar lanes,
+ * define TF2_GEOMETRY_NO_SIMD to force the scalar fallback
+ **/
+#if !defined(TF2_GEOMETRY_NO_SIMD)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define TF2_GEOMETRY_SIMD_AVX
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define TF2_GEOMETRY_SIMD_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define TF2_GEOMETRY_SIMD_NEON
+#endif
+#endif
+
+namespace tf2 {
+namespace simd {
+
+#if defined(TF2_GEOMETRY_SIMD_AVX) || defined(TF2_GEOMETRY_SIMD_SSE2) || defined(TF2_GEOMETRY_SIMD_NEON)
+static_assert(std::is_same<tf2Scalar, double>::value, "SIMD lanes expect double precision");
+#endif
+
+/// alignment needed to process four scalars in one register
+constexpr size_t kAlignment = 4 * sizeof(tf2Scalar);
+
+/**
+ * des = a + b for four scalars
+ **/
+TF2SIMD_FORCE_INLINE void add4(const tf2Scalar *a, const tf2Scalar *b, tf2Scalar *des) {
+#if defined(TF2_GEOMETRY_SIMD_AVX)
+    _mm256_storeu_pd(des, _mm256_add_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+#elif defined(TF2_GEOMETRY_SIMD_SSE2)
+    _mm_storeu_pd(des, _mm_add_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+    _mm_storeu_pd(des + 2, _mm_add_pd(_mm_loadu_pd(a + 2), _mm_loadu_pd(b + 2)));
+#elif defined(TF2_GEOMETRY_SIMD_NEON)
+    vst1q_f64(des, vaddq_f64(vld1q_f64(a), vld1q_f64(b)));
+    vst1q_f64(des + 2, vaddq_f64(vld1q_f64(a + 2), vld1q_f64(b + 2)));
+#else
+    des[0] = a[0] + b[0], des[1] = a[1] + b[1], des[2] = a[2] + b[2], des[3] = a[3] + b[3];
+#endif
+}
+
+/**
+ * des = a - b for four scalars
+ **/
+TF2SIMD_FORCE_INLINE void sub4(const tf2Scalar *a, const tf2Scalar *b, tf2Scalar *des) {
+#if defined(TF2_GEOMETRY_SIMD_AVX)
+    _mm256_storeu_pd(des, _mm256_sub_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+#elif defined(TF2_GEOMETRY_SIMD_SSE2)
+    _mm_storeu_pd(des, _mm_sub_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+    _mm_storeu_pd(des + 2, _mm_sub_pd(_mm_loadu_pd(a + 2), _mm_loadu_pd(b + 2)));
+#elif defined(TF2_GEOMETRY_SIMD_NEON)
+    vst1q_f64(des, vsubq_f64(vld1q_f64(a), vld1q_f64(b)));
+    vst1q_f64(des + 2, vsubq_f64(vld1q_f64(a + 2), vld1q_f64(b + 2)));
+#else
+    des[0] = a[0] - b[0], des[1] = a[1] - b[1], des[2] = a[2] - b[2], des[3] = a[3] - b[3];
+#endif
+}
+
+/**
+ * des = a * s for four scalars
+ **/
+TF2SIMD_FORCE_INLINE void scale4(const tf2Scalar *a, tf2Scalar s, tf2Scalar *des) {
+#if defined(TF2_GEOMETRY_SIMD_AVX)
+    _mm256_storeu_pd(des, _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_set1_pd(s)));
+#elif defined(TF2_GEOMETRY_SIMD_SSE2)
+    const __m128d vs = _mm_set1_pd(s);
+    _mm_storeu_pd(des, _mm_mul_pd(_mm_loadu_pd(a), vs));
+    _mm_storeu_pd(des + 2, _mm_mul_pd(_mm_loadu_pd(a + 2), vs));
+#elif defined(TF2_GEOMETRY_SIMD_NEON)
+    vst1q_f64(des, vmulq_n_f64(vld1q_f64(a), s));
+    vst1q_f64(des + 2, vmulq_n_f64(vld1q_f64(a + 2), s));
+#else
+    des[0] = a[0] * s, des[1] = a[1] * s, des[2] = a[2] * s, des[3] = a[3] * s;
+#endif
+}
+
+/**
+ * des = -a for four scalars
+ **/
+TF2SIMD_FORCE_INLINE void neg4(const tf2Scalar *a, tf2Scalar *des) {
+#if defined(TF2_GEOMETRY_SIMD_AVX)
+    _mm256_storeu_pd(des, _mm256_xor_pd(_mm256_loadu_pd(a), _mm256_set1_pd(-0.0)));
+#elif defined(TF2_GEOMETRY_SIMD_SSE2)
+    const __m128d sign = _mm_set1_pd(-0.0);
+    _mm_storeu_pd(des, _mm_xor_pd(_mm_loadu_pd(a), sign));
+    _mm_storeu_pd(des + 2, _mm_xor_pd(_mm_loadu_pd(a + 2), sign));
+#elif defined(TF2_GEOMETRY_SIMD_NEON)
+    vst1q_f64(des, vnegq_f64(vld1q_f64(a)));
+    vst1q_f64(des + 2, vnegq_f64(vld1q_f64(a + 2)));
+#else
+    des[0] = -a[0], des[1] = -a[1], des[2] = -a[2], des[3] = -a[3];
+#endif
+}
+
+/**
+ * des = a < b ? a : b for four scalars, b is returned if either is NaN as with _mm_min_pd on every architecture
+ **/
+TF2SIMD_FORCE_INLINE void min4(const tf2Scalar *a, const tf2Scalar *b, tf2Scalar *des) {
+#if defined(TF2_GEOMETRY_SIMD_AVX)
+    _mm256_storeu_pd(des, _mm256_min_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+#elif defined(TF2_GEOMETRY_SIMD_SSE2)
+    _mm_storeu_pd(des, _mm_min_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+    _mm_storeu_pd(des + 2, _mm_min_pd(_mm_loadu_pd(a + 2), _mm_loadu_pd(b + 2)));
+#elif defined(TF2_GEOMETRY_SIMD_NEON)
+    /// vminq_f64 would propagate NaN
+    const float64x2_t a0 = vld1q_f64(a), b0 = vld1q_f64(b), a1 = vld1q_f64(a + 2), b1 = vld1q_f64(b + 2);
+    vst1q_f64(des, vbslq_f64(vcltq_f64(a0, b0), a0, b0));
+    vst1q_f64(des + 2, vbslq_f64(vcltq_f64(a1, b1), a1, b1));
+#else
+    des[0] = a[0] < b[0] ? a[0] : b[0], des[1] = a[1] < b[1] ? a[1] : b[1];
+    des[2] = a[2] < b[2] ? a[2] : b[2], des[3] = a[3] < b[3] ? a[3] : b[3];
+#endif
+}
+
+/**
+ * des = a > b ? a : b for four scalars, b is returned if either is NaN as with _mm_max_pd on every architecture
+ **/
+TF2SIMD_FORCE_INLINE void max4(const tf2Scalar *a, const tf2Scalar *b, tf2Scalar *des) {
+#if defined(TF2_GEOMETRY_SIMD_AVX)
+    _mm256_storeu_pd(des, _mm256_max_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+#elif defined(TF2_GEOMETRY_SIMD_SSE2)
+    _mm_storeu_pd(des, _mm_max_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+    _mm_storeu_pd(des + 2, _mm_max_pd(_mm_loadu_pd(a + 2), _mm_loadu_pd(b + 2)));
+#elif defined(TF2_GEOMETRY_SIMD_NEON)
+    /// vmaxq_f64 would propagate NaN
+    const float64x2_t a0 = vld1q_f64(a), b0 = vld1q_f64(b), a1 = vld1q_f64(a + 2), b1 = vld1q_f64(b + 2);
+    vst1q_f64(des, vbslq_f64(vcgtq_f64(a0, b0), a0, b0));
+    vst1q_f64(des + 2, vbslq_f64(vcgtq_f64(a1, b1), a1, b1));
+#else
+    des[0] = a[0] > b[0] ? a[0] : b[0], des[1] = a[1] > b[1] ? a[1] : b[1];
+    des[2] = a[2] > b[2] ? a[2] : b[2], des[3] = a[3] > b[3] ? a[3] : b[3];
+#endif
+}
+
+/**
+ * dot product of four scalars
+ **/
+TF2SIMD_FORCE_INLINE tf2Scalar dot4(const tf2Scalar *a, const tf2Scalar *b) {
+#if defined(TF2_GEOMETRY_SIMD_AVX)
+    const __m256d m = _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b));
+    const __m128d s = _mm_add_pd(_mm256_castpd256_pd128(m), _mm256_extractf128_pd(m, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+#elif defined(TF2_GEOMETRY_SIMD_SSE2)
+    const __m128d s = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)), _mm_mul_pd(_mm_loadu_pd(a + 2), _mm_loadu_pd(b + 2)));
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+#elif defined(TF2_GEOMETRY_SIMD_NEON)
+    return vaddvq_f64(vfmaq_f64(vmulq_f64(vld1q_f64(a), vld1q_f64(b)), vld1q_f64(a + 2), vld1q_f64(b + 2)));
+#else
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+#endif
+}
+
+/**
+ * evaluates a plane equation a*x + b*y + c*z + d for a point, the fourth point component is ignored
+ * @param plane a, b, c, d
+ * @param p x, y, z
+ **/
+TF2SIMD_FORCE_INLINE tf2Scalar plane4(const tf2Scalar *plane, const tf2Scalar *p) {
+#if defined(TF2_GEOMETRY_SIMD_AVX)
+    const __m256d ph = _mm256_blend_pd(_mm256_loadu_pd(p), _mm256_set1_pd(1.0), 0x8);
+    const __m256d m = _mm256_mul_pd(_mm256_loadu_pd(plane), ph);
+    const __m128d s = _mm_add_pd(_mm256_castpd256_pd128(m), _mm256_extractf128_pd(m, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+#elif defined(TF2_GEOMETRY_SIMD_SSE2)
+    const __m128d zw = _mm_unpacklo_pd(_mm_load_sd(p + 2), _mm_set1_pd(1.0));
+    const __m128d s = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(plane), _mm_loadu_pd(p)), _mm_mul_pd(_mm_loadu_pd(plane + 2), zw));
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+#elif defined(TF2_GEOMETRY_SIMD_NEON)
+    const float64x2_t zw = vsetq_lane_f64(1.0, vld1q_f64(p + 2), 1);
+    return vaddvq_f64(vfmaq_f64(vmulq_f64(vld1q_f64(plane), vld1q_f64(p)), vld1q_f64(plane + 2), zw));
+#else
+    return plane[0] * p[0] + plane[1] * p[1] + plane[2] * p[2] + plane[3];
+#endif
+}
+
+namespace detail {
+/**
+ * one register of lanes for atan2_4 and asin4, SSE2 and NEON process four scalars in two registers
+ **/
+#if defined(TF2_GEOMETRY_SIMD_AVX)
+using Lanes = __m256d;
+using LaneMask = __m256d;
+constexpr size_t kLanes = 4;
+TF2SIMD_FORCE_INLINE Lanes lanes_load(const tf2Scalar *p) { return _mm256_loadu_pd(p); }
+TF2SIMD_FORCE_INLINE void lanes_store(tf2Scalar *p, Lanes a) { _mm256_storeu_pd(p, a); }
+TF2SIMD_FORCE_INLINE Lanes lanes_set(tf2Scalar s) { return _mm256_set1_pd(s); }
+TF2SIMD_FORCE_INLINE Lanes lanes_add(Lanes a, Lanes b) { return _mm256_add_pd(a, b); }
+TF2SIMD_FORCE_INLINE Lanes lanes_sub(Lanes a, Lanes b) { return _mm256_sub_pd(a, b); }
+TF2SIMD_FORCE_INLINE Lanes lanes_mul(Lanes a, Lanes b) { return _mm256_mul_pd(a, b); }
+TF2SIMD_FORCE_INLINE Lanes lanes_div(Lanes a, Lanes b) { return _mm256_div_pd(a, b); }
+TF2SIMD_FORCE_INLINE Lanes lanes_sqrt(Lanes a) { return _mm256_sqrt_pd(a); }
+TF2SIMD_FORCE_INLINE Lanes lanes_abs(Lanes a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+TF2SIMD_FORCE_INLINE Lanes lanes_copysign(Lanes a, Lanes s) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    return _mm256_or_pd(_mm256_andnot_pd(sign, a), _mm256_and_pd(sign, s));
+}
+TF2SIMD_FORCE_INLINE LaneMask lanes_gt(Lanes a, Lanes b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+TF2SIMD_FORCE_INLINE LaneMask lanes_eq(Lanes a, Lanes b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+TF2SIMD_FORCE_INLINE LaneMask lanes_and(LaneMask a, LaneMask b) { return _mm256_and_pd(a, b); }
+TF2SIMD_FORCE_INLINE LaneMask lanes_or(LaneMask a, LaneMask b) { return _mm256_or_pd(a, b); }
+TF2SIMD_FORCE_INLINE Lanes lanes_select(LaneMask m, Lanes a, Lanes b) { return _mm256_blendv_pd(b, a, m); }
+#elif defined(TF2_GEOMETRY_SIMD_SSE2)
+using Lanes = __m128d;
+using LaneMask = __m128d;
+constexpr size_t kLanes = 2;
+TF2SIMD_FORCE_INLINE Lanes lanes_load(const tf2Scalar *p) { return _mm_loadu_pd(p); }
+TF2SIMD_FORCE_INLINE void lanes_store(tf2Scalar *p, Lanes a) { _mm_storeu_pd(p, a); }
+TF2SIMD_FORCE_INLINE Lanes lanes_set(tf2Scalar s) { return _mm_set1_pd(s); }
+TF2SIMD_FORCE_INLINE Lanes lanes_add(Lanes a, Lanes b) { return _mm_add_pd(a, b); }
+TF2SIMD_FORCE_INLINE Lanes lanes_sub(Lanes a, Lanes b) { return _mm_sub_pd(a, b); }
+TF2SIMD_FORCE_INLINE Lanes lanes_mul(Lanes a, Lanes b) { return _mm_mul_pd(a, b); }
+TF2SIMD_FORCE_INLINE Lanes lanes_div(Lanes a, Lanes b) { return _mm_div_pd(a, b); }
+TF2SIMD_FORCE_INLINE Lanes lanes_sqrt(Lanes a) { return _mm_sqrt_pd(a); }
+TF2SIMD_FORCE_INLINE Lanes lanes_abs(Lanes a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+TF2SIMD_FORCE_INLINE Lanes lanes_copysign(Lanes a, Lanes s) {
+    const __m128d sign = _mm_set1_pd(-0.0);
+    return _mm_or_pd(_mm_andnot_pd(sign, a), _mm_and_pd(sign, s));
+}
+TF2SIMD_FORCE_INLINE LaneMask lanes_gt(Lanes a, Lanes b) { return _mm_cmpgt_pd(a, b); }
+TF2SIMD_FORCE_INLINE LaneMask lanes_eq(Lanes a, Lanes b) { return _mm_cmpeq_pd(a, b); }
+TF2SIMD_FORCE_INLINE LaneMask lanes_and(LaneMask a, LaneMask b) { return _mm_and_pd(a, b); }
+TF2SIMD_FORCE_INLINE LaneMask lanes_or(LaneMask a, LaneMask b) { return _mm_or_pd(a, b); }
+TF2SIMD_FORCE_INLINE Lanes lanes_select(LaneMask m, Lanes a, Lanes b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+#elif defined(TF2_GEOMETRY_SIMD_NEON)
+using Lanes = float64x2_t;
+using LaneMask = uint64x2_t;
+constexpr size_t kLanes = 2;
+TF2SIMD_FORCE_INLINE Lanes lanes_load(const tf2Scalar *p) { return vld1q_f64(p); }
+TF2SIMD_FORCE_INLINE void lanes_store(tf2Scalar *p, Lanes a) { vst1q_f64(p, a); }
+TF2SIMD_FORCE_INLINE Lanes lanes_set(tf2Scalar s) { return vdupq_n_f64(s); }
+TF2SIMD_FORCE_INLINE Lanes lanes_add(Lanes a, Lanes b) { return vaddq_f64(a, b); }
+TF2SIMD_FORCE_INLINE Lanes lanes_sub(Lanes a, Lanes b) { return vsubq_f64(a, b); }
+TF2SIMD_FORCE_INLINE Lanes lanes_mul(Lanes a, Lanes b) { return vmulq_f64(a, b); }
+TF2SIMD_FORCE_INLINE Lanes lanes_div(Lanes a, Lanes b) { return vdivq_f64(a, b); }
+TF2SIMD_FORCE_INLINE Lanes lanes_sqrt(Lanes a) { return vsqrtq_f64(a); }
+TF2SIMD_FORCE_INLINE Lanes lanes_abs(Lanes a) { return vabsq_f64(a); }
+TF2SIMD_FORCE_INLINE Lanes lanes_copysign(Lanes a, Lanes s) { return vbslq_f64(vdupq_n_u64(0x8000000000000000ull), s, a); }
+TF2SIMD_FORCE_INLINE LaneMask lanes_gt(Lanes a, Lanes b) { return vcgtq_f64(a, b); }
+TF2SIMD_FORCE_INLINE LaneMask lanes_eq(Lanes a, Lanes b) { return vceqq_f64(a, b); }
+TF2SIMD_FORCE_INLINE LaneMask lanes_and(LaneMask a, LaneMask b) { return vandq_u64(a, b); }
+TF2SIMD_FORCE_INLINE LaneMask lanes_or(LaneMask a, LaneMask b) { return vorrq_u64(a, b); }
+TF2SIMD_FORCE_INLINE Lanes lanes_select(LaneMask m, Lanes a, Lanes b) { return vbslq_f64(m, a, b); }
+#else
+using Lanes = tf2Scalar;
+using LaneMask = bool;
+constexpr size_t kLanes = 1;
+TF2SIMD_FORCE_INLINE Lanes lanes_load(const tf2Scalar *p) { return *p; }
+TF2SIMD_FORCE_INLINE void lanes_store(tf2Scalar *p, Lanes a) { *p = a; }
+TF2SIMD_FORCE_INLINE Lanes lanes_set(tf2Scalar s) { return s; }
+TF2SIMD_FORCE_INLINE Lanes lanes_add(Lanes a, Lanes b) { return a + b; }
+TF2SIMD_FORCE_INLINE Lanes lanes_sub(Lanes a, Lanes b) { return a - b; }
+TF2SIMD_FORCE_INLINE Lanes lanes_mul(Lanes a, Lanes b) { return a * b; }
+TF2SIMD_FORCE_INLINE Lanes lanes_div(Lanes a, Lanes b) { return a / b; }
+TF2SIMD_FORCE_INLINE Lanes lanes_sqrt(Lanes a) { return std::sqrt(a); }
+TF2SIMD_FORCE_INLINE Lanes lanes_abs(Lanes a) { return std::abs(a); }
+TF2SIMD_FORCE_INLINE Lanes lanes_copysign(Lanes a, Lanes s) { return std::copysign(a, s); }
+TF2SIMD_FORCE_INLINE LaneMask lanes_gt(Lanes a, Lanes b) { return a > b; }
+TF2SIMD_FORCE_INLINE LaneMask lanes_eq(Lanes a, Lanes b) { return a == b; }
+TF2SIMD_FORCE_INLINE LaneMask lanes_and(LaneMask a, LaneMask b) { return a && b; }
+TF2SIMD_FORCE_INLINE LaneMask lanes_or(LaneMask a, LaneMask b) { return a || b; }
+TF2SIMD_FORCE_INLINE Lanes lanes_select(LaneMask m, Lanes a, Lanes b) { return m ? a : b; }
+#endif
+
+/**
+ * atan2 without branches: t = min(|x|, |y|) / max(|x|, |y|) is reduced with atan(t) = PI/4 + atan((t - 1) / (t + 1))
+ * for t > 0.66, so |u| <= 0.66 and atan(u) = u + u z P(z) with z = u^2 and a degree 14 polynomial P fitted at the
+ * Chebyshev nodes of [0, 0.66^2]. The octant is restored with selects, PI is added as rounded value and remainder.
+ **/
+TF2SIMD_FORCE_INLINE Lanes atan2_lanes(Lanes y, Lanes x) {
+    static constexpr tf2Scalar kP[15] = {
+        -0.33333333333333331, 0.19999999999998458, -0.14285714285448603,
+        0.11111111092987939, -0.090909084408594243, 0.076922935840582143,
+        -0.066664656415943102, 0.058803738184603403, -0.05249245606674334,
+        0.046906189765109733, -0.040783618741573609, 0.032440431711566069,
+        -0.021243411686277976, 0.0097106548279109247, -0.0022331903226341927};
+    const tf2Scalar pi_lo = 1.2246467991473532e-16;
+    const Lanes zero = lanes_set(0.0);
+    const Lanes ax = lanes_abs(x), ay = lanes_abs(y);
+    const LaneMask swap = lanes_gt(ay, ax);
+    const Lanes num = lanes_select(swap, ax, ay), den = lanes_select(swap, ay, ax);
+    /// (0, 0) gives 0 and (inf, inf) gives PI/4 as std::atan2
+    const LaneMask equal = lanes_eq(num, den);
+    const LaneMask reduce =
+        lanes_or(lanes_gt(num, lanes_mul(lanes_set(0.66), den)), lanes_and(equal, lanes_gt(den, zero)));
+    Lanes u = lanes_select(reduce, lanes_div(lanes_sub(num, den), lanes_add(num, den)), lanes_div(num, den));
+    u = lanes_select(equal, zero, u);
+    const Lanes z = lanes_mul(u, u);
+    Lanes p = lanes_set(kP[14]);
+    for (int i = 13; i >= 0; i--) {
+        p = lanes_add(lanes_mul(p, z), lanes_set(kP[i]));
+    }
+    Lanes a = lanes_add(u, lanes_mul(lanes_mul(u, z), p));
+    a = lanes_select(reduce, lanes_add(lanes_set(0.25 * M_PI), lanes_add(a, lanes_set(0.25 * pi_lo))), a);
+    a = lanes_select(swap, lanes_sub(lanes_set(0.5 * M_PI), lanes_sub(a, lanes_set(0.5 * pi_lo))), a);
+    /// x < 0 including -0
+    const LaneMask mirror = lanes_gt(zero, lanes_copysign(lanes_set(1.0), x));
+    a = lanes_select(mirror, lanes_sub(lanes_set(M_PI), lanes_sub(a, lanes_set(pi_lo))), a);
+    return lanes_copysign(a, y);
+}
+}  // namespace detail
+
+/**
+ * atan2 of four scalar pairs with a polynomial, within 1 ULP of std::atan2 for double.
+ * Signed zeros and infinities are handled as by std::atan2, NaN propagates.
+ * @param y four y values
+ * @param x four x values
+ * @param des four angles between -PI and PI
+ **/
+TF2SIMD_FORCE_INLINE void atan2_4(const tf2Scalar *y, const tf2Scalar *x, tf2Scalar *des) {
+    for (size_t i = 0; i < 4; i += detail::kLanes) {
+        detail::lanes_store(des + i, detail::atan2_lanes(detail::lanes_load(y + i), detail::lanes_load(x + i)));
+    }
+}
+
+/**
+ * asin of four scalars as atan2(x, sqrt((1 - x) (1 + x))), within 3 ULP of std::asin for double, NaN for |x| > 1
+ * @param x four values
+ * @param des four angles between -PI/2 and PI/2, may be x
+ **/
+TF2SIMD_FORCE_INLINE void asin4(const tf2Scalar *x, tf2Scalar *des) {
+    const detail::Lanes one = detail::lanes_set(1.0);
+    for (size_t i = 0; i < 4; i += detail::kLanes) {
+        const detail::Lanes a = detail::lanes_load(x + i);
+        const detail::Lanes c = detail::lanes_sqrt(detail::lanes_mul(detail::lanes_sub(one, a), detail::lanes_add(one, a)));
+        detail::lanes_store(des + i, detail::atan2_lanes(a, c));
+    }
+}
+
+}  // namespace simd
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__SIMD_HPP
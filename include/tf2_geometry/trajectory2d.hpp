@@ -0,0 +1,166 @@
+#ifndef TF2_GEOMETRY__TRAJECTORY2D_HPP
+#define TF2_GEOMETRY__TRAJECTORY2D_HPP
+
+#include <vector>
+#include "tf2_geometry/transform2d.hpp"
+
+namespace tf2 {
+
+/**
+ * class to hold a trajectory of time stamped poses, e.g. the reference path of a controller.
+ * The samples are stored as structure of arrays together with the cumulative arc length of the positions and
+ * the shortest rotation to the next sample, so an interpolation needs neither a sqrt nor trigonometry for the
+ * rotation. Lookups by time or arc length are binary searches, a Cursor remembers the last segment and makes
+ * sequential lookups O(1) amortized.
+ * Between samples the position and the rotation are interpolated linearly, queries outside of the trajectory
+ * are clamped to the first or last sample.
+ **/
+class Trajectory2D {
+  public:
+    /**
+     * segment of the last lookup, one cursor per sequence of queries
+     **/
+    struct Cursor {
+        size_t index = 0;
+    };
+
+    /**
+     * constructor, empty trajectory
+     **/
+    Trajectory2D();
+
+    /**
+     * removes all samples
+     **/
+    void clear();
+
+    /**
+     * reserves memory
+     * @param n number of samples
+     **/
+    void reserve(size_t n);
+
+    /**
+     * appends a sample
+     * @param time time stamp in seconds, must be finite and larger than the time of the last sample
+     * @param pose pose
+     * @return false if time is not finite or not increasing, the sample is not added
+     **/
+    bool push_back(tf2Scalar time, const Transform2D &pose);
+
+    /**
+     * @return number of samples
+     **/
+    size_t size() const;
+
+    /**
+     * @return true if there are no samples
+     **/
+    bool empty() const;
+
+    /**
+     * @param i sample index
+     * @return time of a sample
+     **/
+    tf2Scalar time(size_t i) const;
+
+    /**
+     * @param i sample index
+     * @return arc length from the first sample to sample i
+     **/
+    tf2Scalar arc_length(size_t i) const;
+
+    /**
+     * @param i sample index
+     * @return pose of a sample
+     **/
+    Transform2D pose(size_t i) const;
+
+    /**
+     * @return arc length of the whole trajectory
+     **/
+    tf2Scalar length() const;
+
+    /**
+     * finds the segment [i, i + 1] containing a time
+     * @param time time stamp
+     * @param cursor optional cursor, used as start and updated
+     * @return index i of the first sample of the segment, clamped to [0, size() - 2]
+     **/
+    size_t find_time(tf2Scalar time, Cursor *cursor = nullptr) const;
+
+    /**
+     * finds the segment [i, i + 1] containing an arc length
+     * @param s arc length
+     * @param cursor optional cursor, used as start and updated
+     * @return index i of the first sample of the segment, clamped to [0, size() - 2]
+     **/
+    size_t find_arc_length(tf2Scalar s, Cursor *cursor = nullptr) const;
+
+    /**
+     * interpolates the pose at a time
+     * @param time time stamp
+     * @param des pose
+     * @param cursor optional cursor, used as start and updated
+     * @return ref to des
+     **/
+    Transform2D &at_time(tf2Scalar time, Transform2D &des, Cursor *cursor = nullptr) const;
+
+    /**
+     * interpolates the pose at an arc length
+     * @param s arc length
+     * @param des pose
+     * @param cursor optional cursor, used as start and updated
+     * @return ref to des
+     **/
+    Transform2D &at_arc_length(tf2Scalar s, Transform2D &des, Cursor *cursor = nullptr) const;
+
+    /**
+     * samples the trajectory at constant time steps from the first sample on
+     * @param period time step
+     * @param x x of the samples, array with capacity elements
+     * @param y y of the samples, array with capacity elements
+     * @param theta rotation of the samples, array with capacity elements
+     * @param capacity size of the arrays
+     * @return number of samples of the whole trajectory, only the first capacity are written,
+     * 0 if period is not finite and positive or more than 2^32 samples are needed
+     **/
+    size_t resample_time(tf2Scalar period, tf2Scalar *x, tf2Scalar *y, tf2Scalar *theta, size_t capacity) const;
+
+    /**
+     * samples the trajectory at constant arc length steps from the first sample on
+     * @param spacing arc length step
+     * @param x x of the samples, array with capacity elements
+     * @param y y of the samples, array with capacity elements
+     * @param theta rotation of the samples, array with capacity elements
+     * @param capacity size of the arrays
+     * @return number of samples of the whole trajectory, only the first capacity are written,
+     * 0 if spacing is not finite and positive or more than 2^32 samples are needed
+     **/
+    size_t resample_arc_length(tf2Scalar spacing, tf2Scalar *x, tf2Scalar *y, tf2Scalar *theta, size_t capacity) const;
+
+  private:
+    std::vector<tf2Scalar> m_time;            /// time stamps
+    std::vector<tf2Scalar> m_x, m_y, m_theta; /// poses
+    std::vector<tf2Scalar> m_arc;             /// cumulative arc length
+    std::vector<tf2Scalar> m_dtheta;          /// shortest rotation to the next sample
+
+    /**
+     * finds the segment containing a key in an ascending array
+     **/
+    size_t find(const std::vector<tf2Scalar> &keys, tf2Scalar key, Cursor *cursor) const;
+
+    /**
+     * interpolates within the segment containing a key
+     **/
+    Transform2D &interpolate(const std::vector<tf2Scalar> &keys, tf2Scalar key, Transform2D &des, Cursor *cursor) const;
+
+    /**
+     * samples at constant steps of a key
+     **/
+    size_t resample(const std::vector<tf2Scalar> &keys, tf2Scalar step, tf2Scalar *x, tf2Scalar *y, tf2Scalar *theta,
+                    size_t capacity) const;
+};
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__TRAJECTORY2D_HPP
@@ -34,7 +34,7 @@ class Transform2D {
      **/
     Transform2D(const Point2D &p, tf2Scalar roation);
     /**
-     * copy constructor
+     * copy constructor, copies the cached cos/sin values
      * @param p transfrom
      **/
     Transform2D(const Transform2D &p);
@@ -81,6 +81,17 @@ class Transform2D {
      **/
     Transform2D &set(const Transform2D &p);
 
+    /**
+     * sets the transform with precomputed cos(rotation) and sin(rotation), the cache stays valid
+     * @param x
+     * @param y
+     * @param rotation
+     * @param costheta cos(rotation)
+     * @param sintheta sin(rotation)
+     * @return this reference
+     **/
+    Transform2D &set(tf2Scalar x, tf2Scalar y, tf2Scalar rotation, tf2Scalar costheta, tf2Scalar sintheta);
+
     /**
      * position
      * @return translational
@@ -118,6 +129,18 @@ class Transform2D {
      **/
     const tf2Scalar &rotation() const;
 
+    /**
+     * cached cos(rotation), computed if the cache is invalid
+     * @return cos(rotation)
+     **/
+    const tf2Scalar &cos_theta() const;
+
+    /**
+     * cached sin(rotation), computed if the cache is invalid
+     * @return sin(rotation)
+     **/
+    const tf2Scalar &sin_theta() const;
+
     /**
      * sets the rotational component
      * @param rotation
@@ -0,0 +1,35 @@
+#ifndef TF2_GEOMETRY__TRANSFORM2D_SEQUENCE_HPP
+#define TF2_GEOMETRY__TRANSFORM2D_SEQUENCE_HPP
+
+#include <cstddef>
+#include "tf2_geometry/transform2d.hpp"
+
+namespace tf2 {
+
+class ExecutionPolicy; /// Prototype
+
+/**
+ * composes relative transforms into absolute poses, des[i] = src[0] * src[1] * ... * src[i],
+ * e.g. to integrate odometry increments or to roll out a trajectory, pass the start pose as src[0].
+ * Every step carries cos and sin of the accumulated rotation forward with the angle addition theorem,
+ * so only the cached cos and sin of the increments are used and the results have a valid cache.
+ * @param src relative transforms
+ * @param n number of transforms
+ * @param des absolute poses, array with n elements, may be src
+ **/
+void compose_prefix(const Transform2D *src, size_t n, Transform2D *des);
+
+/**
+ * composes relative transforms into absolute poses with a parallel prefix scan on an execution policy.
+ * SE(2) composition is associative, so the sequence is split into blocks which are composed independently,
+ * the block totals are composed sequentially and applied to the following blocks in a second parallel pass.
+ * The result equals compose_prefix up to rounding.
+ * @param policy execution policy
+ * @param src relative transforms
+ * @param n number of transforms
+ * @param des absolute poses, array with n elements, may be src
+ **/
+void compose_prefix(const ExecutionPolicy &policy, const Transform2D *src, size_t n, Transform2D *des);
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__TRANSFORM2D_SEQUENCE_HPP
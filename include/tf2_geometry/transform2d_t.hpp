@@ -0,0 +1,178 @@
+#ifndef TF2_GEOMETRY__TRANSFORM2D_T_HPP
+#define TF2_GEOMETRY__TRANSFORM2D_T_HPP
+
+#include "tf2_geometry/pack.hpp"
+#include "tf2_geometry/transform2d.hpp"
+
+namespace tf2 {
+
+/**
+ * class to represent a transform in 2D space from a parent frame to a child frame for a scalar type T.
+ * T can be float, double or a simd::Pack, the latter transforms N independent poses at once.
+ * Unlike Transform2D the cos(theta) and sin(theta) values are updated eagerly by every setter,
+ * so there is no cache flag to branch on and a composition carries cos and sin without trigonometry.
+ **/
+template<typename T>
+class Transform2DT {
+  protected:
+    T m_x, m_y;                 /// translation t
+    T m_rotation;               /// rotation in rad
+    T m_costheta, m_sintheta;   /// cos() & sin() of the rotation
+
+  public:
+    using Scalar = T;
+
+    /**
+     * constructor, identity
+     **/
+    Transform2DT() : m_x(0.), m_y(0.), m_rotation(0.), m_costheta(1.), m_sintheta(0.) {}
+
+    /**
+     * constructor
+     * @param x
+     * @param y
+     * @param rotation
+     **/
+    Transform2DT(const T &x, const T &y, const T &rotation) {
+        set(x, y, rotation);
+    }
+
+    /**
+     * constructor from a Transform2D, a pack gets the same transform in all lanes
+     * @param src transform
+     **/
+    explicit Transform2DT(const Transform2D &src) {
+        set(T(src.x()), T(src.y()), T(src.rotation()));
+    }
+
+    /**
+     * sets the transform
+     * @param x
+     * @param y
+     * @param rotation
+     * @return this reference
+     **/
+    Transform2DT &set(const T &x, const T &y, const T &rotation) {
+        return set(x, y, rotation, simd::cos(rotation), simd::sin(rotation));
+    }
+
+    /**
+     * sets the transform with precomputed cos(rotation) and sin(rotation)
+     * @param x
+     * @param y
+     * @param rotation
+     * @param costheta cos(rotation)
+     * @param sintheta sin(rotation)
+     * @return this reference
+     **/
+    Transform2DT &set(const T &x, const T &y, const T &rotation, const T &costheta, const T &sintheta) {
+        m_x = x, m_y = y, m_rotation = rotation, m_costheta = costheta, m_sintheta = sintheta;
+        return *this;
+    }
+
+    const T &x() const {
+        return m_x;
+    }
+    const T &y() const {
+        return m_y;
+    }
+    const T &rotation() const {
+        return m_rotation;
+    }
+    const T &cos() const {
+        return m_costheta;
+    }
+    const T &sin() const {
+        return m_sintheta;
+    }
+
+    /**
+     * transforms a point from the child frame into the parent frame
+     * @param x point x in the child frame
+     * @param y point y in the child frame
+     * @param des_x point x in the parent frame
+     * @param des_y point y in the parent frame
+     **/
+    void transform_into_parent(const T &x, const T &y, T &des_x, T &des_y) const {
+        const T px = x * m_costheta - y * m_sintheta + m_x;
+        des_y = x * m_sintheta + y * m_costheta + m_y;
+        des_x = px;
+    }
+
+    /**
+     * transforms a point from the parent frame into the child frame
+     * @param x point x in the parent frame
+     * @param y point y in the parent frame
+     * @param des_x point x in the child frame
+     * @param des_y point y in the child frame
+     **/
+    void transform_into_child(const T &x, const T &y, T &des_x, T &des_y) const {
+        const T dx = x - m_x, dy = y - m_y;
+        des_x = dx * m_costheta + dy * m_sintheta;
+        des_y = dy * m_costheta - dx * m_sintheta;
+    }
+
+    /**
+     * transforms a transform/pose from child frame space into the parent frame
+     * e.g this = base_link -> scan, src = scan -> object, des = base_link -> object
+     * @param src transform with parent same as current child frame
+     * @param des transform in parent frame, may be src
+     * @return ref to des
+     **/
+    Transform2DT &transform_into_parent(const Transform2DT &src, Transform2DT &des) const {
+        T x, y;
+        transform_into_parent(src.m_x, src.m_y, x, y);
+        const T c = m_costheta * src.m_costheta - m_sintheta * src.m_sintheta;
+        const T s = m_sintheta * src.m_costheta + m_costheta * src.m_sintheta;
+        return des.set(x, y, simd::angle_normalize(m_rotation + src.m_rotation), c, s);
+    }
+
+    /**
+     * transforms a transform/pose from parent frame space into the child frame
+     * e.g this = base_link -> scan, src = base_link -> object, des = scan -> object
+     * @param src transform with child same as current parent frame
+     * @param des transform in child frame, may be src
+     * @return ref to des
+     **/
+    Transform2DT &transform_into_child(const Transform2DT &src, Transform2DT &des) const {
+        T x, y;
+        transform_into_child(src.m_x, src.m_y, x, y);
+        const T c = m_costheta * src.m_costheta + m_sintheta * src.m_sintheta;
+        const T s = m_costheta * src.m_sintheta - m_sintheta * src.m_costheta;
+        return des.set(x, y, simd::angle_normalize(src.m_rotation - m_rotation), c, s);
+    }
+
+    /**
+     * @see transform_into_parent
+     **/
+    Transform2DT operator*(const Transform2DT &src) const {
+        Transform2DT des;
+        return transform_into_parent(src, des);
+    }
+
+    /**
+     * invert transform
+     * @param des inverted transform
+     * @return ref to des
+     **/
+    Transform2DT &inverse(Transform2DT &des) const {
+        const T x = -(m_x * m_costheta + m_y * m_sintheta);
+        const T y = m_x * m_sintheta - m_y * m_costheta;
+        return des.set(x, y, -m_rotation, m_costheta, -m_sintheta);
+    }
+
+    /**
+     * invert transform
+     * @return inverted transform
+     **/
+    Transform2DT inverse() const {
+        Transform2DT des;
+        return inverse(des);
+    }
+};
+
+using Transform2Df = Transform2DT<float>;
+using Transform2Dd = Transform2DT<double>;
+
+}  // namespace tf2
+#endif  // TF2_GEOMETRY__TRANSFORM2D_T_HPP
@@ -0,0 +1,190 @@
+#ifndef TF2_GEOMETRY__TYPE_ADAPTER_HPP
+#define TF2_GEOMETRY__TYPE_ADAPTER_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "geometry_msgs/msg/pose2_d.hpp"
+#include "geometry_msgs/msg/transform_stamped.hpp"
+#include "rclcpp/type_adapter.hpp"
+#include "sensor_msgs/msg/point_cloud2.hpp"
+#include "sensor_msgs/msg/point_field.hpp"
+#include "std_msgs/msg/header.hpp"
+#include "tf2_geometry/transform2d.hpp"
+#include "tf2_geometry/utils.hpp"
+
+namespace tf2 {
+
+/**
+ * Transform2D with a header and a child frame, the 2D counterpart of geometry_msgs::msg::TransformStamped
+ **/
+struct Transform2DStamped {
+    std_msgs::msg::Header header;  /// stamp and parent frame
+    std::string child_frame_id;    /// child frame
+    Transform2D transform;         /// transform from the parent into the child frame
+};
+
+/**
+ * 2D point cloud with a header, e.g. a laser scan converted into points
+ **/
+struct PointCloud2D {
+    std_msgs::msg::Header header;  /// stamp and frame
+    std::vector<Point2D> points;   /// points
+};
+
+}  // namespace tf2
+
+/**
+ * rclcpp::TypeAdapter specializations, they let intra-process publishers and subscriptions exchange
+ * the geometry types directly, the conversion runs only if a message crosses the process boundary.
+ * e.g. rclcpp::Publisher<tf2::Pose2DAdapter> or create_publisher<tf2::PointCloud2DAdapter>("scan", 10)
+ **/
+
+/**
+ * Transform2D <-> geometry_msgs::msg::Pose2D
+ **/
+template<>
+struct rclcpp::TypeAdapter<tf2::Transform2D, geometry_msgs::msg::Pose2D> {
+    using is_specialized = std::true_type;
+    using custom_type = tf2::Transform2D;
+    using ros_message_type = geometry_msgs::msg::Pose2D;
+
+    static void convert_to_ros_message(const custom_type &source, ros_message_type &destination) {
+        destination.x = source.x();
+        destination.y = source.y();
+        destination.theta = source.rotation();
+    }
+
+    static void convert_to_custom(const ros_message_type &source, custom_type &destination) {
+        destination.set(source.x, source.y, source.theta);
+    }
+};
+
+/**
+ * Transform2DStamped <-> geometry_msgs::msg::TransformStamped
+ * z is set to zero and the rotation is a yaw only quaternion, the conversion back keeps the yaw.
+ **/
+template<>
+struct rclcpp::TypeAdapter<tf2::Transform2DStamped, geometry_msgs::msg::TransformStamped> {
+    using is_specialized = std::true_type;
+    using custom_type = tf2::Transform2DStamped;
+    using ros_message_type = geometry_msgs::msg::TransformStamped;
+
+    static void convert_to_ros_message(const custom_type &source, ros_message_type &destination) {
+        destination.header = source.header;
+        destination.child_frame_id = source.child_frame_id;
+        destination.transform.translation.x = source.transform.x();
+        destination.transform.translation.y = source.transform.y();
+        destination.transform.translation.z = 0.0;
+        tf2::EulerYawToQuaternion(source.transform.rotation(), destination.transform.rotation);
+    }
+
+    static void convert_to_custom(const ros_message_type &source, custom_type &destination) {
+        destination.header = source.header;
+        destination.child_frame_id = source.child_frame_id;
+        destination.transform.set(source.transform.translation.x, source.transform.translation.y, tf2::QuaternionToYaw(source.transform.rotation));
+    }
+};
+
+/**
+ * PointCloud2D <-> sensor_msgs::msg::PointCloud2
+ * The message is an unordered cloud with the float32 fields x, y, z and z set to zero.
+ * Clouds with float32 or float64 x and y fields in the byte order of this machine are converted back,
+ * other clouds result in an empty point set.
+ **/
+template<>
+struct rclcpp::TypeAdapter<tf2::PointCloud2D, sensor_msgs::msg::PointCloud2> {
+    using is_specialized = std::true_type;
+    using custom_type = tf2::PointCloud2D;
+    using ros_message_type = sensor_msgs::msg::PointCloud2;
+
+    static void convert_to_ros_message(const custom_type &source, ros_message_type &destination) {
+        using sensor_msgs::msg::PointField;
+        const size_t n = source.points.size();
+        destination.header = source.header;
+        destination.height = 1;
+        destination.width = static_cast<uint32_t>(n);
+        destination.fields.resize(3);
+        const char *names[3] = {"x", "y", "z"};
+        for (uint32_t i = 0; i < 3; i++) {
+            destination.fields[i].name = names[i];
+            destination.fields[i].offset = i * sizeof(float);
+            destination.fields[i].datatype = PointField::FLOAT32;
+            destination.fields[i].count = 1;
+        }
+        destination.is_bigendian = is_bigendian();
+        destination.point_step = 3 * sizeof(float);
+        destination.row_step = destination.point_step * destination.width;
+        destination.is_dense = true;
+        destination.data.resize(destination.row_step);
+        float *des = reinterpret_cast<float *>(destination.data.data());
+        for (size_t i = 0; i < n; i++) {
+            des[3 * i + 0] = static_cast<float>(source.points[i].x());
+            des[3 * i + 1] = static_cast<float>(source.points[i].y());
+            des[3 * i + 2] = 0.f;
+        }
+    }
+
+    static void convert_to_custom(const ros_message_type &source, custom_type &destination) {
+        using sensor_msgs::msg::PointField;
+        destination.header = source.header;
+        destination.points.clear();
+        const PointField *fx = field(source, "x"), *fy = field(source, "y");
+        if (!fx || !fy || fx->datatype != fy->datatype || source.is_bigendian != is_bigendian() ||
+            (fx->datatype != PointField::FLOAT32 && fx->datatype != PointField::FLOAT64)) {
+            return;
+        }
+        const size_t n = static_cast<size_t>(source.width) * source.height;
+        const size_t bytes = fx->datatype == PointField::FLOAT32 ? sizeof(float) : sizeof(double);
+        /// sizes in 64 bit, the uint32_t products of the message fields can wrap
+        const uint64_t point_step = source.point_step, row_step = source.row_step;
+        if (fx->offset + bytes > point_step || fy->offset + bytes > point_step || row_step < source.width * point_step ||
+            static_cast<uint64_t>(source.data.size()) < source.height * row_step) {
+            return;
+        }
+        destination.points.resize(n);
+        size_t k = 0;
+        for (size_t r = 0; r < source.height; r++) {
+            const uint8_t *row = source.data.data() + r * source.row_step;
+            for (size_t c = 0; c < source.width; c++, k++) {
+                const uint8_t *p = row + c * source.point_step;
+                if (fx->datatype == PointField::FLOAT32) {
+                    float x, y;
+                    std::memcpy(&x, p + fx->offset, sizeof(float)), std::memcpy(&y, p + fy->offset, sizeof(float));
+                    destination.points[k].set(x, y);
+                } else {
+                    double x, y;
+                    std::memcpy(&x, p + fx->offset, sizeof(double)), std::memcpy(&y, p + fy->offset, sizeof(double));
+                    destination.points[k].set(x, y);
+                }
+            }
+        }
+    }
+
+  private:
+    static bool is_bigendian() {
+        const uint16_t one = 1;
+        uint8_t first;
+        std::memcpy(&first, &one, 1);
+        return first == 0;
+    }
+
+    static const sensor_msgs::msg::PointField *field(const ros_message_type &msg, const char *name) {
+        for (const auto &f : msg.fields) {
+            if (f.name == name && f.count == 1) {
+                return &f;
+            }
+        }
+        return nullptr;
+    }
+};
+
+namespace tf2 {
+using Pose2DAdapter = rclcpp::TypeAdapter<Transform2D, geometry_msgs::msg::Pose2D>;
+using Transform2DStampedAdapter = rclcpp::TypeAdapter<Transform2DStamped, geometry_msgs::msg::TransformStamped>;
+using PointCloud2DAdapter = rclcpp::TypeAdapter<PointCloud2D, sensor_msgs::msg::PointCloud2>;
+}  // namespace tf2
+
+#endif  // TF2_GEOMETRY__TYPE_ADAPTER_HPP
@@ -2,8 +2,11 @@
 #define Tf2_GEOMETRY__UTILS_HPP
 
 
+#include <algorithm>
+#include <cstddef>
 #include "tf2/LinearMath/Scalar.hpp"
 #include "tf2/LinearMath/Vector3.hpp"
+#include "tf2_geometry/simd.hpp"
 
 namespace tf2
 {
@@ -131,7 +134,7 @@ template<typename Quaternion>
 tf2Scalar QuaternionToRoll(const Quaternion & q)
 {
   tf2Scalar roll;
-  return QuaternionToYaw(q, roll);
+  return QuaternionToRoll(q, roll);
 }
 /**
  * Quaternion to an euler pitch angle
@@ -163,7 +166,7 @@ template<typename Quaternion>
 tf2Scalar QuaternionToPitch(const Quaternion & q)
 {
   tf2Scalar pitch;
-  return QuaternionToYaw(q, pitch);
+  return QuaternionToPitch(q, pitch);
 }
 /**
  * Quaternion to an euler yaw angle
@@ -194,14 +197,136 @@ tf2Scalar QuaternionToYaw(const Quaternion & q)
   return QuaternionToYaw(q, yaw);
 }
 
+/**
+ * Quaternion to an euler yaw angle for a rotation around z only, e.g. a 2D pose.
+ * Requires x = y = 0 and saves the products of the general case, the result is within [-PI, PI].
+ * @param q Quaterion with x,y,z and w public members
+ * @return yaw angle to compute
+ **/
+template<typename Quaternion>
+tf2Scalar QuaternionToYawPlanar(const Quaternion & q)
+{
+  return tf2Atan2(2.0 * q.w * q.z, q.w * q.w - q.z * q.z);
+}
+
 /**
  * Quaternion to euler angles
+ * The products shared by the three angles are computed once.
  * @see https://en.wikipedia.org/wiki/Conversion_between_quaternions_and_Euler_angles
  **/
 template<typename Quaternion>
 void QuaternionToEuler(const Quaternion & q, tf2Scalar & roll, tf2Scalar & pitch, tf2Scalar & yaw)
 {
-  QuaternionToRoll(q, roll), QuaternionToPitch(q, pitch), QuaternionToYaw(q, yaw);
+  const tf2Scalar xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+  roll = tf2Atan2(2.0 * (q.w * q.x + q.y * q.z), 1.0 - 2.0 * (xx + yy));
+  // use 90 degrees if out of range
+  pitch = tf2Asin(std::min<tf2Scalar>(1.0, std::max<tf2Scalar>(-1.0, 2.0 * (q.w * q.y - q.z * q.x))));
+  yaw = tf2Atan2(2.0 * (q.w * q.z + q.x * q.y), 1.0 - 2.0 * (yy + zz));
+}
+
+/**
+ * Quaternions to euler angles
+ * The arguments of atan2 and asin are computed for blocks of 256 quaternions on the stack,
+ * the angles are evaluated four at a time with the polynomial simd::atan2_4 and simd::asin4.
+ * The kernels are within 1 ULP (atan2) and 3 ULP (asin) of std:: on the same arguments, but the compiler may contract
+ * the arguments into FMA differently than in the single quaternion overload, so the angles agree to a few ULP.
+ * @param src quaternions with x,y,z and w public members
+ * @param n number of quaternions
+ * @param roll roll angles, array with n elements
+ * @param pitch pitch angles, array with n elements
+ * @param yaw yaw angles, array with n elements
+ **/
+template<typename Quaternion>
+void QuaternionToEuler(const Quaternion * src, size_t n, tf2Scalar * roll, tf2Scalar * pitch, tf2Scalar * yaw)
+{
+  constexpr size_t kBlockSize = 256;
+  alignas(simd::kAlignment) tf2Scalar sinr[kBlockSize], cosr[kBlockSize], sinp[kBlockSize], siny[kBlockSize],
+  cosy[kBlockSize], r[kBlockSize], p[kBlockSize], y[kBlockSize];
+  for (size_t i0 = 0; i0 < n; i0 += kBlockSize) {
+    const size_t m = std::min(kBlockSize, n - i0), m4 = (m + 3) & ~size_t(3);
+    const Quaternion * q = src + i0;
+    for (size_t i = 0; i < m; i++) {
+      const tf2Scalar xx = q[i].x * q[i].x, yy = q[i].y * q[i].y, zz = q[i].z * q[i].z;
+      sinr[i] = 2.0 * (q[i].w * q[i].x + q[i].y * q[i].z);
+      cosr[i] = 1.0 - 2.0 * (xx + yy);
+      siny[i] = 2.0 * (q[i].w * q[i].z + q[i].x * q[i].y);
+      cosy[i] = 1.0 - 2.0 * (yy + zz);
+      // use 90 degrees if out of range
+      sinp[i] = std::min<tf2Scalar>(1.0, std::max<tf2Scalar>(-1.0, 2.0 * (q[i].w * q[i].y - q[i].z * q[i].x)));
+    }
+    // pad the last group of four with the identity
+    for (size_t i = m; i < m4; i++) {
+      sinr[i] = siny[i] = sinp[i] = 0.0, cosr[i] = cosy[i] = 1.0;
+    }
+    for (size_t i = 0; i < m4; i += 4) {
+      simd::atan2_4(sinr + i, cosr + i, r + i);
+      simd::asin4(sinp + i, p + i);
+      simd::atan2_4(siny + i, cosy + i, y + i);
+    }
+    std::copy(r, r + m, roll + i0);
+    std::copy(p, p + m, pitch + i0);
+    std::copy(y, y + m, yaw + i0);
+  }
+}
+
+/**
+ * Quaternions to euler yaw angles
+ * The arguments of atan2 are computed blockwise as in QuaternionToEuler and evaluated with simd::atan2_4,
+ * within a few ULP of the single quaternion overload for double as the arguments may be contracted differently.
+ * @param src quaternions with x,y,z and w public members
+ * @param n number of quaternions
+ * @param yaw yaw angles, array with n elements
+ **/
+template<typename Quaternion>
+void QuaternionToYaw(const Quaternion * src, size_t n, tf2Scalar * yaw)
+{
+  constexpr size_t kBlockSize = 256;
+  alignas(simd::kAlignment) tf2Scalar siny[kBlockSize], cosy[kBlockSize], y[kBlockSize];
+  for (size_t i0 = 0; i0 < n; i0 += kBlockSize) {
+    const size_t m = std::min(kBlockSize, n - i0), m4 = (m + 3) & ~size_t(3);
+    const Quaternion * q = src + i0;
+    for (size_t i = 0; i < m; i++) {
+      siny[i] = 2.0 * (q[i].w * q[i].z + q[i].x * q[i].y);
+      cosy[i] = 1.0 - 2.0 * (q[i].y * q[i].y + q[i].z * q[i].z);
+    }
+    for (size_t i = m; i < m4; i++) {
+      siny[i] = 0.0, cosy[i] = 1.0;
+    }
+    for (size_t i = 0; i < m4; i += 4) {
+      simd::atan2_4(siny + i, cosy + i, y + i);
+    }
+    std::copy(y, y + m, yaw + i0);
+  }
+}
+
+/**
+ * Quaternions to euler yaw angles for rotations around z only
+ * The arguments are computed blockwise and evaluated with simd::atan2_4 as in QuaternionToYaw.
+ * @see QuaternionToYawPlanar
+ * @param src quaternions with x,y,z and w public members
+ * @param n number of quaternions
+ * @param yaw yaw angles, array with n elements
+ **/
+template<typename Quaternion>
+void QuaternionToYawPlanar(const Quaternion * src, size_t n, tf2Scalar * yaw)
+{
+  constexpr size_t kBlockSize = 256;
+  alignas(simd::kAlignment) tf2Scalar siny[kBlockSize], cosy[kBlockSize], y[kBlockSize];
+  for (size_t i0 = 0; i0 < n; i0 += kBlockSize) {
+    const size_t m = std::min(kBlockSize, n - i0), m4 = (m + 3) & ~size_t(3);
+    const Quaternion * q = src + i0;
+    for (size_t i = 0; i < m; i++) {
+      siny[i] = 2.0 * q[i].w * q[i].z;
+      cosy[i] = q[i].w * q[i].w - q[i].z * q[i].z;
+    }
+    for (size_t i = m; i < m4; i++) {
+      siny[i] = 0.0, cosy[i] = 1.0;
+    }
+    for (size_t i = 0; i < m4; i += 4) {
+      simd::atan2_4(siny + i, cosy + i, y + i);
+    }
+    std::copy(y, y + m, yaw + i0);
+  }
 }
 
 }  // namespace tf2
@@ -1,16 +1,19 @@
-#ifndef TF2_GEOMETRY__VECTOR2_HPP
-#define TF2_GEOMETRY__VECTOR2_HPP
+#ifndef TF2_GEOMETRY__VECTOR4_HPP
+#define TF2_GEOMETRY__VECTOR4_HPP
 
 #include "tf2/LinearMath/Scalar.hpp"
 #include "tf2/LinearMath/Vector3.hpp"
+#include "tf2_geometry/simd.hpp"
 #include <string>
 
 namespace tf2 {
 
 /**
  * class to represent a vector4 based on the tf2::Vector3 which holds 4 components
+ * the object is aligned to the size of its four components, so that arrays of Vector4 and Plane3D
+ * can be processed in 4-wide lanes, the arithmetic is inlined and uses SIMD instructions if available
  **/
-class Vector4 : protected Vector3 {
+class alignas(simd::kAlignment) Vector4 : protected Vector3 {
   public:
     // This is the type of the base class
     using Base = Vector3;
@@ -107,6 +110,76 @@ class Vector4 : protected Vector3 {
 
     using Vector3::m_floats;
 };
+
+static_assert(sizeof(Vector4) == 4 * sizeof(tf2Scalar), "Vector4 must hold four contiguous scalars");
+static_assert(alignof(Vector4) == simd::kAlignment, "Vector4 must be aligned for 4-wide lanes");
+
+TF2SIMD_FORCE_INLINE Vector4::Vector4() : Base() {
+}
+
+TF2SIMD_FORCE_INLINE Vector4 &Vector4::operator+=(const Vector4 &v) {
+    simd::add4(m_floats, v.m_floats, m_floats);
+    return *this;
+}
+
+TF2SIMD_FORCE_INLINE Vector4 &Vector4::operator-=(const Vector4 &v) {
+    simd::sub4(m_floats, v.m_floats, m_floats);
+    return *this;
+}
+
+TF2SIMD_FORCE_INLINE Vector4 &Vector4::operator*=(const tf2Scalar &s) {
+    simd::scale4(m_floats, s, m_floats);
+    return *this;
+}
+
+TF2SIMD_FORCE_INLINE Vector4 &Vector4::operator/=(const tf2Scalar &s) {
+    tf2FullAssert(s != tf2Scalar(0.0));
+    simd::scale4(m_floats, tf2Scalar(1.0) / s, m_floats);
+    return *this;
+}
+
+TF2SIMD_FORCE_INLINE Vector4 Vector4::operator+(const Vector4 &v) const {
+    Vector4 des;
+    simd::add4(m_floats, v.m_floats, des.m_floats);
+    return des;
+}
+
+TF2SIMD_FORCE_INLINE Vector4 Vector4::operator-(const Vector4 &v) const {
+    Vector4 des;
+    simd::sub4(m_floats, v.m_floats, des.m_floats);
+    return des;
+}
+
+TF2SIMD_FORCE_INLINE Vector4 Vector4::operator-() const {
+    Vector4 des;
+    simd::neg4(m_floats, des.m_floats);
+    return des;
+}
+
+TF2SIMD_FORCE_INLINE Vector4 Vector4::operator*(const tf2Scalar &s) const {
+    Vector4 des;
+    simd::scale4(m_floats, s, des.m_floats);
+    return des;
+}
+
+TF2SIMD_FORCE_INLINE Vector4 Vector4::operator/(const tf2Scalar &s) const {
+    tf2FullAssert(s != tf2Scalar(0.0));
+    Vector4 des;
+    simd::scale4(m_floats, tf2Scalar(1.0) / s, des.m_floats);
+    return des;
+}
+
+TF2SIMD_FORCE_INLINE tf2Scalar Vector4::dot(const Vector4 &v) const {
+    return simd::dot4(m_floats, v.m_floats);
+}
+
+TF2SIMD_FORCE_INLINE tf2Scalar Vector4::length2() const {
+    return simd::dot4(m_floats, m_floats);
+}
+
+TF2SIMD_FORCE_INLINE tf2Scalar Vector4::length() const {
+    return tf2Sqrt(length2());
+}
 }; // namespace tf2
 
-#endif // TF2_GEOMETRY__VECTOR2_HPP
\ No newline at end of file
+#endif // TF2_GEOMETRY__VECTOR4_HPP
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "tf2_geometry/aabb2d.hpp"
+#include "tf2_geometry/instrumentation.hpp"
+#include "tf2_geometry/simd.hpp"
+#include <algorithm>
+#include <limits>
+
+using namespace tf2;
+
+static_assert(sizeof(Point2D) == 4 * sizeof(tf2Scalar), "Point2D must be a packed [x, y, z, w] record");
+
+namespace {
+constexpr tf2Scalar kInf = std::numeric_limits<tf2Scalar>::infinity();
+}  // namespace
+
+AABB2D::AABB2D() {
+    clear();
+}
+
+AABB2D::AABB2D(tf2Scalar x_min, tf2Scalar y_min, tf2Scalar x_max, tf2Scalar y_max) {
+    set(x_min, y_min, x_max, y_max);
+}
+
+AABB2D &AABB2D::set(tf2Scalar x_min, tf2Scalar y_min, tf2Scalar x_max, tf2Scalar y_max) {
+    m_min[0] = x_min, m_min[1] = y_min, m_max[0] = x_max, m_max[1] = y_max;
+    return *this;
+}
+
+AABB2D &AABB2D::clear() {
+    return set(kInf, kInf, -kInf, -kInf);
+}
+
+bool AABB2D::empty() const {
+    return !(m_min[0] <= m_max[0] && m_min[1] <= m_max[1]);
+}
+
+tf2Scalar AABB2D::x_min() const {
+    return m_min[0];
+}
+tf2Scalar AABB2D::y_min() const {
+    return m_min[1];
+}
+tf2Scalar AABB2D::x_max() const {
+    return m_max[0];
+}
+tf2Scalar AABB2D::y_max() const {
+    return m_max[1];
+}
+
+Point2D AABB2D::center() const {
+    return Point2D(0.5 * (m_min[0] + m_max[0]), 0.5 * (m_min[1] + m_max[1]));
+}
+
+tf2Scalar AABB2D::size_x() const {
+    return empty() ? 0.0 : m_max[0] - m_min[0];
+}
+
+tf2Scalar AABB2D::size_y() const {
+    return empty() ? 0.0 : m_max[1] - m_min[1];
+}
+
+tf2Scalar AABB2D::area() const {
+    return size_x() * size_y();
+}
+
+AABB2D &AABB2D::inflate(tf2Scalar margin) {
+    if (!empty()) {
+        m_min[0] -= margin, m_min[1] -= margin, m_max[0] += margin, m_max[1] += margin;
+    }
+    return *this;
+}
+
+AABB2D &AABB2D::extend(const Point2D &p) {
+    m_min[0] = std::min(m_min[0], p.x()), m_min[1] = std::min(m_min[1], p.y());
+    m_max[0] = std::max(m_max[0], p.x()), m_max[1] = std::max(m_max[1], p.y());
+    return *this;
+}
+
+AABB2D &AABB2D::extend(const AABB2D &b) {
+    m_min[0] = std::min(m_min[0], b.m_min[0]), m_min[1] = std::min(m_min[1], b.m_min[1]);
+    m_max[0] = std::max(m_max[0], b.m_max[0]), m_max[1] = std::max(m_max[1], b.m_max[1]);
+    return *this;
+}
+
+AABB2D &AABB2D::extend(const Point2D *points, size_t n) {
+    TF2_GEOMETRY_KERNEL(kAABB2DExtend, n);
+    /// lanes x, y, z, w of the records, z and w are ignored
+    alignas(simd::kAlignment) tf2Scalar lo[4] = {m_min[0], m_min[1], kInf, kInf};
+    alignas(simd::kAlignment) tf2Scalar hi[4] = {m_max[0], m_max[1], -kInf, -kInf};
+    /// the point is the first operand, so NaN coordinates keep the box lane
+    for (size_t i = 0; i < n; i++) {
+        simd::min4(points[i].m_floats, lo, lo), simd::max4(points[i].m_floats, hi, hi);
+    }
+    return set(lo[0], lo[1], hi[0], hi[1]);
+}
+
+AABB2D &AABB2D::extend(const tf2Scalar *xs, const tf2Scalar *ys, size_t n) {
+    TF2_GEOMETRY_KERNEL(kAABB2DExtend, n);
+    /// four points per step, the lanes are reduced at the end
+    alignas(simd::kAlignment) tf2Scalar lo_x[4] = {m_min[0], m_min[0], m_min[0], m_min[0]};
+    alignas(simd::kAlignment) tf2Scalar lo_y[4] = {m_min[1], m_min[1], m_min[1], m_min[1]};
+    alignas(simd::kAlignment) tf2Scalar hi_x[4] = {m_max[0], m_max[0], m_max[0], m_max[0]};
+    alignas(simd::kAlignment) tf2Scalar hi_y[4] = {m_max[1], m_max[1], m_max[1], m_max[1]};
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        simd::min4(xs + i, lo_x, lo_x), simd::max4(xs + i, hi_x, hi_x);
+        simd::min4(ys + i, lo_y, lo_y), simd::max4(ys + i, hi_y, hi_y);
+    }
+    for (; i < n; i++) {
+        lo_x[0] = std::min(lo_x[0], xs[i]), hi_x[0] = std::max(hi_x[0], xs[i]);
+        lo_y[0] = std::min(lo_y[0], ys[i]), hi_y[0] = std::max(hi_y[0], ys[i]);
+    }
+    return set(*std::min_element(lo_x, lo_x + 4), *std::min_element(lo_y, lo_y + 4), *std::max_element(hi_x, hi_x + 4),
+               *std::max_element(hi_y, hi_y + 4));
+}
+
+AABB2D &AABB2D::extend(const LineSegment2D *segments, size_t n) {
+    TF2_GEOMETRY_KERNEL(kAABB2DExtend, n);
+    alignas(simd::kAlignment) tf2Scalar lo[4] = {m_min[0], m_min[1], kInf, kInf};
+    alignas(simd::kAlignment) tf2Scalar hi[4] = {m_max[0], m_max[1], -kInf, -kInf};
+    for (size_t i = 0; i < n; i++) {
+        const tf2Scalar *p0 = segments[i].p0().m_floats, *p1 = segments[i].p1().m_floats;
+        simd::min4(p0, lo, lo), simd::max4(p0, hi, hi);
+        simd::min4(p1, lo, lo), simd::max4(p1, hi, hi);
+    }
+    return set(lo[0], lo[1], hi[0], hi[1]);
+}
+
+bool AABB2D::contains(const Point2D &p) const {
+    return p.x() >= m_min[0] && p.x() <= m_max[0] && p.y() >= m_min[1] && p.y() <= m_max[1];
+}
+
+bool AABB2D::intersects(const AABB2D &b) const {
+    return m_min[0] <= b.m_max[0] && b.m_min[0] <= m_max[0] && m_min[1] <= b.m_max[1] && b.m_min[1] <= m_max[1];
+}
@@ -0,0 +1,242 @@
+#include "tf2_geometry/convex_hull2d.hpp"
+#include "tf2_geometry/instrumentation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+using namespace tf2;
+
+namespace {
+
+/// > 0 if c is left of the line a -> b
+inline tf2Scalar cross(const tf2Scalar *xs, const tf2Scalar *ys, size_t a, size_t b, size_t c) {
+    return (xs[b] - xs[a]) * (ys[c] - ys[a]) - (ys[b] - ys[a]) * (xs[c] - xs[a]);
+}
+
+inline bool same(const tf2Scalar *xs, const tf2Scalar *ys, size_t a, size_t b) {
+    return xs[a] == xs[b] && ys[a] == ys[b];
+}
+
+/// indices of the points with the min and max projection on a direction
+void extremes(const tf2Scalar *xs, const tf2Scalar *ys, size_t n, tf2Scalar dx, tf2Scalar dy, size_t &lo, size_t &hi) {
+    lo = hi = 0;
+    tf2Scalar min = xs[0] * dx + ys[0] * dy, max = min;
+    for (size_t i = 1; i < n; i++) {
+        const tf2Scalar d = xs[i] * dx + ys[i] * dy;
+        if (d < min) {
+            min = d, lo = i;
+        } else if (d > max) {
+            max = d, hi = i;
+        }
+    }
+}
+
+/// Andrew's monotone chain, writes the hull counter clockwise to hull[0, return)
+size_t monotone_chain(const tf2Scalar *xs, const tf2Scalar *ys, size_t n, std::vector<size_t> &order, size_t *hull) {
+    order.resize(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [xs, ys](size_t a, size_t b) { return xs[a] < xs[b] || (xs[a] == xs[b] && ys[a] < ys[b]); });
+    size_t k = 0;
+    for (size_t i = 0; i < n; i++) {
+        while (k >= 2 && cross(xs, ys, hull[k - 2], hull[k - 1], order[i]) <= 0.0) {
+            k--;
+        }
+        hull[k++] = order[i];
+    }
+    /// upper chain, the first point closes the polygon and is dropped
+    for (size_t i = n - 1, lower = k + 1; i-- > 0;) {
+        while (k >= lower && cross(xs, ys, hull[k - 2], hull[k - 1], order[i]) <= 0.0) {
+            k--;
+        }
+        hull[k++] = order[i];
+    }
+    return k - 1;
+}
+
+/// Melkman's algorithm for a simple polyline, writes the hull counter clockwise to hull[0, return)
+size_t melkman(const tf2Scalar *xs, const tf2Scalar *ys, size_t n, std::vector<size_t> &deque, size_t *hull) {
+    /// a collinear start is reduced to its extremes so the deque starts with a proper triangle
+    size_t b = 1;
+    while (b < n && same(xs, ys, 0, b)) {
+        b++;
+    }
+    if (b == n) {
+        hull[0] = 0;
+        return 1;
+    }
+    size_t c = b + 1;
+    while (c < n && cross(xs, ys, 0, b, c) == 0.0) {
+        c++;
+    }
+    size_t lo, hi;
+    extremes(xs, ys, c, xs[b] - xs[0], ys[b] - ys[0], lo, hi);
+    if (c == n) {
+        hull[0] = lo, hull[1] = hi;
+        return 2;
+    }
+    deque.resize(2 * n + 4);
+    size_t *d = deque.data();
+    size_t bot = n, top = bot + 3;
+    d[bot] = d[top] = c;
+    if (cross(xs, ys, lo, hi, c) > 0.0) {
+        d[bot + 1] = lo, d[bot + 2] = hi;
+    } else {
+        d[bot + 1] = hi, d[bot + 2] = lo;
+    }
+    for (size_t i = c + 1; i < n; i++) {
+        if (same(xs, ys, i, d[top])) {
+            continue;
+        }
+        /// points inside the wedge at the last vertex are inside the hull
+        if (cross(xs, ys, d[bot], d[bot + 1], i) > 0.0 && cross(xs, ys, d[top - 1], d[top], i) > 0.0) {
+            continue;
+        }
+        while (top - bot > 2 && cross(xs, ys, d[bot], d[bot + 1], i) <= 0.0) {
+            bot++;
+        }
+        d[--bot] = i;
+        while (top - bot > 2 && cross(xs, ys, d[top - 1], d[top], i) <= 0.0) {
+            top--;
+        }
+        d[++top] = i;
+    }
+    std::copy(d + bot, d + top, hull);
+    return top - bot;
+}
+
+}  // namespace
+
+ConvexHull2D::ConvexHull2D() {}
+
+size_t ConvexHull2D::assign(const tf2Scalar *xs, const tf2Scalar *ys, const size_t *indices, size_t n) {
+    /// identical points leave two equal vertices
+    if (n == 2 && same(xs, ys, indices[0], indices[1])) {
+        n = 1;
+    }
+    m_x.resize(n), m_y.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        m_x[i] = xs[indices[i]], m_y[i] = ys[indices[i]];
+    }
+    m_indices.resize(n);
+    return n;
+}
+
+size_t ConvexHull2D::compute(const Point2D *points, size_t n) {
+    m_px.resize(n), m_py.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        m_px[i] = points[i].x(), m_py[i] = points[i].y();
+    }
+    return compute(m_px.data(), m_py.data(), n);
+}
+
+size_t ConvexHull2D::compute(const tf2Scalar *xs, const tf2Scalar *ys, size_t n) {
+    TF2_GEOMETRY_KERNEL(kConvexHull2DCompute, n);
+    m_indices.resize(2 * n);
+    const size_t h = n < 2 ? n : monotone_chain(xs, ys, n, m_buffer, m_indices.data());
+    if (n == 1) {
+        m_indices[0] = 0;
+    }
+    return assign(xs, ys, m_indices.data(), h);
+}
+
+size_t ConvexHull2D::compute_ordered(const Point2D *points, size_t n) {
+    m_px.resize(n), m_py.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        m_px[i] = points[i].x(), m_py[i] = points[i].y();
+    }
+    return compute_ordered(m_px.data(), m_py.data(), n);
+}
+
+size_t ConvexHull2D::compute_ordered(const tf2Scalar *xs, const tf2Scalar *ys, size_t n) {
+    TF2_GEOMETRY_KERNEL(kConvexHull2DCompute, n);
+    m_indices.resize(n + 1);
+    const size_t h = n == 0 ? 0 : melkman(xs, ys, n, m_buffer, m_indices.data());
+    return assign(xs, ys, m_indices.data(), h);
+}
+
+size_t ConvexHull2D::size() const {
+    return m_x.size();
+}
+
+const tf2Scalar *ConvexHull2D::x() const {
+    return m_x.data();
+}
+
+const tf2Scalar *ConvexHull2D::y() const {
+    return m_y.data();
+}
+
+const size_t *ConvexHull2D::indices() const {
+    return m_indices.data();
+}
+
+Point2D ConvexHull2D::point(size_t i) const {
+    return Point2D(m_x[i], m_y[i]);
+}
+
+tf2Scalar ConvexHull2D::area() const {
+    const size_t m = size();
+    tf2Scalar sum = 0.0;
+    for (size_t i = 0, j = m - 1; i < m; j = i++) {
+        sum += m_x[j] * m_y[i] - m_x[i] * m_y[j];
+    }
+    return 0.5 * sum;
+}
+
+tf2Scalar ConvexHull2D::min_area_rectangle(Transform2D &pose, tf2Scalar &length, tf2Scalar &width) const {
+    return calipers(true, pose, length, width);
+}
+
+tf2Scalar ConvexHull2D::min_width_rectangle(Transform2D &pose, tf2Scalar &length, tf2Scalar &width) const {
+    return calipers(false, pose, length, width);
+}
+
+tf2Scalar ConvexHull2D::calipers(bool area, Transform2D &pose, tf2Scalar &length, tf2Scalar &width) const {
+    const size_t m = size();
+    length = width = 0.0;
+    if (m < 2) {
+        pose.set(m == 1 ? m_x[0] : 0.0, m == 1 ? m_y[0] : 0.0, 0.0);
+        return 0.0;
+    }
+    const tf2Scalar *xs = m_x.data(), *ys = m_y.data();
+    auto next = [m](size_t i) { return i + 1 == m ? 0 : i + 1; };
+    /// calipers on the max along the edge, the max normal to the edge and the min along the edge,
+    /// all three only move forward while the edge rotates counter clockwise
+    size_t j = 1, k = 1, l = 1;
+    tf2Scalar best = std::numeric_limits<tf2Scalar>::infinity(), best_ux = 1.0, best_uy = 0.0, cx = 0.0, cy = 0.0;
+    for (size_t i = 0; i < m; i++) {
+        const size_t i1 = next(i);
+        const tf2Scalar ex = xs[i1] - xs[i], ey = ys[i1] - ys[i], norm = std::sqrt(ex * ex + ey * ey);
+        const tf2Scalar ux = ex / norm, uy = ey / norm;
+        auto u = [&](size_t q) { return (xs[q] - xs[i]) * ux + (ys[q] - ys[i]) * uy; };
+        auto v = [&](size_t q) { return (ys[q] - ys[i]) * ux - (xs[q] - xs[i]) * uy; };
+        for (size_t step = 0; step < m && u(next(j)) > u(j); step++) {
+            j = next(j);
+        }
+        for (size_t step = 0; step < m && v(next(k)) > v(k); step++) {
+            k = next(k);
+        }
+        if (i == 0) {
+            l = k;
+        }
+        for (size_t step = 0; step < m && u(next(l)) < u(l); step++) {
+            l = next(l);
+        }
+        const tf2Scalar max_u = u(j), min_u = u(l), max_v = v(k);
+        const tf2Scalar value = area ? (max_u - min_u) * max_v : max_v;
+        if (value < best) {
+            best = value, best_ux = ux, best_uy = uy, length = max_u - min_u, width = max_v;
+            const tf2Scalar mu = 0.5 * (max_u + min_u), mv = 0.5 * max_v;
+            cx = xs[i] + mu * ux - mv * uy, cy = ys[i] + mu * uy + mv * ux;
+        }
+    }
+    /// the x axis of the pose is along the longer side
+    if (width > length) {
+        std::swap(length, width);
+        pose.set(cx, cy, std::atan2(best_ux, -best_uy));
+    } else {
+        pose.set(cx, cy, std::atan2(best_uy, best_ux));
+    }
+    return best;
+}
@@ -0,0 +1,281 @@
+#include "tf2_geometry/correlative_scan_matcher2d.hpp"
+#include "tf2_geometry/distance_field2d.hpp"
+#include "tf2_geometry/instrumentation.hpp"
+#include "tf2_geometry/utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using namespace tf2;
+
+namespace {
+/// upper limit for the heading steps on each side of the prior, bounds the scan cells
+constexpr int32_t kMaxHeadingSteps = 1 << 12;
+/// upper limit for the window cells on each side of the prior, keeps the offsets within int32
+constexpr int32_t kMaxWindowCells = 1 << 15;
+/// scan cells further away than this are off the grid for every offset of the window
+constexpr tf2Scalar kMaxCell = 1 << 30;
+/// cell of non-finite or far scan points, scores zero like points outside of the map
+constexpr int32_t kOffGrid = -(1 << 30);
+
+/// higher scores first, ties in a fixed order so the result does not depend on the sort
+template<typename T> bool better(const T &a, const T &b) {
+    if (a.score != b.score) return a.score > b.score;
+    if (a.heading != b.heading) return a.heading < b.heading;
+    if (a.dx != b.dx) return a.dx < b.dx;
+    return a.dy < b.dy;
+}
+}  // namespace
+
+CorrelativeScanMatcher2D::CorrelativeScanMatcher2D() : m_width(0), m_height(0), m_resolution(1.0), m_points(0) {
+    configure(Config());
+}
+
+CorrelativeScanMatcher2D::CorrelativeScanMatcher2D(const Config &config)
+    : m_width(0), m_height(0), m_resolution(1.0), m_points(0) {
+    configure(config);
+}
+
+void CorrelativeScanMatcher2D::configure(const Config &config) {
+    m_config = config;
+    m_config.levels = std::max<size_t>(1, std::min<size_t>(m_config.levels, 16));
+    if (!std::isfinite(m_config.linear_window)) {
+        m_config.linear_window = Config().linear_window;
+    }
+    m_config.linear_window = std::max<tf2Scalar>(0.0, m_config.linear_window);
+    if (std::isnan(m_config.angular_window)) {
+        m_config.angular_window = Config().angular_window;
+    }
+    m_config.angular_window = std::clamp<tf2Scalar>(m_config.angular_window, 0.0, M_PI);
+    if (!std::isfinite(m_config.angular_step)) {
+        m_config.angular_step = 0.0;
+    }
+    if (!m_levels.empty()) {
+        build_pyramid();
+    }
+}
+
+const CorrelativeScanMatcher2D::Config &CorrelativeScanMatcher2D::config() const {
+    return m_config;
+}
+
+void CorrelativeScanMatcher2D::set_execution_policy(const ExecutionPolicy &policy) {
+    m_execution = policy;
+}
+
+bool CorrelativeScanMatcher2D::set_map(const float *grid, uint32_t width, uint32_t height, tf2Scalar resolution,
+                                       const Transform2D &origin) {
+    if (!(resolution > 0.0) || !std::isfinite(resolution)) {
+        m_width = 0, m_height = 0, m_resolution = 1.0;
+        m_levels.clear();
+        return false;
+    }
+    m_width = width, m_height = height, m_resolution = resolution;
+    m_origin.set(origin);
+    m_levels.resize(1);
+    m_levels[0].assign(grid, grid + static_cast<size_t>(width) * height);
+    build_pyramid();
+    return true;
+}
+
+bool CorrelativeScanMatcher2D::set_map(const DistanceField2D &field) {
+    const DistanceField2D::Config &config = field.config();
+    if (!field.likelihoods().empty()) {
+        return set_map(field.likelihoods().data(), config.width, config.height, config.resolution, config.origin);
+    }
+    const std::vector<float> &distances = field.distances();
+    std::vector<float> grid(distances.size());
+    const float scale = static_cast<float>(1.0 / config.max_distance);
+    for (size_t i = 0; i < grid.size(); i++) {
+        grid[i] = 1.0f - distances[i] * scale;
+    }
+    return set_map(grid.data(), config.width, config.height, config.resolution, config.origin);
+}
+
+void CorrelativeScanMatcher2D::build_pyramid() {
+    const int64_t w = m_width, h = m_height;
+    /// level k costs (w + 2^k - 1) * (h + 2^k - 1) cells, stop at the first level which spans the grid or the window
+    const tf2Scalar window = std::ceil(m_config.linear_window / m_resolution);
+    const tf2Scalar span = std::min<tf2Scalar>(static_cast<tf2Scalar>(std::max(w, h)), 2.0 * window + 1.0);
+    size_t levels = 1;
+    while (levels < m_config.levels && static_cast<tf2Scalar>(int64_t(1) << (levels - 1)) < span) {
+        levels++;
+    }
+    m_levels.resize(levels);
+    for (size_t k = 1; k < m_levels.size(); k++) {
+        /// window of 2^k cells at x is the max of the windows of 2^(k - 1) cells at x and x + 2^(k - 1)
+        const int64_t pad = (int64_t(1) << k) - 1, pad_fine = (int64_t(1) << (k - 1)) - 1, half = int64_t(1) << (k - 1);
+        const int64_t stride = w + pad, stride_fine = w + pad_fine;
+        const std::vector<float> &fine = m_levels[k - 1];
+        auto get = [&](int64_t x, int64_t y) {
+            if (x < -pad_fine || y < -pad_fine || x >= w || y >= h) return 0.0f;
+            return fine[(y + pad_fine) * stride_fine + x + pad_fine];
+        };
+        std::vector<float> &coarse = m_levels[k];
+        coarse.resize(static_cast<size_t>(stride * (h + pad)));
+        for (int64_t y = -pad; y < h; y++) {
+            float *row = coarse.data() + (y + pad) * stride + pad;
+            for (int64_t x = -pad; x < w; x++) {
+                row[x] = std::max(std::max(get(x, y), get(x + half, y)), std::max(get(x, y + half), get(x + half, y + half)));
+            }
+        }
+    }
+}
+
+const std::vector<float> &CorrelativeScanMatcher2D::level(size_t level) const {
+    return m_levels[level];
+}
+
+size_t CorrelativeScanMatcher2D::levels() const {
+    return m_levels.size();
+}
+
+float CorrelativeScanMatcher2D::score(size_t level, int32_t heading, int32_t dx, int32_t dy) const {
+    const int64_t pad = (int64_t(1) << level) - 1, stride = m_width + pad, w = m_width, h = m_height;
+    const float *values = m_levels[level].data();
+    const int32_t *cells = m_cells.data() + static_cast<size_t>(heading) * m_points * 2;
+    float sum = 0.0f;
+    for (size_t i = 0; i < m_points; i++) {
+        const int64_t x = int64_t(cells[2 * i]) + dx, y = int64_t(cells[2 * i + 1]) + dy;
+        if (x >= -pad && y >= -pad && x < w && y < h) {
+            sum += values[(y + pad) * stride + x + pad];
+        }
+    }
+    return sum / static_cast<float>(m_points);
+}
+
+void CorrelativeScanMatcher2D::search(size_t level, const Candidate *candidates, size_t n, int32_t window, Candidate &best,
+                                      size_t &count) const {
+    for (size_t i = 0; i < n; i++) {
+        const Candidate &c = candidates[i];
+        if (c.score <= best.score) {
+            break;  /// sorted, so no later candidate can beat the best either
+        }
+        if (level == 0) {
+            best = c;
+            break;
+        }
+        const int32_t half = int32_t(1) << (level - 1);
+        std::array<Candidate, 4> children;
+        size_t m = 0;
+        for (int32_t a = 0; a < 2; a++) {
+            for (int32_t b = 0; b < 2; b++) {
+                const int32_t dx = c.dx + a * half, dy = c.dy + b * half;
+                if (dx > window || dy > window) {
+                    continue;
+                }
+                /// insertion keeps the children sorted
+                const Candidate child{c.heading, dx, dy, score(level - 1, c.heading, dx, dy)};
+                size_t j = m++;
+                for (; j > 0 && better(child, children[j - 1]); j--) {
+                    children[j] = children[j - 1];
+                }
+                children[j] = child;
+            }
+        }
+        count += m;
+        search(level - 1, children.data(), m, window, best, count);
+    }
+}
+
+bool CorrelativeScanMatcher2D::match(const Point2D *scan, size_t n, const Transform2D &prior, Result &des) {
+    TF2_GEOMETRY_KERNEL(kCorrelativeScanMatcher2DMatch, n);
+    des.score = 0.0, des.candidates = 0;
+    if (m_levels.empty() || n == 0) {
+        return false;
+    }
+    const ExecutionPolicy policy = m_execution ? *m_execution : ExecutionPolicy::thread_pool(ThreadPool::shared());
+
+    /// headings in the grid frame, the step moves the furthest point by about one cell
+    Transform2D local;
+    m_origin.transform_into_child(prior, local);
+    tf2Scalar step = m_config.angular_step;
+    if (!(step > 0.0)) {
+        /// non-finite and far points are off the grid and do not shrink the step
+        const tf2Scalar r2_max = (kMaxCell * m_resolution) * (kMaxCell * m_resolution);
+        tf2Scalar r2 = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            const tf2Scalar d2 = scan[i].x() * scan[i].x() + scan[i].y() * scan[i].y();
+            if (d2 < r2_max) {
+                r2 = std::max(r2, d2);
+            }
+        }
+        const tf2Scalar r = std::max(std::sqrt(r2), m_resolution);
+        step = std::acos(1.0 - m_resolution * m_resolution / (2.0 * r * r));
+    }
+    /// too many headings coarsen the step instead of allocating gigabytes of scan cells
+    int32_t steps = 0;
+    if (m_config.angular_window > 0.0) {
+        if (!(m_config.angular_window <= step * kMaxHeadingSteps)) {
+            step = m_config.angular_window / kMaxHeadingSteps;
+        }
+        steps = static_cast<int32_t>(std::ceil(m_config.angular_window / step));
+    }
+    const size_t headings = static_cast<size_t>(2 * steps + 1);
+    m_cos.resize(headings), m_sin.resize(headings);
+    for (size_t j = 0; j < headings; j++) {
+        const tf2Scalar theta = local.rotation() + (static_cast<int32_t>(j) - steps) * step;
+        m_cos[j] = std::cos(theta), m_sin[j] = std::sin(theta);
+    }
+
+    /// scan cells per heading, the translations of the window are integer offsets of them
+    m_points = n;
+    m_cells.resize(headings * n * 2);
+    const tf2Scalar scale = 1.0 / m_resolution, tx = local.x(), ty = local.y();
+    policy.for_each(headings, 1, [&](size_t begin, size_t end) {
+        for (size_t j = begin; j < end; j++) {
+            const tf2Scalar c = m_cos[j], s = m_sin[j];
+            int32_t *cells = m_cells.data() + j * n * 2;
+            for (size_t i = 0; i < n; i++) {
+                const tf2Scalar x = c * scan[i].x() - s * scan[i].y() + tx, y = s * scan[i].x() + c * scan[i].y() + ty;
+                const tf2Scalar cx = std::floor(x * scale), cy = std::floor(y * scale);
+                if (!(std::fabs(cx) < kMaxCell && std::fabs(cy) < kMaxCell)) {
+                    cells[2 * i] = cells[2 * i + 1] = kOffGrid;
+                    continue;
+                }
+                cells[2 * i] = static_cast<int32_t>(cx);
+                cells[2 * i + 1] = static_cast<int32_t>(cy);
+            }
+        }
+    });
+
+    /// coarsest candidates tile the window
+    const size_t top = m_levels.size() - 1;
+    /// offsets beyond the grid plus the furthest scan cell move every point off the grid
+    int64_t reach = 0;
+    for (size_t i = 0; i < m_cells.size(); i++) {
+        if (m_cells[i] != kOffGrid) {
+            reach = std::max<int64_t>(reach, std::abs(int64_t(m_cells[i])));
+        }
+    }
+    reach = std::min<int64_t>(reach + std::max<int64_t>(m_width, m_height), kMaxWindowCells);
+    const int32_t window = static_cast<int32_t>(std::min<tf2Scalar>(std::ceil(m_config.linear_window * scale), reach));
+    const int32_t size = int32_t(1) << top;
+    std::vector<Candidate> candidates;
+    for (size_t j = 0; j < headings; j++) {
+        for (int32_t dx = -window; dx <= window; dx += size) {
+            for (int32_t dy = -window; dy <= window; dy += size) {
+                candidates.push_back(Candidate{static_cast<int32_t>(j), dx, dy, 0.0f});
+            }
+        }
+    }
+    policy.for_each(candidates.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            candidates[i].score = score(top, candidates[i].heading, candidates[i].dx, candidates[i].dy);
+        }
+    });
+    std::sort(candidates.begin(), candidates.end(), better<Candidate>);
+
+    Candidate best{-1, 0, 0, static_cast<float>(m_config.min_score)};
+    size_t count = candidates.size();
+    search(top, candidates.data(), candidates.size(), window, best, count);
+    des.candidates = count;
+    if (best.heading < 0) {
+        return false;
+    }
+    const tf2Scalar theta = local.rotation() + (best.heading - steps) * step;
+    const Transform2D pose(tx + best.dx * m_resolution, ty + best.dy * m_resolution, angle_normalize(theta));
+    m_origin.transform_into_parent(pose, des.pose);
+    des.score = best.score;
+    return true;
+}
@@ -0,0 +1,277 @@
+#include "tf2_geometry/distance_field2d.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <tuple>
+
+using namespace tf2;
+
+namespace {
+/// squared distance of cells without an occupied cell in range
+constexpr tf2Scalar kFar = 1e20;
+
+/**
+ * cells within max_distance, bounded by the grid so the cast stays defined
+ **/
+int64_t margin_cells(tf2Scalar max_distance, tf2Scalar resolution, uint32_t width, uint32_t height) {
+    const tf2Scalar cells = std::ceil(max_distance / resolution);
+    return static_cast<int64_t>(std::min<tf2Scalar>(cells, static_cast<tf2Scalar>(width) + height)) + 1;
+}
+
+bool less(const LineSegment2D &a, const LineSegment2D &b) {
+    return std::make_tuple(a.x0(), a.y0(), a.x1(), a.y1()) < std::make_tuple(b.x0(), b.y0(), b.x1(), b.y1());
+}
+}  // namespace
+
+DistanceField2D::DistanceField2D() {
+    configure(Config());
+}
+
+DistanceField2D::DistanceField2D(const Config &config) {
+    configure(config);
+}
+
+void DistanceField2D::configure(const Config &config) {
+    m_config = config;
+    if (!(m_config.resolution > 0.0) || !std::isfinite(m_config.resolution)) {
+        m_config.resolution = Config().resolution;
+    }
+    if (!(m_config.max_distance > 0.0) || !std::isfinite(m_config.max_distance)) {
+        m_config.max_distance = Config().max_distance;
+    }
+    /// levels stop at the first one with a single cell, further ones would shift the size to zero
+    size_t levels = 1;
+    while (levels < m_config.levels && (uint64_t(1) << (levels - 1)) < std::max(m_config.width, m_config.height)) {
+        levels++;
+    }
+    m_config.levels = levels;
+    SegmentRasterizer2D::Config raster;
+    raster.resolution = m_config.resolution;
+    raster.width = m_config.width, raster.height = m_config.height;
+    raster.origin.set(m_config.origin);
+    raster.value = 1;
+    m_rasterizer.configure(raster);
+    m_segments.clear();
+    m_occupied.assign(static_cast<size_t>(m_config.width) * m_config.height, 0);
+    m_levels.resize(m_config.levels);
+    for (size_t k = 0; k < m_config.levels; k++) {
+        m_levels[k].assign(static_cast<size_t>(width(k)) * height(k), static_cast<float>(m_config.max_distance));
+    }
+    if (m_config.sigma > 0.0) {
+        const tf2Scalar far = std::exp(-m_config.max_distance * m_config.max_distance / (2.0 * m_config.sigma * m_config.sigma));
+        m_likelihood.assign(m_levels[0].size(), static_cast<float>(far));
+    } else {
+        m_likelihood.clear();
+    }
+    const size_t n = std::max(m_config.width, m_config.height);
+    m_f.resize(n), m_d.resize(n), m_v.resize(n), m_z.resize(n + 1);
+}
+
+const DistanceField2D::Config &DistanceField2D::config() const {
+    return m_config;
+}
+
+void DistanceField2D::build(const LineSegment2D *segments, size_t n) {
+    m_segments.assign(segments, segments + n);
+    if (m_occupied.empty()) {
+        return;
+    }
+    std::fill(m_occupied.begin(), m_occupied.end(), 0);
+    m_rasterizer.rasterize(segments, n, m_occupied.data());
+    compute(0, 0, m_config.width - 1, m_config.height - 1);
+}
+
+size_t DistanceField2D::update(const LineSegment2D *segments, size_t n) {
+    /// segments which are only in the old or only in the new map
+    std::vector<LineSegment2D> previous(m_segments), next(segments, segments + n), changed;
+    std::sort(previous.begin(), previous.end(), less);
+    std::sort(next.begin(), next.end(), less);
+    std::set_symmetric_difference(previous.begin(), previous.end(), next.begin(), next.end(), std::back_inserter(changed), less);
+    m_segments.assign(segments, segments + n);
+    if (changed.empty() || m_occupied.empty()) {
+        return 0;
+    }
+
+    /// cells of the changed segments with one cell margin for the rasterization
+    const tf2Scalar scale = 1.0 / m_config.resolution;
+    tf2Scalar x_min = std::numeric_limits<tf2Scalar>::max(), y_min = x_min, x_max = -x_min, y_max = -x_min;
+    Point2D p;
+    for (const LineSegment2D &s : changed) {
+        for (const Point2D &q : {s.p0(), s.p1()}) {
+            m_config.origin.transform_into_child(q, p);
+            x_min = std::min(x_min, p.x() * scale), x_max = std::max(x_max, p.x() * scale);
+            y_min = std::min(y_min, p.y() * scale), y_max = std::max(y_max, p.y() * scale);
+        }
+    }
+    const tf2Scalar w = m_config.width, h = m_config.height;
+    if (x_max < -1.0 || y_max < -1.0 || x_min > w || y_min > h) {
+        return 0;
+    }
+    const int64_t x0 = static_cast<int64_t>(std::max<tf2Scalar>(0.0, std::floor(x_min) - 1.0));
+    const int64_t y0 = static_cast<int64_t>(std::max<tf2Scalar>(0.0, std::floor(y_min) - 1.0));
+    const int64_t x1 = static_cast<int64_t>(std::min<tf2Scalar>(w - 1.0, std::floor(x_max) + 1.0));
+    const int64_t y1 = static_cast<int64_t>(std::min<tf2Scalar>(h - 1.0, std::floor(y_max) + 1.0));
+    for (int64_t y = y0; y <= y1; y++) {
+        std::fill(m_occupied.begin() + y * m_config.width + x0, m_occupied.begin() + y * m_config.width + x1 + 1, 0);
+    }
+    m_rasterizer.rasterize(segments, n, m_occupied.data(), x0, y0, x1, y1);
+
+    /// distances change only within max_distance of the redrawn cells
+    const int64_t margin = margin_cells(m_config.max_distance, m_config.resolution, m_config.width, m_config.height);
+    const int64_t rx0 = std::max<int64_t>(0, x0 - margin), ry0 = std::max<int64_t>(0, y0 - margin);
+    const int64_t rx1 = std::min<int64_t>(m_config.width - 1, x1 + margin), ry1 = std::min<int64_t>(m_config.height - 1, y1 + margin);
+    compute(rx0, ry0, rx1, ry1);
+    return static_cast<size_t>((rx1 - rx0 + 1) * (ry1 - ry0 + 1));
+}
+
+void DistanceField2D::compute(int64_t x0, int64_t y0, int64_t x1, int64_t y1) {
+    const int64_t w = m_config.width;
+    const tf2Scalar max_distance = m_config.max_distance, resolution = m_config.resolution;
+    /// occupied cells further away than max_distance do not change the truncated distances of the window
+    const int64_t margin = margin_cells(max_distance, resolution, m_config.width, m_config.height);
+    const int64_t sx0 = std::max<int64_t>(0, x0 - margin), sy0 = std::max<int64_t>(0, y0 - margin);
+    const int64_t sx1 = std::min<int64_t>(w - 1, x1 + margin), sy1 = std::min<int64_t>(m_config.height - 1, y1 + margin);
+    const size_t sw = static_cast<size_t>(sx1 - sx0 + 1), sh = static_cast<size_t>(sy1 - sy0 + 1);
+    m_sq.resize(sw * sh);
+
+    /// columns of the seed window
+    for (size_t c = 0; c < sw; c++) {
+        for (size_t r = 0; r < sh; r++) {
+            m_f[r] = m_occupied[(sy0 + r) * w + sx0 + c] ? 0.0 : kFar;
+        }
+        transform_1d(sh);
+        for (size_t r = 0; r < sh; r++) {
+            m_sq[r * sw + c] = static_cast<float>(m_d[r]);
+        }
+    }
+
+    /// rows of the target window
+    std::vector<float> &distances = m_levels[0];
+    const tf2Scalar two_sigma2 = 2.0 * m_config.sigma * m_config.sigma;
+    for (int64_t y = y0; y <= y1; y++) {
+        const float *row = m_sq.data() + (y - sy0) * sw;
+        for (size_t c = 0; c < sw; c++) {
+            m_f[c] = row[c];
+        }
+        transform_1d(sw);
+        for (int64_t x = x0; x <= x1; x++) {
+            const tf2Scalar d = std::min(max_distance, std::sqrt(m_d[x - sx0]) * resolution);
+            distances[y * w + x] = static_cast<float>(d);
+            if (!m_likelihood.empty()) {
+                m_likelihood[y * w + x] = static_cast<float>(std::exp(-d * d / two_sigma2));
+            }
+        }
+    }
+
+    /// coarser levels hold the minimum of the 2 x 2 cells below
+    for (size_t k = 1; k < m_levels.size(); k++) {
+        const int64_t w_fine = width(k - 1), h_fine = height(k - 1), w_k = width(k);
+        x0 >>= 1, y0 >>= 1, x1 >>= 1, y1 >>= 1;
+        for (int64_t y = y0; y <= y1; y++) {
+            for (int64_t x = x0; x <= x1; x++) {
+                float d = static_cast<float>(max_distance);
+                for (int64_t fy = 2 * y; fy <= std::min(2 * y + 1, h_fine - 1); fy++) {
+                    for (int64_t fx = 2 * x; fx <= std::min(2 * x + 1, w_fine - 1); fx++) {
+                        d = std::min(d, m_levels[k - 1][fy * w_fine + fx]);
+                    }
+                }
+                m_levels[k][y * w_k + x] = d;
+            }
+        }
+    }
+}
+
+void DistanceField2D::transform_1d(size_t n) {
+    const tf2Scalar infinity = std::numeric_limits<tf2Scalar>::infinity();
+    const tf2Scalar *f = m_f.data();
+    int64_t *v = m_v.data();
+    tf2Scalar *z = m_z.data();
+    /// lower envelope of the parabolas rooted at p with height f[p], z[k] is where parabola k starts
+    size_t k = 0;
+    v[0] = 0, z[0] = -infinity, z[1] = infinity;
+    for (size_t q = 1; q < n; q++) {
+        const int64_t iq = static_cast<int64_t>(q);
+        const tf2Scalar fq = f[q] + static_cast<tf2Scalar>(iq * iq);
+        tf2Scalar s = (fq - (f[v[k]] + static_cast<tf2Scalar>(v[k] * v[k]))) / static_cast<tf2Scalar>(2 * (iq - v[k]));
+        while (s <= z[k]) {
+            k--;
+            s = (fq - (f[v[k]] + static_cast<tf2Scalar>(v[k] * v[k]))) / static_cast<tf2Scalar>(2 * (iq - v[k]));
+        }
+        k++;
+        v[k] = iq, z[k] = s, z[k + 1] = infinity;
+    }
+    k = 0;
+    for (size_t q = 0; q < n; q++) {
+        while (z[k + 1] < static_cast<tf2Scalar>(q)) {
+            k++;
+        }
+        const tf2Scalar dq = static_cast<tf2Scalar>(static_cast<int64_t>(q) - v[k]);
+        m_d[q] = dq * dq + f[v[k]];
+    }
+}
+
+bool DistanceField2D::cell(const Point2D &p, int64_t &x, int64_t &y) const {
+    Point2D q;
+    m_config.origin.transform_into_child(p, q);
+    const tf2Scalar cx = std::floor(q.x() / m_config.resolution), cy = std::floor(q.y() / m_config.resolution);
+    if (!(cx >= 0.0 && cy >= 0.0 && cx < m_config.width && cy < m_config.height)) {
+        return false;
+    }
+    x = static_cast<int64_t>(cx), y = static_cast<int64_t>(cy);
+    return true;
+}
+
+tf2Scalar DistanceField2D::distance(const Point2D &p) const {
+    int64_t x, y;
+    if (!cell(p, x, y)) {
+        return m_config.max_distance;
+    }
+    return m_levels[0][y * m_config.width + x];
+}
+
+tf2Scalar DistanceField2D::likelihood(const Point2D &p) const {
+    /// without sigma > 0 there is no table and no Gaussian
+    if (m_likelihood.empty()) {
+        return 0.0;
+    }
+    int64_t x, y;
+    if (!cell(p, x, y)) {
+        const tf2Scalar d = m_config.max_distance;
+        return std::exp(-d * d / (2.0 * m_config.sigma * m_config.sigma));
+    }
+    return m_likelihood[y * m_config.width + x];
+}
+
+void DistanceField2D::distances(const Point2D *points, size_t n, tf2Scalar *des) const {
+    for (size_t i = 0; i < n; i++) {
+        des[i] = distance(points[i]);
+    }
+}
+
+tf2Scalar DistanceField2D::score(const Point2D *points, size_t n) const {
+    if (m_likelihood.empty()) {
+        return 0.0;
+    }
+    tf2Scalar sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        sum += likelihood(points[i]);
+    }
+    return sum;
+}
+
+uint32_t DistanceField2D::width(size_t level) const {
+    return static_cast<uint32_t>((static_cast<uint64_t>(m_config.width) + (1ull << level) - 1) >> level);
+}
+
+uint32_t DistanceField2D::height(size_t level) const {
+    return static_cast<uint32_t>((static_cast<uint64_t>(m_config.height) + (1ull << level) - 1) >> level);
+}
+
+const std::vector<float> &DistanceField2D::distances(size_t level) const {
+    return m_levels[level];
+}
+
+const std::vector<float> &DistanceField2D::likelihoods() const {
+    return m_likelihood;
+}
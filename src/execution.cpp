@@ -0,0 +1,237 @@
+#include "tf2_geometry/execution.hpp"
+#include <algorithm>
+#if defined(TF2_GEOMETRY_ENABLE_STD_EXECUTION)
+#include <execution>
+#include <numeric>
+#endif
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace tf2;
+
+namespace {
+/// chunks per worker if the chunk size is chosen automatically
+constexpr size_t kChunksPerWorker = 4;
+
+/// pool running a task on the current thread, used to run nested calls inline
+thread_local const ThreadPool *t_current_pool = nullptr;
+
+size_t hardware_concurrency() {
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+size_t auto_chunk_size(size_t n, size_t workers) {
+    return std::max<size_t>(1, (n + kChunksPerWorker * workers - 1) / (kChunksPerWorker * workers));
+}
+
+void pin(std::thread &thread, int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &set);
+#else
+    (void)thread, (void)cpu;
+#endif
+}
+}  // namespace
+
+ThreadPool::ThreadPool() : ThreadPool(Config()) {}
+
+ThreadPool::ThreadPool(const Config &config) : m_config(config) {
+    if (m_config.num_threads == 0) {
+        m_config.num_threads = hardware_concurrency();
+    }
+    m_shares.reset(new Share[m_config.num_threads]);
+    m_threads.reserve(m_config.num_threads - 1);
+    for (size_t k = 1; k < m_config.num_threads; k++) {
+        m_threads.emplace_back([this, k]() { run(k); });
+        if (!m_config.cpus.empty()) {
+            pin(m_threads.back(), m_config.cpus[k % m_config.cpus.size()]);
+        }
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_start.notify_all();
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+}
+
+const ThreadPool::Config &ThreadPool::config() const {
+    return m_config;
+}
+
+size_t ThreadPool::size() const {
+    return m_config.num_threads;
+}
+
+ThreadPool &ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::parallel_for(size_t n, size_t chunk_size, const std::function<void(size_t, size_t)> &fn) {
+    if (n == 0) {
+        return;
+    }
+    if (chunk_size == 0) {
+        chunk_size = m_config.chunk_size > 0 ? m_config.chunk_size : auto_chunk_size(n, size());
+    }
+    const size_t chunks = (n + chunk_size - 1) / chunk_size;
+    if (size() == 1 || chunks == 1 || t_current_pool == this) {
+        for (size_t begin = 0; begin < n; begin += chunk_size) {
+            fn(begin, std::min(n, begin + chunk_size));
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> call(m_call);
+    /// every worker owns a contiguous share of the chunks
+    const size_t workers = size();
+    for (size_t k = 0; k < workers; k++) {
+        m_shares[k].next.store(chunks * k / workers, std::memory_order_relaxed);
+        m_shares[k].end = chunks * (k + 1) / workers;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fn = &fn, m_n = n, m_chunk = chunk_size;
+        m_exception = nullptr;
+        m_active = workers;
+        m_generation++;
+    }
+    m_start.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this]() { return m_active == 0; });
+    m_fn = nullptr;
+    if (m_exception) {
+        std::rethrow_exception(m_exception);
+    }
+}
+
+void ThreadPool::run(size_t worker) {
+    uint64_t generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [this, generation]() { return m_stop || m_generation != generation; });
+            if (m_stop) {
+                return;
+            }
+            generation = m_generation;
+        }
+        work(worker);
+    }
+}
+
+void ThreadPool::work(size_t worker) {
+    const ThreadPool *previous = t_current_pool;
+    t_current_pool = this;
+    const size_t workers = size();
+    /// own share first, then steals from the following workers
+    for (size_t i = 0; i < workers; i++) {
+        Share &share = m_shares[(worker + i) % workers];
+        for (size_t c = share.next.fetch_add(1, std::memory_order_relaxed); c < share.end;
+             c = share.next.fetch_add(1, std::memory_order_relaxed)) {
+            const size_t begin = c * m_chunk;
+            try {
+                (*m_fn)(begin, std::min(m_n, begin + m_chunk));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_exception) {
+                    m_exception = std::current_exception();
+                }
+            }
+        }
+    }
+    t_current_pool = previous;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--m_active == 0) {
+        m_done.notify_one();
+    }
+}
+
+ExecutionPolicy::ExecutionPolicy() : m_kind(kSequential), m_pool(nullptr), m_chunk_size(0) {}
+
+ExecutionPolicy ExecutionPolicy::sequential() {
+    return ExecutionPolicy();
+}
+
+ExecutionPolicy ExecutionPolicy::parallel_unsequenced(size_t chunk_size) {
+    ExecutionPolicy policy;
+    policy.m_kind = kParallelUnsequenced;
+    policy.m_chunk_size = chunk_size;
+    return policy;
+}
+
+ExecutionPolicy ExecutionPolicy::thread_pool(ThreadPool &pool, size_t chunk_size) {
+    ExecutionPolicy policy;
+    policy.m_kind = kThreadPool;
+    policy.m_pool = &pool;
+    policy.m_chunk_size = chunk_size;
+    return policy;
+}
+
+ExecutionPolicy::Kind ExecutionPolicy::kind() const {
+    return m_kind;
+}
+
+size_t ExecutionPolicy::concurrency() const {
+    switch (m_kind) {
+    case kParallelUnsequenced:
+        return hardware_concurrency();
+    case kThreadPool:
+        return m_pool->size();
+    default:
+        return 1;
+    }
+}
+
+void ExecutionPolicy::for_each(size_t n, const std::function<void(size_t, size_t)> &fn) const {
+    for_each(n, m_chunk_size, fn);
+}
+
+void ExecutionPolicy::for_each(size_t n, size_t chunk_size, const std::function<void(size_t, size_t)> &fn) const {
+    if (n == 0) {
+        return;
+    }
+    switch (m_kind) {
+    case kThreadPool:
+        m_pool->parallel_for(n, chunk_size, fn);
+        return;
+    case kParallelUnsequenced: {
+#if defined(TF2_GEOMETRY_ENABLE_STD_EXECUTION)
+        if (chunk_size == 0) {
+            chunk_size = auto_chunk_size(n, hardware_concurrency());
+        }
+        std::vector<size_t> chunks((n + chunk_size - 1) / chunk_size);
+        std::iota(chunks.begin(), chunks.end(), size_t(0));
+        std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](size_t c) {
+            fn(c * chunk_size, std::min(n, (c + 1) * chunk_size));
+        });
+#else
+        ThreadPool::shared().parallel_for(n, chunk_size, fn);
+#endif
+        return;
+    }
+    default:
+        if (chunk_size == 0) {
+            fn(0, n);
+        } else {
+            for (size_t begin = 0; begin < n; begin += chunk_size) {
+                fn(begin, std::min(n, begin + chunk_size));
+            }
+        }
+        return;
+    }
+}
@@ -0,0 +1,226 @@
+#include "tf2_geometry/hough2d.hpp"
+#include "tf2_geometry/instrumentation.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace tf2;
+
+namespace {
+/// upper limit for the points buffered per block on the stack
+constexpr size_t kMaxBlockSize = 1024;
+/// upper limit for the rho cells on each side of the origin, bounds the accumulator size
+constexpr size_t kMaxRhoOffset = 1 << 15;
+}  // namespace
+
+HoughLines2D::HoughLines2D() {
+    configure(Config());
+}
+
+HoughLines2D::HoughLines2D(const Config &config) {
+    configure(config);
+}
+
+HoughLines2D::HoughLines2D(const Config &config, std::pmr::memory_resource *resource)
+    : m_cos(resource), m_sin(resource), m_points_x(resource), m_points_y(resource), m_accumulator(resource),
+      m_partial(resource), m_peaks(resource) {
+    configure(config);
+}
+
+void HoughLines2D::configure(const Config &config) {
+    m_config = config;
+    m_config.theta_bins = std::max<size_t>(1, m_config.theta_bins);
+    if (!(m_config.rho_resolution > 0.0)) {
+        m_config.rho_resolution = Config().rho_resolution;
+    }
+    if (!std::isfinite(m_config.rho_max)) {
+        m_config.rho_max = Config().rho_max;
+    }
+    m_config.rho_max = std::max<tf2Scalar>(0.0, m_config.rho_max);
+    /// too many rho cells coarsen the resolution instead of allocating gigabytes
+    if (m_config.rho_max / m_config.rho_resolution > kMaxRhoOffset) {
+        m_config.rho_resolution = m_config.rho_max / kMaxRhoOffset;
+    }
+    m_config.num_threads = std::max<size_t>(1, m_config.num_threads);
+    m_config.block_size = std::clamp<size_t>(m_config.block_size, 1, kMaxBlockSize);
+    m_rho_offset = static_cast<size_t>(std::ceil(m_config.rho_max / m_config.rho_resolution));
+    m_rho_bins = 2 * m_rho_offset + 1;
+    m_tile_rows = std::clamp<size_t>(m_config.tile_bytes / (m_rho_bins * sizeof(uint32_t)), 1, m_config.theta_bins);
+
+    m_cos.resize(m_config.theta_bins);
+    m_sin.resize(m_config.theta_bins);
+    for (size_t t = 0; t < m_config.theta_bins; t++) {
+        m_cos[t] = tf2Cos(theta(t)) / m_config.rho_resolution;
+        m_sin[t] = tf2Sin(theta(t)) / m_config.rho_resolution;
+    }
+    m_accumulator.assign(m_config.theta_bins * m_rho_bins, 0);
+    m_partial.resize(m_config.num_threads - 1);
+    for (auto &partial : m_partial) {
+        partial.assign(m_accumulator.size(), 0);
+    }
+    m_points_x.reserve(4096);
+    m_points_y.reserve(4096);
+    m_peaks.reserve(m_config.max_lines);
+}
+
+const HoughLines2D::Config &HoughLines2D::config() const {
+    return m_config;
+}
+
+void HoughLines2D::set_execution_policy(const ExecutionPolicy &policy) {
+    m_execution = policy;
+}
+
+size_t HoughLines2D::detect(const Point2D *points, size_t n, Line2D *des, size_t capacity) {
+    TF2_GEOMETRY_KERNEL(kHoughLines2DDetect, n);
+    /// converts the points into a structure of arrays and drops the ones out of range
+    const tf2Scalar r2 = m_config.rho_max * m_config.rho_max;
+    m_points_x.clear(), m_points_y.clear();
+    for (size_t i = 0; i < n; i++) {
+        const tf2Scalar &x = points[i].x(), &y = points[i].y();
+        if (x * x + y * y <= r2) {
+            m_points_x.push_back(x), m_points_y.push_back(y);
+        }
+    }
+    const size_t m = m_points_x.size();
+
+    std::fill(m_accumulator.begin(), m_accumulator.end(), 0);
+    const size_t num_tasks = std::min(m_config.num_threads, std::max<size_t>(1, m / m_config.block_size));
+    if (num_tasks == 1) {
+        vote(m_points_x.data(), m_points_y.data(), m, m_accumulator.data());
+    } else {
+        /// every task votes into its own partial accumulator to avoid write contention
+        const size_t chunk = (m + num_tasks - 1) / num_tasks;
+        const ExecutionPolicy policy = m_execution ? *m_execution : ExecutionPolicy::thread_pool(ThreadPool::shared());
+        policy.for_each(m, chunk, [this, chunk](size_t begin, size_t end) {
+            const size_t k = begin / chunk;
+            uint32_t *partial = k == 0 ? m_accumulator.data() : m_partial[k - 1].data();
+            if (k > 0) {
+                std::fill(partial, partial + m_accumulator.size(), 0);
+            }
+            vote(m_points_x.data() + begin, m_points_y.data() + begin, end - begin, partial);
+        });
+        const size_t num_chunks = (m + chunk - 1) / chunk;
+        for (size_t k = 1; k < num_chunks; k++) {
+            const uint32_t *partial = m_partial[k - 1].data();
+            uint32_t *accumulator = m_accumulator.data();
+            for (size_t i = 0; i < m_accumulator.size(); i++) {
+                accumulator[i] += partial[i];
+            }
+        }
+    }
+
+    suppress_non_maxima();
+
+    const size_t count = std::min(capacity, m_peaks.size());
+    for (size_t i = 0; i < count; i++) {
+        line(m_peaks[i].theta_idx, m_peaks[i].rho_idx, des[i]);
+    }
+    return count;
+}
+
+void HoughLines2D::vote(const tf2Scalar *xs, const tf2Scalar *ys, size_t n, uint32_t *accumulator) const {
+    int32_t idx[kMaxBlockSize];
+    const tf2Scalar offset = static_cast<tf2Scalar>(m_rho_offset) + 0.5;
+    const size_t block_size = m_config.block_size;
+    /// a tile of theta rows stays in cache while all points vote into it
+    for (size_t t0 = 0; t0 < m_config.theta_bins; t0 += m_tile_rows) {
+        const size_t t1 = std::min(m_config.theta_bins, t0 + m_tile_rows);
+        for (size_t i0 = 0; i0 < n; i0 += block_size) {
+            const size_t m = std::min(block_size, n - i0);
+            const tf2Scalar *x = xs + i0, *y = ys + i0;
+            for (size_t t = t0; t < t1; t++) {
+                const tf2Scalar c = m_cos[t], s = m_sin[t];
+                for (size_t k = 0; k < m; k++) {
+                    idx[k] = static_cast<int32_t>(x[k] * c + y[k] * s + offset);
+                }
+                uint32_t *row = accumulator + t * m_rho_bins;
+                for (size_t k = 0; k < m; k++) {
+                    row[idx[k]]++;
+                }
+            }
+        }
+    }
+}
+
+void HoughLines2D::suppress_non_maxima() {
+    const long T = static_cast<long>(m_config.theta_bins);
+    const long R = static_cast<long>(m_rho_bins);
+    const long wt = static_cast<long>(m_config.nms_theta);
+    const long wr = static_cast<long>(m_config.nms_rho);
+    const uint32_t *acc = m_accumulator.data();
+    m_peaks.clear();
+    for (long t = 0; t < T; t++) {
+        for (long r = 0; r < R; r++) {
+            const uint32_t v = acc[t * R + r];
+            if (v < m_config.threshold || v == 0) {
+                continue;
+            }
+            const long key = t * R + r;
+            bool is_max = true;
+            for (long dt = -wt; dt <= wt && is_max; dt++) {
+                long tn = t + dt;
+                bool mirrored = false;
+                /// theta wraps around at PI with a sign flip of rho
+                if (tn < 0) {
+                    tn += T, mirrored = true;
+                } else if (tn >= T) {
+                    tn -= T, mirrored = true;
+                }
+                for (long dr = -wr; dr <= wr; dr++) {
+                    long rn = r + dr;
+                    if (rn < 0 || rn >= R) {
+                        continue;
+                    }
+                    if (mirrored) {
+                        rn = R - 1 - rn;
+                    }
+                    const long key_n = tn * R + rn;
+                    const uint32_t vn = acc[key_n];
+                    if (vn > v || (vn == v && key_n < key)) {
+                        is_max = false;
+                        break;
+                    }
+                }
+            }
+            if (is_max) {
+                m_peaks.push_back(Peak{static_cast<size_t>(t), static_cast<size_t>(r), v});
+            }
+        }
+    }
+    std::sort(m_peaks.begin(), m_peaks.end(), [](const Peak &a, const Peak &b) {
+        return a.votes > b.votes || (a.votes == b.votes && (a.theta_idx < b.theta_idx || (a.theta_idx == b.theta_idx && a.rho_idx < b.rho_idx)));
+    });
+    if (m_peaks.size() > m_config.max_lines) {
+        m_peaks.resize(m_config.max_lines);
+    }
+}
+
+const std::pmr::vector<HoughLines2D::Peak> &HoughLines2D::peaks() const {
+    return m_peaks;
+}
+
+const std::pmr::vector<uint32_t> &HoughLines2D::accumulator() const {
+    return m_accumulator;
+}
+
+size_t HoughLines2D::theta_bins() const {
+    return m_config.theta_bins;
+}
+
+size_t HoughLines2D::rho_bins() const {
+    return m_rho_bins;
+}
+
+tf2Scalar HoughLines2D::theta(size_t theta_idx) const {
+    return static_cast<tf2Scalar>(theta_idx) * M_PI / static_cast<tf2Scalar>(m_config.theta_bins);
+}
+
+tf2Scalar HoughLines2D::rho(size_t rho_idx) const {
+    return (static_cast<tf2Scalar>(rho_idx) - static_cast<tf2Scalar>(m_rho_offset)) * m_config.rho_resolution;
+}
+
+Line2D &HoughLines2D::line(size_t theta_idx, size_t rho_idx, Line2D &des) const {
+    const tf2Scalar alpha = theta(theta_idx);
+    des.a() = tf2Cos(alpha), des.b() = tf2Sin(alpha), des.c() = -rho(rho_idx);
+    return des;
+}
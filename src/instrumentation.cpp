@@ -0,0 +1,139 @@
+#include "tf2_geometry/instrumentation.hpp"
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+using namespace tf2;
+using namespace tf2::instrumentation;
+
+namespace {
+
+/**
+ * counters of one thread, only the owning thread writes them so an update
+ * is a relaxed load and store without a locked instruction
+ **/
+struct Counters {
+    std::atomic<uint64_t> counters[kCounterCount];
+    std::atomic<uint64_t> calls[kKernelCount];
+    std::atomic<uint64_t> elements[kKernelCount];
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<Counters *> threads;  /// counters of the running threads
+    Snapshot retired{};               /// sums of the exited threads
+};
+
+Registry &registry() {
+    static Registry *r = new Registry();  /// never destroyed, threads may exit after static destruction
+    return *r;
+}
+
+std::atomic<TraceCallback> g_trace_callback{nullptr};
+
+void add(std::atomic<uint64_t> &c, uint64_t n) {
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+struct ThreadCounters {
+    Counters counters{};
+    ThreadCounters() {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.threads.push_back(&counters);
+    }
+    ~ThreadCounters() {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (size_t i = 0; i < kCounterCount; i++) r.retired.counters[i] += counters.counters[i].load(std::memory_order_relaxed);
+        for (size_t i = 0; i < kKernelCount; i++) {
+            r.retired.calls[i] += counters.calls[i].load(std::memory_order_relaxed);
+            r.retired.elements[i] += counters.elements[i].load(std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < r.threads.size(); i++) {
+            if (r.threads[i] == &counters) {
+                r.threads[i] = r.threads.back();
+                r.threads.pop_back();
+                break;
+            }
+        }
+    }
+};
+
+Counters &local() {
+    thread_local ThreadCounters t;
+    return t.counters;
+}
+
+const char *kCounterNames[kCounterCount] = {
+    "transform2d_cache_hit", "transform2d_cache_recompute", "transform2d_cache_invalidate", "transform2d_copy"};
+
+const char *kKernelNames[kKernelCount] = {
+    "plane3d_distances", "plane3d_classify", "plane3d_array_contains", "hough_lines2d_detect", "ransac_plane3d_estimate",
+    "moments3d_add", "pixel_ray_table_project", "map2d_to_map", "map2d_to_world", "segment_rasterizer2d_rasterize", "scan_matcher2d_match",
+    "correlative_scan_matcher2d_match", "particle_set2d_move", "compose_prefix", "convex_hull2d_compute",
+    "aabb2d_extend", "obb2d_intersects"};
+
+}  // namespace
+
+bool instrumentation::enabled() {
+#if defined(TF2_GEOMETRY_ENABLE_COUNTERS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+Snapshot &instrumentation::snapshot(Snapshot &des) {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    des = r.retired;
+    for (const Counters *c : r.threads) {
+        for (size_t i = 0; i < kCounterCount; i++) des.counters[i] += c->counters[i].load(std::memory_order_relaxed);
+        for (size_t i = 0; i < kKernelCount; i++) {
+            des.calls[i] += c->calls[i].load(std::memory_order_relaxed);
+            des.elements[i] += c->elements[i].load(std::memory_order_relaxed);
+        }
+    }
+    return des;
+}
+
+void instrumentation::reset() {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.retired = Snapshot{};
+    /// a concurrent update of another thread may survive the reset
+    for (Counters *c : r.threads) {
+        for (size_t i = 0; i < kCounterCount; i++) c->counters[i].store(0, std::memory_order_relaxed);
+        for (size_t i = 0; i < kKernelCount; i++) {
+            c->calls[i].store(0, std::memory_order_relaxed);
+            c->elements[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+const char *instrumentation::name(Counter counter) {
+    return counter < kCounterCount ? kCounterNames[counter] : "";
+}
+
+const char *instrumentation::name(Kernel kernel) {
+    return kernel < kKernelCount ? kKernelNames[kernel] : "";
+}
+
+void instrumentation::set_trace_callback(TraceCallback callback) {
+    g_trace_callback.store(callback, std::memory_order_release);
+}
+
+TraceCallback instrumentation::trace_callback() {
+    return g_trace_callback.load(std::memory_order_acquire);
+}
+
+void instrumentation::count(Counter counter, uint64_t n) {
+    add(local().counters[counter], n);
+}
+
+void instrumentation::count(Kernel kernel, uint64_t elements) {
+    Counters &c = local();
+    add(c.calls[kernel], 1);
+    add(c.elements[kernel], elements);
+}
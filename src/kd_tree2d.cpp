@@ -0,0 +1,205 @@
+#include "tf2_geometry/kd_tree2d.hpp"
+#include "tf2_geometry/execution.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+using namespace tf2;
+
+constexpr size_t KdTree2D::npos;
+
+KdTree2D::KdTree2D() : m_leaf_size(8) {}
+
+void KdTree2D::build(const Point2D *points, size_t n, size_t leaf_size) {
+    build(ExecutionPolicy::sequential(), points, n, leaf_size);
+}
+
+void KdTree2D::build(const ExecutionPolicy &policy, const Point2D *points, size_t n, size_t leaf_size) {
+    m_leaf_size = std::max<size_t>(1, leaf_size);
+    /// non-finite points, e.g. invalid laser returns, break the ordering of the median split and are skipped
+    m_items.clear();
+    m_items.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        if (std::isfinite(points[i].x()) && std::isfinite(points[i].y())) {
+            m_items.push_back(Item{points[i].x(), points[i].y(), i});
+        }
+    }
+    n = m_items.size();
+    /// the larger half has ceil(n / 2) points, so depth levels of inner nodes are enough
+    size_t depth = 0;
+    for (size_t count = n; count > m_leaf_size; count -= count / 2) {
+        depth++;
+    }
+    m_nodes.assign(depth > 0 ? (size_t(1) << depth) - 1 : 0, Node{0.0, 0});
+
+    /// the nodes of a level cover disjoint ranges and are split independently
+    struct Range {
+        size_t node, begin, end;
+    };
+    std::vector<Range> level, next;
+    if (n > m_leaf_size) {
+        level.push_back(Range{0, 0, n});
+    }
+    while (!level.empty()) {
+        policy.for_each(level.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                split(level[i].node, level[i].begin, level[i].end);
+            }
+        });
+        next.clear();
+        for (const Range &r : level) {
+            const size_t mid = r.begin + (r.end - r.begin) / 2;
+            if (mid - r.begin > m_leaf_size) {
+                next.push_back(Range{2 * r.node + 1, r.begin, mid});
+            }
+            if (r.end - mid > m_leaf_size) {
+                next.push_back(Range{2 * r.node + 2, mid, r.end});
+            }
+        }
+        level.swap(next);
+    }
+}
+
+void KdTree2D::split(size_t node, size_t begin, size_t end) {
+    tf2Scalar x_min = m_items[begin].x, x_max = x_min, y_min = m_items[begin].y, y_max = y_min;
+    for (size_t i = begin + 1; i < end; i++) {
+        x_min = std::min(x_min, m_items[i].x), x_max = std::max(x_max, m_items[i].x);
+        y_min = std::min(y_min, m_items[i].y), y_max = std::max(y_max, m_items[i].y);
+    }
+    const uint32_t axis = (y_max - y_min) > (x_max - x_min) ? 1 : 0;
+    const size_t mid = begin + (end - begin) / 2;
+    Item *items = m_items.data();
+    if (axis == 0) {
+        std::nth_element(items + begin, items + mid, items + end, [](const Item &a, const Item &b) { return a.x < b.x; });
+    } else {
+        std::nth_element(items + begin, items + mid, items + end, [](const Item &a, const Item &b) { return a.y < b.y; });
+    }
+    m_nodes[node] = Node{axis == 0 ? items[mid].x : items[mid].y, axis};
+}
+
+size_t KdTree2D::size() const {
+    return m_items.size();
+}
+
+size_t KdTree2D::leaf_size() const {
+    return m_leaf_size;
+}
+
+size_t KdTree2D::nearest(const Point2D &p, tf2Scalar max_distance_sqrt, tf2Scalar *distance_sqrt) const {
+    return approximate_nearest(p, 0.0, max_distance_sqrt, distance_sqrt);
+}
+
+size_t KdTree2D::approximate_nearest(const Point2D &p, tf2Scalar epsilon, tf2Scalar max_distance_sqrt,
+                                     tf2Scalar *distance_sqrt) const {
+    size_t best = npos;
+    tf2Scalar best_sqrt = max_distance_sqrt;
+    nearest(0, 0, m_items.size(), p.x(), p.y(), (1.0 + epsilon) * (1.0 + epsilon), best, best_sqrt);
+    if (distance_sqrt) {
+        *distance_sqrt = best == npos ? std::numeric_limits<tf2Scalar>::infinity() : best_sqrt;
+    }
+    return best;
+}
+
+void KdTree2D::nearest(size_t node, size_t begin, size_t end, tf2Scalar x, tf2Scalar y, tf2Scalar scale, size_t &best,
+                       tf2Scalar &best_sqrt) const {
+    if (end - begin <= m_leaf_size) {
+        for (size_t i = begin; i < end; i++) {
+            const tf2Scalar dx = m_items[i].x - x, dy = m_items[i].y - y, d = dx * dx + dy * dy;
+            if (d < best_sqrt) {
+                best = m_items[i].index, best_sqrt = d;
+            }
+        }
+        return;
+    }
+    const Node &n = m_nodes[node];
+    const size_t mid = begin + (end - begin) / 2;
+    const tf2Scalar diff = (n.axis == 0 ? x : y) - n.split;
+    if (diff < 0.0) {
+        nearest(2 * node + 1, begin, mid, x, y, scale, best, best_sqrt);
+        if (diff * diff * scale < best_sqrt) {
+            nearest(2 * node + 2, mid, end, x, y, scale, best, best_sqrt);
+        }
+    } else {
+        nearest(2 * node + 2, mid, end, x, y, scale, best, best_sqrt);
+        if (diff * diff * scale < best_sqrt) {
+            nearest(2 * node + 1, begin, mid, x, y, scale, best, best_sqrt);
+        }
+    }
+}
+
+size_t KdTree2D::knn(const Point2D &p, size_t k, size_t *indices, tf2Scalar *distances_sqrt, tf2Scalar max_distance_sqrt) const {
+    size_t count = 0;
+    if (k > 0) {
+        knn(0, 0, m_items.size(), p.x(), p.y(), k, indices, distances_sqrt, count, max_distance_sqrt);
+    }
+    std::fill(indices + count, indices + k, npos);
+    std::fill(distances_sqrt + count, distances_sqrt + k, std::numeric_limits<tf2Scalar>::infinity());
+    return count;
+}
+
+void KdTree2D::knn(size_t node, size_t begin, size_t end, tf2Scalar x, tf2Scalar y, size_t k, size_t *indices,
+                   tf2Scalar *distances_sqrt, size_t &count, tf2Scalar max_distance_sqrt) const {
+    if (end - begin <= m_leaf_size) {
+        for (size_t i = begin; i < end; i++) {
+            const tf2Scalar dx = m_items[i].x - x, dy = m_items[i].y - y, d = dx * dx + dy * dy;
+            const tf2Scalar bound = count < k ? max_distance_sqrt : distances_sqrt[k - 1];
+            if (d >= bound) {
+                continue;
+            }
+            /// insertion into the sorted neighbours, the last one drops out if k are found already
+            size_t j = count < k ? count++ : k - 1;
+            for (; j > 0 && distances_sqrt[j - 1] > d; j--) {
+                distances_sqrt[j] = distances_sqrt[j - 1], indices[j] = indices[j - 1];
+            }
+            distances_sqrt[j] = d, indices[j] = m_items[i].index;
+        }
+        return;
+    }
+    const Node &n = m_nodes[node];
+    const size_t mid = begin + (end - begin) / 2;
+    const tf2Scalar diff = (n.axis == 0 ? x : y) - n.split;
+    const size_t near = diff < 0.0 ? 2 * node + 1 : 2 * node + 2;
+    const size_t near_begin = diff < 0.0 ? begin : mid, near_end = diff < 0.0 ? mid : end;
+    knn(near, near_begin, near_end, x, y, k, indices, distances_sqrt, count, max_distance_sqrt);
+    const tf2Scalar bound = count < k ? max_distance_sqrt : distances_sqrt[k - 1];
+    if (diff * diff < bound) {
+        const size_t far = diff < 0.0 ? 2 * node + 2 : 2 * node + 1;
+        const size_t far_begin = diff < 0.0 ? mid : begin, far_end = diff < 0.0 ? end : mid;
+        knn(far, far_begin, far_end, x, y, k, indices, distances_sqrt, count, max_distance_sqrt);
+    }
+}
+
+size_t KdTree2D::nearest(const Point2D *points, size_t n, tf2Scalar max_distance_sqrt, size_t *indices,
+                         tf2Scalar *distances_sqrt) const {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        indices[i] = nearest(points[i], max_distance_sqrt, distances_sqrt ? distances_sqrt + i : nullptr);
+        count += indices[i] != npos;
+    }
+    return count;
+}
+
+size_t KdTree2D::nearest(const ExecutionPolicy &policy, const Point2D *points, size_t n, tf2Scalar max_distance_sqrt,
+                         size_t *indices, tf2Scalar *distances_sqrt) const {
+    std::atomic<size_t> count{0};
+    policy.for_each(n, [&](size_t begin, size_t end) {
+        const size_t c = nearest(points + begin, end - begin, max_distance_sqrt, indices + begin,
+                                 distances_sqrt ? distances_sqrt + begin : nullptr);
+        count.fetch_add(c, std::memory_order_relaxed);
+    });
+    return count.load();
+}
+
+void KdTree2D::knn(const Point2D *points, size_t n, size_t k, size_t *indices, tf2Scalar *distances_sqrt,
+                   tf2Scalar max_distance_sqrt) const {
+    for (size_t i = 0; i < n; i++) {
+        knn(points[i], k, indices + i * k, distances_sqrt + i * k, max_distance_sqrt);
+    }
+}
+
+void KdTree2D::knn(const ExecutionPolicy &policy, const Point2D *points, size_t n, size_t k, size_t *indices,
+                   tf2Scalar *distances_sqrt, tf2Scalar max_distance_sqrt) const {
+    policy.for_each(n, [&](size_t begin, size_t end) {
+        knn(points + begin, end - begin, k, indices + begin * k, distances_sqrt + begin * k, max_distance_sqrt);
+    });
+}
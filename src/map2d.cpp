@@ -1,16 +1,133 @@
-#include "tuw2_geometry/map2d.hpp"
+#include "tf2_geometry/map2d.hpp"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/instrumentation.hpp"
 #include <cmath>
 
-using namespace tuw2;
+using namespace tf2;
 
-Map2D::Map2D() : plane_(), origin_(Matrix3S::Identity()) {}
+Map2D::Map2D() : m_plane(0., 0., 1., 0.), m_plane_origin(0., 0., 0.), m_origin(0., 0., 0.) {
+    create(Vector3(0., 0., 0.), Vector3(0., 0., 1.));
+}
 
 void Map2D::create(const Vector3 &p, const Vector3 &n) {
-    plane_.create(p, n);
-    origin_ << 1.0, 0.0, p[0], 0.0, 1.0, p[1], 0.0, 0.0, 1.0;
+    const Vector3 normal = n.normalized();
+    /// uses the global y axis if the global x axis is almost normal to the plane
+    if (std::fabs(normal[0]) < 0.9) {
+        create(p, normal, Vector3(1., 0., 0.));
+    } else {
+        create(p, normal, Vector3(0., 1., 0.));
+    }
+}
+
+void Map2D::create(const Vector3 &p, const Vector3 &n, const Vector3 &x_axis) {
+    m_plane.create(Point3D(p[0], p[1], p[2]), n);
+    const Vector3 &normal = m_plane.head();
+    m_plane_origin = p;
+    Vector3 ex = x_axis - normal * normal.dot(x_axis);
+    /// an x axis (almost) parallel to the normal has no usable projection, fall back to the default axis
+    if (!(ex.length2() > 1e-12 * x_axis.length2())) {
+        ex = (std::fabs(normal[0]) < 0.9) ? Vector3(1., 0., 0.) : Vector3(0., 1., 0.);
+        ex -= normal * normal.dot(ex);
+    }
+    m_ex = ex.normalized();
+    m_ey = normal.cross(m_ex);
+    update();
+}
+
+void Map2D::set_origin(const Transform2D &origin) {
+    m_origin.set(origin);
+    update();
+}
+
+void Map2D::update() {
+    const tf2Scalar c = tf2Cos(m_origin.rotation()), s = tf2Sin(m_origin.rotation());
+    m_u = m_ex * c + m_ey * s;
+    m_v = m_ey * c - m_ex * s;
+    m_map_origin = m_plane_origin + m_ex * m_origin.x() + m_ey * m_origin.y();
+    m_u0 = -m_u.dot(m_map_origin);
+    m_v0 = -m_v.dot(m_map_origin);
+}
+
+const Transform2D &Map2D::origin() const {
+    return m_origin;
+}
+
+const Plane3D &Map2D::plane() const {
+    return m_plane;
+}
+
+Point2D &Map2D::to_map(const Point3D &src, Point2D &des) const {
+    des.set(m_u.dot(src) + m_u0, m_v.dot(src) + m_v0);
+    return des;
+}
+
+Point2D Map2D::to_map(const Point3D &src) const {
+    Point2D des;
+    return to_map(src, des);
 }
 
-Point2D tuw2::toMap(const Vector3 &p) {
-    Vector3 ph = map.origin_ * p;
-    return Point2D(ph[0] / ph[2], ph[1] / ph[2]);
-}
\ No newline at end of file
+Point3D &Map2D::to_world(const Point2D &src, Point3D &des) const {
+    des = m_map_origin + m_u * src.x() + m_v * src.y();
+    return des;
+}
+
+Point3D Map2D::to_world(const Point2D &src) const {
+    Point3D des;
+    return to_world(src, des);
+}
+
+void Map2D::to_map(const Point3D *src, size_t n, Point2D *des, tf2Scalar *heights) const {
+    TF2_GEOMETRY_KERNEL(kMap2DToMap, n);
+    to_map_range(src, n, des);
+    if (heights) {
+        m_plane.distances_to(src, n, heights);
+    }
+}
+
+void Map2D::to_world(const Point2D *src, size_t n, Point3D *des, const tf2Scalar *heights) const {
+    TF2_GEOMETRY_KERNEL(kMap2DToWorld, n);
+    to_world_range(src, n, des, heights);
+}
+
+void Map2D::to_map(const ExecutionPolicy &policy, const Point3D *src, size_t n, Point2D *des, tf2Scalar *heights) const {
+    TF2_GEOMETRY_KERNEL(kMap2DToMap, n);
+    policy.for_each(n, [&](size_t begin, size_t end) { to_map_range(src + begin, end - begin, des + begin); });
+    if (heights) {
+        m_plane.distances_to(policy, src, n, heights);
+    }
+}
+
+void Map2D::to_world(const ExecutionPolicy &policy, const Point2D *src, size_t n, Point3D *des, const tf2Scalar *heights) const {
+    TF2_GEOMETRY_KERNEL(kMap2DToWorld, n);
+    policy.for_each(n, [&](size_t begin, size_t end) {
+        to_world_range(src + begin, end - begin, des + begin, heights ? heights + begin : nullptr);
+    });
+}
+
+void Map2D::to_map_range(const Point3D *src, size_t n, Point2D *des) const {
+    const tf2Scalar ux = m_u[0], uy = m_u[1], uz = m_u[2];
+    const tf2Scalar vx = m_v[0], vy = m_v[1], vz = m_v[2];
+    for (size_t i = 0; i < n; i++) {
+        const tf2Scalar *p = src[i].m_floats;
+        des[i].m_floats[0] = ux * p[0] + uy * p[1] + uz * p[2] + m_u0;
+        des[i].m_floats[1] = vx * p[0] + vy * p[1] + vz * p[2] + m_v0;
+    }
+}
+
+void Map2D::to_world_range(const Point2D *src, size_t n, Point3D *des, const tf2Scalar *heights) const {
+    const tf2Scalar ux = m_u[0], uy = m_u[1], uz = m_u[2];
+    const tf2Scalar vx = m_v[0], vy = m_v[1], vz = m_v[2];
+    const tf2Scalar ox = m_map_origin[0], oy = m_map_origin[1], oz = m_map_origin[2];
+    for (size_t i = 0; i < n; i++) {
+        const tf2Scalar x = src[i].m_floats[0], y = src[i].m_floats[1];
+        tf2Scalar *p = des[i].m_floats;
+        p[0] = ox + ux * x + vx * y, p[1] = oy + uy * x + vy * y, p[2] = oz + uz * x + vz * y;
+    }
+    if (heights) {
+        const tf2Scalar nx = m_plane.a(), ny = m_plane.b(), nz = m_plane.c();
+        for (size_t i = 0; i < n; i++) {
+            tf2Scalar *p = des[i].m_floats;
+            p[0] += nx * heights[i], p[1] += ny * heights[i], p[2] += nz * heights[i];
+        }
+    }
+}
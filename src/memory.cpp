@@ -0,0 +1,58 @@
+#include "tf2_geometry/memory.hpp"
+#include <algorithm>
+#include <cstdint>
+
+using namespace tf2;
+
+MonotonicArena::MonotonicArena(size_t capacity, std::pmr::memory_resource *upstream)
+    : m_buffer(new std::byte[capacity]), m_capacity(capacity), m_used(0), m_overflow(0), m_peak(0), m_upstream(upstream) {}
+
+void MonotonicArena::reset() {
+    m_used = 0;
+    m_overflow = 0;
+}
+
+size_t MonotonicArena::capacity() const {
+    return m_capacity;
+}
+
+size_t MonotonicArena::used() const {
+    return m_used;
+}
+
+size_t MonotonicArena::peak() const {
+    return m_peak;
+}
+
+size_t MonotonicArena::overflow() const {
+    return m_overflow;
+}
+
+void *MonotonicArena::do_allocate(size_t bytes, size_t alignment) {
+    const uintptr_t base = reinterpret_cast<uintptr_t>(m_buffer.get());
+    const uintptr_t p = (base + m_used + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    const size_t offset = static_cast<size_t>(p - base);
+    /// zero bytes take one, so the end of the buffer is never returned and do_deallocate can tell it from upstream memory
+    const size_t size = std::max<size_t>(bytes, 1);
+    if (offset <= m_capacity && size <= m_capacity - offset) {
+        m_used = offset + size;
+        m_peak = std::max(m_peak, m_used + m_overflow);
+        return reinterpret_cast<void *>(p);
+    }
+    void *des = m_upstream->allocate(bytes, alignment);
+    m_overflow += bytes;
+    m_peak = std::max(m_peak, m_used + m_overflow);
+    return des;
+}
+
+void MonotonicArena::do_deallocate(void *p, size_t bytes, size_t alignment) {
+    const std::byte *b = static_cast<const std::byte *>(p);
+    /// memory of the buffer is released by reset()
+    if (b < m_buffer.get() || b >= m_buffer.get() + m_capacity) {
+        m_upstream->deallocate(p, bytes, alignment);
+    }
+}
+
+bool MonotonicArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
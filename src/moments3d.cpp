@@ -0,0 +1,178 @@
+#include "tf2_geometry/moments3d.hpp"
+#include "tf2_geometry/instrumentation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace tf2;
+
+namespace {
+/**
+ * expands the packed scatter values into a symmetric matrix
+ **/
+void unpack(const tf2Scalar s[6], tf2Scalar scale, tf2Scalar des[3][3]) {
+    des[0][0] = s[0] * scale, des[0][1] = s[1] * scale, des[0][2] = s[2] * scale;
+    des[1][0] = des[0][1], des[1][1] = s[3] * scale, des[1][2] = s[4] * scale;
+    des[2][0] = des[0][2], des[2][1] = des[1][2], des[2][2] = s[5] * scale;
+}
+
+/**
+ * adds the outer product of two vectors to the packed scatter values
+ **/
+void add_outer(tf2Scalar s[6], const Vector3 &u, const Vector3 &v, tf2Scalar scale) {
+    s[0] += u[0] * v[0] * scale, s[1] += u[0] * v[1] * scale, s[2] += u[0] * v[2] * scale;
+    s[3] += u[1] * v[1] * scale, s[4] += u[1] * v[2] * scale, s[5] += u[2] * v[2] * scale;
+}
+}  // namespace
+
+Moments3D::Moments3D() {
+    clear();
+}
+
+Moments3D &Moments3D::clear() {
+    m_n = 0;
+    m_mean.setValue(0., 0., 0.);
+    std::fill(m_scatter, m_scatter + 6, 0.);
+    return *this;
+}
+
+Moments3D &Moments3D::add(const Point3D &p) {
+    m_n++;
+    const Vector3 delta = p - m_mean;
+    m_mean += delta / static_cast<tf2Scalar>(m_n);
+    add_outer(m_scatter, delta, p - m_mean, 1.0);
+    return *this;
+}
+
+Moments3D &Moments3D::add(const Point3D *points, size_t n) {
+    TF2_GEOMETRY_KERNEL(kMoments3DAdd, n);
+    if (n == 0) {
+        return *this;
+    }
+    Moments3D block;
+    block.m_n = n;
+    for (size_t i = 0; i < n; i++) {
+        block.m_mean += points[i];
+    }
+    block.m_mean /= static_cast<tf2Scalar>(n);
+    for (size_t i = 0; i < n; i++) {
+        const Vector3 d = points[i] - block.m_mean;
+        add_outer(block.m_scatter, d, d, 1.0);
+    }
+    return merge(block);
+}
+
+Moments3D &Moments3D::remove(const Point3D &p) {
+    if (m_n <= 1) {
+        return clear();
+    }
+    const tf2Scalar n = static_cast<tf2Scalar>(m_n);
+    const Vector3 mean = (m_mean * n - p) / (n - 1.0);
+    add_outer(m_scatter, p - mean, p - m_mean, -1.0);
+    m_mean = mean;
+    m_n--;
+    return *this;
+}
+
+Moments3D &Moments3D::merge(const Moments3D &o) {
+    if (o.m_n == 0) {
+        return *this;
+    }
+    if (m_n == 0) {
+        return *this = o;
+    }
+    const tf2Scalar na = static_cast<tf2Scalar>(m_n), nb = static_cast<tf2Scalar>(o.m_n);
+    const tf2Scalar n = na + nb;
+    const Vector3 delta = o.m_mean - m_mean;
+    for (int i = 0; i < 6; i++) {
+        m_scatter[i] += o.m_scatter[i];
+    }
+    add_outer(m_scatter, delta, delta, na * nb / n);
+    m_mean += delta * (nb / n);
+    m_n += o.m_n;
+    return *this;
+}
+
+size_t Moments3D::count() const {
+    return m_n;
+}
+
+const Vector3 &Moments3D::mean() const {
+    return m_mean;
+}
+
+void Moments3D::covariance(tf2Scalar des[3][3]) const {
+    unpack(m_scatter, m_n > 0 ? 1.0 / static_cast<tf2Scalar>(m_n) : 0.0, des);
+}
+
+void Moments3D::eigenvalues(tf2Scalar des[3]) const {
+    tf2Scalar A[3][3];
+    covariance(A);
+    eigenvalues(A, des);
+}
+
+tf2Scalar Moments3D::curvature() const {
+    tf2Scalar lambda[3];
+    eigenvalues(lambda);
+    const tf2Scalar sum = lambda[0] + lambda[1] + lambda[2];
+    return sum > 0 ? lambda[0] / sum : 0.0;
+}
+
+bool Moments3D::fit(Plane3D &des) const {
+    if (m_n < 3) {
+        return false;
+    }
+    tf2Scalar A[3][3];
+    unpack(m_scatter, 1.0, A);
+    Vector3 normal;
+    if (!smallest_eigenvector(A, normal)) {
+        return false;
+    }
+    des.create(Point3D(m_mean[0], m_mean[1], m_mean[2]), normal);
+    return true;
+}
+
+void Moments3D::eigenvalues(const tf2Scalar A[3][3], tf2Scalar des[3]) {
+    const tf2Scalar p1 = A[0][1] * A[0][1] + A[0][2] * A[0][2] + A[1][2] * A[1][2];
+    const tf2Scalar q = (A[0][0] + A[1][1] + A[2][2]) / 3.0;
+    const tf2Scalar p2 = (A[0][0] - q) * (A[0][0] - q) + (A[1][1] - q) * (A[1][1] - q) + (A[2][2] - q) * (A[2][2] - q) + 2.0 * p1;
+    const tf2Scalar p = std::sqrt(p2 / 6.0);
+    if (p <= std::numeric_limits<tf2Scalar>::min()) {
+        des[0] = des[1] = des[2] = q;
+        return;
+    }
+    tf2Scalar B[3][3];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            B[i][j] = (A[i][j] - (i == j ? q : 0.0)) / p;
+        }
+    }
+    const tf2Scalar det = B[0][0] * (B[1][1] * B[2][2] - B[1][2] * B[2][1]) - B[0][1] * (B[1][0] * B[2][2] - B[1][2] * B[2][0]) +
+                          B[0][2] * (B[1][0] * B[2][1] - B[1][1] * B[2][0]);
+    const tf2Scalar phi = std::acos(std::clamp(det / 2.0, -1.0, 1.0)) / 3.0;
+    des[2] = q + 2.0 * p * std::cos(phi);
+    des[0] = q + 2.0 * p * std::cos(phi + (2.0 * M_PI / 3.0));
+    des[1] = 3.0 * q - des[0] - des[2];
+}
+
+bool Moments3D::smallest_eigenvector(const tf2Scalar A[3][3], Vector3 &des) {
+    tf2Scalar lambda[3];
+    eigenvalues(A, lambda);
+    if (lambda[1] - lambda[0] <= 1e-12 * std::max<tf2Scalar>(lambda[2], std::numeric_limits<tf2Scalar>::min())) {
+        return false;
+    }
+    /// the eigenvector is orthogonal to the rows of A - lambda * I
+    const Vector3 r0(A[0][0] - lambda[0], A[0][1], A[0][2]);
+    const Vector3 r1(A[1][0], A[1][1] - lambda[0], A[1][2]);
+    const Vector3 r2(A[2][0], A[2][1], A[2][2] - lambda[0]);
+    const Vector3 c01 = r0.cross(r1), c02 = r0.cross(r2), c12 = r1.cross(r2);
+    const tf2Scalar l01 = c01.length2(), l02 = c02.length2(), l12 = c12.length2();
+    if (l01 >= l02 && l01 >= l12) {
+        des = c01 / std::sqrt(l01);
+    } else if (l02 >= l12) {
+        des = c02 / std::sqrt(l02);
+    } else {
+        des = c12 / std::sqrt(l12);
+    }
+    return true;
+}
@@ -0,0 +1,144 @@
+#include "tf2_geometry/obb2d.hpp"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/instrumentation.hpp"
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+using namespace tf2;
+
+namespace {
+constexpr tf2Scalar kInf = std::numeric_limits<tf2Scalar>::infinity();
+}  // namespace
+
+OBB2D::OBB2D()
+    : m_x(0.0), m_y(0.0), m_rotation(0.0), m_cos(1.0), m_sin(0.0), m_half_length(0.0), m_half_width(0.0) {}
+
+OBB2D::OBB2D(const Transform2D &pose, tf2Scalar length, tf2Scalar width) {
+    set(pose, length, width);
+}
+
+OBB2D::OBB2D(const AABB2D &box)
+    : m_x(0.0), m_y(0.0), m_rotation(0.0), m_cos(1.0), m_sin(0.0), m_half_length(-kInf), m_half_width(-kInf) {
+    /// the center of an empty box is (inf + -inf) / 2
+    if (!box.empty()) {
+        m_x = box.center().x(), m_y = box.center().y();
+        m_half_length = 0.5 * box.size_x(), m_half_width = 0.5 * box.size_y();
+    }
+}
+
+bool OBB2D::empty() const {
+    return !(m_half_length >= 0.0 && m_half_width >= 0.0);
+}
+
+OBB2D &OBB2D::set(const Transform2D &pose, tf2Scalar length, tf2Scalar width) {
+    m_x = pose.x(), m_y = pose.y(), m_rotation = pose.rotation();
+    m_cos = pose.cos_theta(), m_sin = pose.sin_theta();
+    m_half_length = 0.5 * length, m_half_width = 0.5 * width;
+    return *this;
+}
+
+Transform2D OBB2D::pose() const {
+    Transform2D des;
+    des.set(m_x, m_y, m_rotation, m_cos, m_sin);
+    return des;
+}
+
+Point2D OBB2D::center() const {
+    return Point2D(m_x, m_y);
+}
+
+tf2Scalar OBB2D::length() const {
+    return empty() ? 0.0 : 2.0 * m_half_length;
+}
+
+tf2Scalar OBB2D::width() const {
+    return empty() ? 0.0 : 2.0 * m_half_width;
+}
+
+Point2D OBB2D::corner(size_t i) const {
+    if (empty()) {
+        return center();
+    }
+    const tf2Scalar u = (i == 1 || i == 2) ? m_half_length : -m_half_length;
+    const tf2Scalar v = (i >= 2) ? m_half_width : -m_half_width;
+    return Point2D(m_x + u * m_cos - v * m_sin, m_y + u * m_sin + v * m_cos);
+}
+
+AABB2D OBB2D::aabb() const {
+    if (empty()) {
+        return AABB2D();
+    }
+    const tf2Scalar ex = m_half_length * std::abs(m_cos) + m_half_width * std::abs(m_sin);
+    const tf2Scalar ey = m_half_length * std::abs(m_sin) + m_half_width * std::abs(m_cos);
+    return AABB2D(m_x - ex, m_y - ey, m_x + ex, m_y + ey);
+}
+
+bool OBB2D::contains(const Point2D &p) const {
+    if (empty()) {
+        return false;
+    }
+    const tf2Scalar dx = p.x() - m_x, dy = p.y() - m_y;
+    return std::abs(dx * m_cos + dy * m_sin) <= m_half_length && std::abs(dy * m_cos - dx * m_sin) <= m_half_width;
+}
+
+bool OBB2D::intersects(const OBB2D &o) const {
+    const tf2Scalar tx = o.m_x - m_x, ty = o.m_y - m_y;
+    /// cos and sin of the relative rotation give the projections of the axes of o on the axes of this
+    const tf2Scalar c = std::abs(m_cos * o.m_cos + m_sin * o.m_sin), s = std::abs(m_cos * o.m_sin - m_sin * o.m_cos);
+    /// the four tests are combined without branches to avoid mispredictions in the batches
+    const bool separated = (std::abs(tx * m_cos + ty * m_sin) > m_half_length + o.m_half_length * c + o.m_half_width * s) |
+                           (std::abs(ty * m_cos - tx * m_sin) > m_half_width + o.m_half_length * s + o.m_half_width * c) |
+                           (std::abs(tx * o.m_cos + ty * o.m_sin) > o.m_half_length + m_half_length * c + m_half_width * s) |
+                           (std::abs(ty * o.m_cos - tx * o.m_sin) > o.m_half_width + m_half_length * s + m_half_width * c) |
+                           empty() | o.empty();
+    return !separated;
+}
+
+bool OBB2D::intersects(const LineSegment2D &s) const {
+    /// segment as midpoint and half direction
+    const tf2Scalar hx = 0.5 * (s.p1().x() - s.p0().x()), hy = 0.5 * (s.p1().y() - s.p0().y());
+    const tf2Scalar tx = s.p0().x() + hx - m_x, ty = s.p0().y() + hy - m_y;
+    const bool separated = (std::abs(tx * m_cos + ty * m_sin) > m_half_length + std::abs(hx * m_cos + hy * m_sin)) |
+                           (std::abs(ty * m_cos - tx * m_sin) > m_half_width + std::abs(hy * m_cos - hx * m_sin)) |
+                           (std::abs(tx * hy - ty * hx) > m_half_length * std::abs(m_cos * hy - m_sin * hx) + m_half_width * std::abs(m_sin * hy + m_cos * hx)) |
+                           empty();
+    return !separated;
+}
+
+template<typename T> size_t OBB2D::intersects_range(const T *src, size_t n, uint8_t *mask) const {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        mask[i] = intersects(src[i]);
+        count += mask[i];
+    }
+    return count;
+}
+
+size_t OBB2D::intersects(const OBB2D *boxes, size_t n, uint8_t *mask) const {
+    TF2_GEOMETRY_KERNEL(kOBB2DIntersects, n);
+    return intersects_range(boxes, n, mask);
+}
+
+size_t OBB2D::intersects(const ExecutionPolicy &policy, const OBB2D *boxes, size_t n, uint8_t *mask) const {
+    TF2_GEOMETRY_KERNEL(kOBB2DIntersects, n);
+    std::atomic<size_t> count{0};
+    policy.for_each(n, [&](size_t begin, size_t end) {
+        count.fetch_add(intersects_range(boxes + begin, end - begin, mask + begin), std::memory_order_relaxed);
+    });
+    return count.load();
+}
+
+size_t OBB2D::intersects(const LineSegment2D *segments, size_t n, uint8_t *mask) const {
+    TF2_GEOMETRY_KERNEL(kOBB2DIntersects, n);
+    return intersects_range(segments, n, mask);
+}
+
+size_t OBB2D::intersects(const ExecutionPolicy &policy, const LineSegment2D *segments, size_t n, uint8_t *mask) const {
+    TF2_GEOMETRY_KERNEL(kOBB2DIntersects, n);
+    std::atomic<size_t> count{0};
+    policy.for_each(n, [&](size_t begin, size_t end) {
+        count.fetch_add(intersects_range(segments + begin, end - begin, mask + begin), std::memory_order_relaxed);
+    });
+    return count.load();
+}
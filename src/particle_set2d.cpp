@@ -0,0 +1,193 @@
+#include "tf2_geometry/particle_set2d.hpp"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/instrumentation.hpp"
+#include "tf2_geometry/transform2d_t.hpp"
+#include "tf2_geometry/utils.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace tf2;
+
+namespace {
+using Pack4 = simd::Pack<tf2Scalar, 4>;
+using Transform2D4 = Transform2DT<Pack4>;
+}  // namespace
+
+ParticleSet2D::ParticleSet2D() {}
+
+ParticleSet2D::ParticleSet2D(size_t n) {
+    resize(n);
+}
+
+void ParticleSet2D::resize(size_t n) {
+    m_x.resize(n, 0.0), m_y.resize(n, 0.0), m_theta.resize(n, 0.0);
+    m_cos.resize(n, 1.0), m_sin.resize(n, 0.0);
+    m_weight.assign(n, n > 0 ? 1.0 / n : 0.0);
+}
+
+size_t ParticleSet2D::size() const {
+    return m_x.size();
+}
+
+void ParticleSet2D::fill(const Transform2D &pose) {
+    const size_t n = size();
+    std::fill(m_x.begin(), m_x.end(), pose.x()), std::fill(m_y.begin(), m_y.end(), pose.y());
+    std::fill(m_theta.begin(), m_theta.end(), pose.rotation());
+    std::fill(m_cos.begin(), m_cos.end(), std::cos(pose.rotation())), std::fill(m_sin.begin(), m_sin.end(), std::sin(pose.rotation()));
+    std::fill(m_weight.begin(), m_weight.end(), n > 0 ? 1.0 / n : 0.0);
+}
+
+void ParticleSet2D::set(size_t i, const Transform2D &pose) {
+    m_x[i] = pose.x(), m_y[i] = pose.y(), m_theta[i] = pose.rotation();
+    m_cos[i] = std::cos(pose.rotation()), m_sin[i] = std::sin(pose.rotation());
+}
+
+Transform2D ParticleSet2D::pose(size_t i) const {
+    return Transform2D(m_x[i], m_y[i], m_theta[i]);
+}
+
+const tf2Scalar *ParticleSet2D::x() const {
+    return m_x.data();
+}
+const tf2Scalar *ParticleSet2D::y() const {
+    return m_y.data();
+}
+const tf2Scalar *ParticleSet2D::theta() const {
+    return m_theta.data();
+}
+const tf2Scalar *ParticleSet2D::cos() const {
+    return m_cos.data();
+}
+const tf2Scalar *ParticleSet2D::sin() const {
+    return m_sin.data();
+}
+const tf2Scalar *ParticleSet2D::weights() const {
+    return m_weight.data();
+}
+tf2Scalar *ParticleSet2D::weights() {
+    return m_weight.data();
+}
+
+void ParticleSet2D::move(const Transform2D &delta) {
+    const size_t n = size();
+    TF2_GEOMETRY_KERNEL(kParticleSet2DMove, n);
+    /// the same delta for all particles, its cos and sin are computed once
+    const Transform2D4 d(Pack4(delta.x()), Pack4(delta.y()), Pack4(delta.rotation()));
+    Transform2D4 p;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        p.set(Pack4::load(&m_x[i]), Pack4::load(&m_y[i]), Pack4::load(&m_theta[i]), Pack4::load(&m_cos[i]), Pack4::load(&m_sin[i]));
+        p.transform_into_parent(d, p);
+        p.x().store(&m_x[i]), p.y().store(&m_y[i]), p.rotation().store(&m_theta[i]), p.cos().store(&m_cos[i]), p.sin().store(&m_sin[i]);
+    }
+    const Transform2Dd ds(delta.x(), delta.y(), delta.rotation());
+    for (; i < n; i++) {
+        Transform2Dd q;
+        q.set(m_x[i], m_y[i], m_theta[i], m_cos[i], m_sin[i]);
+        q.transform_into_parent(ds, q);
+        m_x[i] = q.x(), m_y[i] = q.y(), m_theta[i] = q.rotation(), m_cos[i] = q.cos(), m_sin[i] = q.sin();
+    }
+}
+
+void ParticleSet2D::move(const Transform2D &delta, const tf2Scalar *noise_x, const tf2Scalar *noise_y, const tf2Scalar *noise_theta) {
+    const size_t n = size();
+    TF2_GEOMETRY_KERNEL(kParticleSet2DMove, n);
+    const Pack4 dx(delta.x()), dy(delta.y()), dtheta(delta.rotation());
+    Transform2D4 p, d;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        d.set(dx + Pack4::load(noise_x + i), dy + Pack4::load(noise_y + i), dtheta + Pack4::load(noise_theta + i));
+        p.set(Pack4::load(&m_x[i]), Pack4::load(&m_y[i]), Pack4::load(&m_theta[i]), Pack4::load(&m_cos[i]), Pack4::load(&m_sin[i]));
+        p.transform_into_parent(d, p);
+        p.x().store(&m_x[i]), p.y().store(&m_y[i]), p.rotation().store(&m_theta[i]), p.cos().store(&m_cos[i]), p.sin().store(&m_sin[i]);
+    }
+    for (; i < n; i++) {
+        const Transform2Dd ds(delta.x() + noise_x[i], delta.y() + noise_y[i], delta.rotation() + noise_theta[i]);
+        Transform2Dd q;
+        q.set(m_x[i], m_y[i], m_theta[i], m_cos[i], m_sin[i]);
+        q.transform_into_parent(ds, q);
+        m_x[i] = q.x(), m_y[i] = q.y(), m_theta[i] = q.rotation(), m_cos[i] = q.cos(), m_sin[i] = q.sin();
+    }
+}
+
+void ParticleSet2D::weigh(const MeasurementModel &model) {
+    const size_t n = size();
+    m_likelihood.resize(n);
+    model(*this, 0, n, m_likelihood.data());
+    for (size_t i = 0; i < n; i++) {
+        m_weight[i] *= m_likelihood[i];
+    }
+}
+
+void ParticleSet2D::weigh(const ExecutionPolicy &policy, const MeasurementModel &model) {
+    m_likelihood.resize(size());
+    policy.for_each(size(), [&](size_t begin, size_t end) {
+        model(*this, begin, end, m_likelihood.data() + begin);
+        for (size_t i = begin; i < end; i++) {
+            m_weight[i] *= m_likelihood[i];
+        }
+    });
+}
+
+tf2Scalar ParticleSet2D::normalize() {
+    const size_t n = size();
+    tf2Scalar sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        sum += m_weight[i];
+    }
+    if (sum > 0.0) {
+        const tf2Scalar scale = 1.0 / sum;
+        for (size_t i = 0; i < n; i++) {
+            m_weight[i] *= scale;
+        }
+    } else if (n > 0) {
+        std::fill(m_weight.begin(), m_weight.end(), 1.0 / n);
+    }
+    return sum;
+}
+
+tf2Scalar ParticleSet2D::effective_size() const {
+    tf2Scalar sum = 0.0;
+    for (tf2Scalar w : m_weight) {
+        sum += w * w;
+    }
+    return sum > 0.0 ? 1.0 / sum : 0.0;
+}
+
+Transform2D ParticleSet2D::mean() const {
+    tf2Scalar x = 0.0, y = 0.0, c = 0.0, s = 0.0, sum = 0.0;
+    for (size_t i = 0; i < size(); i++) {
+        const tf2Scalar w = m_weight[i];
+        x += w * m_x[i], y += w * m_y[i], c += w * m_cos[i], s += w * m_sin[i], sum += w;
+    }
+    if (!(sum > 0.0)) {
+        return Transform2D();
+    }
+    return Transform2D(x / sum, y / sum, std::atan2(s, c));
+}
+
+void ParticleSet2D::resample(tf2Scalar u) {
+    const size_t n = size();
+    if (n == 0) {
+        return;
+    }
+    /// one offset and n equidistant pointers into the cumulative weights
+    m_source.resize(n);
+    const tf2Scalar step = 1.0 / n;
+    tf2Scalar cumulative = m_weight[0], pointer = u * step;
+    size_t j = 0;
+    for (size_t i = 0; i < n; i++, pointer += step) {
+        while (pointer > cumulative && j + 1 < n) {
+            cumulative += m_weight[++j];
+        }
+        m_source[i] = j;
+    }
+    for (std::vector<tf2Scalar> *array : {&m_x, &m_y, &m_theta, &m_cos, &m_sin}) {
+        m_swap.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            m_swap[i] = (*array)[m_source[i]];
+        }
+        array->swap(m_swap);
+    }
+    std::fill(m_weight.begin(), m_weight.end(), step);
+}
@@ -0,0 +1,177 @@
+#include "tf2_geometry/pixel_ray_table.hpp"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/instrumentation.hpp"
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+using namespace tf2;
+
+PixelRayTable::PixelRayTable() {
+    m_pose.setIdentity();
+}
+
+PixelRayTable::PixelRayTable(const Intrinsics &intrinsics) {
+    m_pose.setIdentity();
+    set_intrinsics(intrinsics);
+}
+
+void PixelRayTable::set_intrinsics(const Intrinsics &intrinsics) {
+    m_intrinsics = intrinsics;
+    /// a zero or non-finite focal length would fill the table with inf and NaN rays
+    if (!(m_intrinsics.fx != 0.0) || !std::isfinite(m_intrinsics.fx)) {
+        m_intrinsics.fx = Intrinsics().fx;
+    }
+    if (!(m_intrinsics.fy != 0.0) || !std::isfinite(m_intrinsics.fy)) {
+        m_intrinsics.fy = Intrinsics().fy;
+    }
+    if (!std::isfinite(m_intrinsics.cx)) {
+        m_intrinsics.cx = Intrinsics().cx;
+    }
+    if (!std::isfinite(m_intrinsics.cy)) {
+        m_intrinsics.cy = Intrinsics().cy;
+    }
+    m_cx.resize(m_intrinsics.width);
+    m_cy.resize(m_intrinsics.height);
+    for (size_t u = 0; u < m_intrinsics.width; u++) {
+        m_cx[u] = (static_cast<tf2Scalar>(u) - m_intrinsics.cx) / m_intrinsics.fx;
+    }
+    for (size_t v = 0; v < m_intrinsics.height; v++) {
+        m_cy[v] = (static_cast<tf2Scalar>(v) - m_intrinsics.cy) / m_intrinsics.fy;
+    }
+    const size_t n = size();
+    m_rx.resize(n), m_ry.resize(n), m_rz.resize(n);
+    set_pose(m_pose);
+}
+
+const PixelRayTable::Intrinsics &PixelRayTable::intrinsics() const {
+    return m_intrinsics;
+}
+
+void PixelRayTable::set_pose(const Transform &pose) {
+    m_pose = pose;
+    const Matrix3x3 &R = m_pose.getBasis();
+    /// R * (x, y, 1) = R.col0 * x + R.col1 * y + R.col2
+    const Vector3 c0 = R.getColumn(0), c1 = R.getColumn(1), c2 = R.getColumn(2);
+    const size_t width = m_intrinsics.width;
+    for (size_t v = 0; v < m_intrinsics.height; v++) {
+        const tf2Scalar y = m_cy[v];
+        const tf2Scalar bx = c1[0] * y + c2[0], by = c1[1] * y + c2[1], bz = c1[2] * y + c2[2];
+        tf2Scalar *rx = m_rx.data() + v * width, *ry = m_ry.data() + v * width, *rz = m_rz.data() + v * width;
+        for (size_t u = 0; u < width; u++) {
+            const tf2Scalar x = m_cx[u];
+            rx[u] = c0[0] * x + bx, ry[u] = c0[1] * x + by, rz[u] = c0[2] * x + bz;
+        }
+    }
+}
+
+const Transform &PixelRayTable::pose() const {
+    return m_pose;
+}
+
+size_t PixelRayTable::size() const {
+    return m_intrinsics.width * m_intrinsics.height;
+}
+
+Vector3 PixelRayTable::ray(size_t u, size_t v) const {
+    const size_t i = v * m_intrinsics.width + u;
+    return Vector3(m_rx[i], m_ry[i], m_rz[i]);
+}
+
+namespace {
+/// unit normal turned upwards and in plane axes, the normal points along +z for horizontal planes
+void plane_axes(const Plane3D &plane, Vector3 &n, Vector3 &ex, Vector3 &ey) {
+    n = Vector3(plane.a(), plane.b(), plane.c());
+    n /= n.length();
+    if (n[2] < 0.0 || (n[2] == 0.0 && (n[1] < 0.0 || (n[1] == 0.0 && n[0] < 0.0)))) {
+        n = -n;
+    }
+    /// parent x axis projected onto the plane, y if x is nearly normal to the plane
+    ex = std::abs(n[0]) < 0.9 ? Vector3(1.0, 0.0, 0.0) - n * n[0] : Vector3(0.0, 1.0, 0.0) - n * n[1];
+    ex /= ex.length();
+    ey = n.cross(ex);
+}
+}  // namespace
+
+Transform PixelRayTable::plane_frame(const Plane3D &plane) {
+    Vector3 n, ex, ey;
+    plane_axes(plane, n, ex, ey);
+    /// a x + b y + c z + d = 0 is closest to the origin at -d n / |(a, b, c)|^2
+    const Vector3 abc(plane.a(), plane.b(), plane.c());
+    const Vector3 origin = abc * (-plane.d() / abc.length2());
+    return Transform(Matrix3x3(ex[0], ey[0], n[0], ex[1], ey[1], n[1], ex[2], ey[2], n[2]), origin);
+}
+
+PixelRayTable::Projection PixelRayTable::projection(const Plane3D &plane) const {
+    Projection p;
+    Vector3 n;
+    plane_axes(plane, n, p.ex, p.ey);
+    const Vector3 &o = m_pose.getOrigin();
+    p.n = Vector3(plane.a(), plane.b(), plane.c());
+    p.k = -(p.n.dot(o) + plane.d());
+    /// the frame origin is a multiple of n, so the in plane coordinates of o + t * r are ex * o + t * (ex * r)
+    p.x0 = p.ex.dot(o), p.y0 = p.ey.dot(o);
+    return p;
+}
+
+size_t PixelRayTable::project(const Plane3D &plane, Point2D *des, uint8_t *valid) const {
+    TF2_GEOMETRY_KERNEL(kPixelRayTableProject, size());
+    return project_range(projection(plane), 0, size(), des, valid);
+}
+
+size_t PixelRayTable::project(const ExecutionPolicy &policy, const Plane3D &plane, Point2D *des, uint8_t *valid) const {
+    TF2_GEOMETRY_KERNEL(kPixelRayTableProject, size());
+    const Projection p = projection(plane);
+    std::atomic<size_t> count{0};
+    policy.for_each(size(), [&](size_t begin, size_t end) {
+        count.fetch_add(project_range(p, begin, end, des, valid), std::memory_order_relaxed);
+    });
+    return count.load();
+}
+
+size_t PixelRayTable::project(const Plane3D &plane, const uint32_t *pixels, size_t n, Point2D *des, uint8_t *valid) const {
+    TF2_GEOMETRY_KERNEL(kPixelRayTableProject, n);
+    return project_pixels(projection(plane), pixels, n, des, valid);
+}
+
+size_t PixelRayTable::project(const ExecutionPolicy &policy, const Plane3D &plane, const uint32_t *pixels, size_t n, Point2D *des,
+                              uint8_t *valid) const {
+    TF2_GEOMETRY_KERNEL(kPixelRayTableProject, n);
+    const Projection p = projection(plane);
+    std::atomic<size_t> count{0};
+    policy.for_each(n, [&](size_t begin, size_t end) {
+        count.fetch_add(project_pixels(p, pixels + begin, end - begin, des + begin, valid + begin), std::memory_order_relaxed);
+    });
+    return count.load();
+}
+
+size_t PixelRayTable::project_range(const Projection &p, size_t begin, size_t end, Point2D *des, uint8_t *valid) const {
+    const tf2Scalar t_max = std::numeric_limits<tf2Scalar>::max();
+    const tf2Scalar *rx = m_rx.data(), *ry = m_ry.data(), *rz = m_rz.data();
+    size_t count = 0;
+    for (size_t i = begin; i < end; i++) {
+        const tf2Scalar t = p.k / (p.n[0] * rx[i] + p.n[1] * ry[i] + p.n[2] * rz[i]);
+        const bool hit = t > 0 && t < t_max;
+        des[i].m_floats[0] = hit ? p.x0 + t * (p.ex[0] * rx[i] + p.ex[1] * ry[i] + p.ex[2] * rz[i]) : 0.0;
+        des[i].m_floats[1] = hit ? p.y0 + t * (p.ey[0] * rx[i] + p.ey[1] * ry[i] + p.ey[2] * rz[i]) : 0.0;
+        valid[i] = hit;
+        count += hit;
+    }
+    return count;
+}
+
+size_t PixelRayTable::project_pixels(const Projection &p, const uint32_t *pixels, size_t n, Point2D *des, uint8_t *valid) const {
+    const tf2Scalar t_max = std::numeric_limits<tf2Scalar>::max();
+    const tf2Scalar *rx = m_rx.data(), *ry = m_ry.data(), *rz = m_rz.data();
+    size_t count = 0;
+    for (size_t j = 0; j < n; j++) {
+        const uint32_t i = pixels[j];
+        const tf2Scalar t = p.k / (p.n[0] * rx[i] + p.n[1] * ry[i] + p.n[2] * rz[i]);
+        const bool hit = t > 0 && t < t_max;
+        des[j].m_floats[0] = hit ? p.x0 + t * (p.ex[0] * rx[i] + p.ex[1] * ry[i] + p.ex[2] * rz[i]) : 0.0;
+        des[j].m_floats[1] = hit ? p.y0 + t * (p.ey[0] * rx[i] + p.ey[1] * ry[i] + p.ey[2] * rz[i]) : 0.0;
+        valid[j] = hit;
+        count += hit;
+    }
+    return count;
+}
@@ -1,8 +1,95 @@
 #include "tf2_geometry/plane3d.hpp"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/instrumentation.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include "tf2_geometry/simd.hpp"
 
 using namespace tf2;
 
+namespace {
+/// points processed per block while classifying
+constexpr size_t kBlockSize = 256;
+
+static_assert(sizeof(Point3D) == 4 * sizeof(tf2Scalar), "Point3D must hold four contiguous scalars");
+
+/**
+ * computes the signed distances of points to the plane a*x + b*y + c*z + d = 0
+ * the points are transposed in registers into x, y and z lanes
+ * @param abcd plane equation
+ * @param src points
+ * @param n number of points
+ * @param des distances
+ **/
+void plane_distances(const tf2Scalar *abcd, const Point3D *src, size_t n, tf2Scalar *des) {
+    const tf2Scalar a = abcd[0], b = abcd[1], c = abcd[2], d = abcd[3];
+    size_t i = 0;
+#if defined(TF2_GEOMETRY_SIMD_AVX)
+    const __m256d va = _mm256_set1_pd(a), vb = _mm256_set1_pd(b), vc = _mm256_set1_pd(c), vd = _mm256_set1_pd(d);
+    for (; i + 4 <= n; i += 4) {
+        const __m256d p0 = _mm256_loadu_pd(src[i + 0].m_floats);
+        const __m256d p1 = _mm256_loadu_pd(src[i + 1].m_floats);
+        const __m256d p2 = _mm256_loadu_pd(src[i + 2].m_floats);
+        const __m256d p3 = _mm256_loadu_pd(src[i + 3].m_floats);
+        const __m256d t0 = _mm256_unpacklo_pd(p0, p1);  /// x0 x1 z0 z1
+        const __m256d t1 = _mm256_unpackhi_pd(p0, p1);  /// y0 y1 w0 w1
+        const __m256d t2 = _mm256_unpacklo_pd(p2, p3);  /// x2 x3 z2 z3
+        const __m256d t3 = _mm256_unpackhi_pd(p2, p3);  /// y2 y3 w2 w3
+        const __m256d x = _mm256_permute2f128_pd(t0, t2, 0x20);
+        const __m256d z = _mm256_permute2f128_pd(t0, t2, 0x31);
+        const __m256d y = _mm256_permute2f128_pd(t1, t3, 0x20);
+        const __m256d dist = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(va, x), _mm256_mul_pd(vb, y)), _mm256_add_pd(_mm256_mul_pd(vc, z), vd));
+        _mm256_storeu_pd(des + i, dist);
+    }
+#elif defined(TF2_GEOMETRY_SIMD_SSE2)
+    const __m128d va = _mm_set1_pd(a), vb = _mm_set1_pd(b), vc = _mm_set1_pd(c), vd = _mm_set1_pd(d);
+    for (; i + 2 <= n; i += 2) {
+        const __m128d p0xy = _mm_loadu_pd(src[i + 0].m_floats), p0zw = _mm_loadu_pd(src[i + 0].m_floats + 2);
+        const __m128d p1xy = _mm_loadu_pd(src[i + 1].m_floats), p1zw = _mm_loadu_pd(src[i + 1].m_floats + 2);
+        const __m128d x = _mm_unpacklo_pd(p0xy, p1xy);
+        const __m128d y = _mm_unpackhi_pd(p0xy, p1xy);
+        const __m128d z = _mm_unpacklo_pd(p0zw, p1zw);
+        const __m128d dist = _mm_add_pd(_mm_add_pd(_mm_mul_pd(va, x), _mm_mul_pd(vb, y)), _mm_add_pd(_mm_mul_pd(vc, z), vd));
+        _mm_storeu_pd(des + i, dist);
+    }
+#elif defined(TF2_GEOMETRY_SIMD_NEON)
+    const float64x2_t va = vdupq_n_f64(a), vb = vdupq_n_f64(b), vc = vdupq_n_f64(c), vd = vdupq_n_f64(d);
+    for (; i + 2 <= n; i += 2) {
+        const float64x2_t p0xy = vld1q_f64(src[i + 0].m_floats), p0zw = vld1q_f64(src[i + 0].m_floats + 2);
+        const float64x2_t p1xy = vld1q_f64(src[i + 1].m_floats), p1zw = vld1q_f64(src[i + 1].m_floats + 2);
+        const float64x2_t x = vzip1q_f64(p0xy, p1xy);
+        const float64x2_t y = vzip2q_f64(p0xy, p1xy);
+        const float64x2_t z = vzip1q_f64(p0zw, p1zw);
+        vst1q_f64(des + i, vfmaq_f64(vfmaq_f64(vfmaq_f64(vd, va, x), vb, y), vc, z));
+    }
+#endif
+    for (; i < n; i++) {
+        const tf2Scalar *p = src[i].m_floats;
+        des[i] = a * p[0] + b * p[1] + c * p[2] + d;
+    }
+}
+
+/**
+ * marks the points within threshold of the plane, not instrumented
+ * @return number of marked points
+ **/
+size_t classify_points(const tf2Scalar *abcd, const Point3D *src, size_t n, tf2Scalar threshold, uint8_t *mask) {
+    tf2Scalar distances[kBlockSize];
+    size_t count = 0;
+    for (size_t i0 = 0; i0 < n; i0 += kBlockSize) {
+        const size_t m = std::min(kBlockSize, n - i0);
+        plane_distances(abcd, src + i0, m, distances);
+        for (size_t k = 0; k < m; k++) {
+            const uint8_t inlier = std::fabs(distances[k]) <= threshold;
+            mask[i0 + k] = inlier;
+            count += inlier;
+        }
+    }
+    return count;
+}
+}  // namespace
+
 Plane3D::Plane3D(const Point3D &p1, const Point3D &p2, const Point3D &p3, bool normalize) {
     create(p1, p2, p3, normalize);
 }
@@ -76,9 +163,66 @@ tf2Scalar &Plane3D::d() {
     return this->m_floats[3];
 }
 
-tf2Scalar Plane3D::distance_to(const Point3D &p) const {
-    tf2Scalar distance = this->head().dot(p) + (*this)[3];
-    return distance;
+void Plane3D::distances_to(const Point3D *src, size_t n, tf2Scalar *des) const {
+    TF2_GEOMETRY_KERNEL(kPlane3DDistances, n);
+    plane_distances(m_floats, src, n, des);
+}
+
+size_t Plane3D::classify(const Point3D *src, size_t n, tf2Scalar threshold, uint8_t *mask) const {
+    TF2_GEOMETRY_KERNEL(kPlane3DClassify, n);
+    return classify_points(m_floats, src, n, threshold, mask);
+}
+
+void Plane3D::distances_to(const ExecutionPolicy &policy, const Point3D *src, size_t n, tf2Scalar *des) const {
+    TF2_GEOMETRY_KERNEL(kPlane3DDistances, n);
+    policy.for_each(n, [&](size_t begin, size_t end) { plane_distances(m_floats, src + begin, end - begin, des + begin); });
+}
+
+size_t Plane3D::classify(const ExecutionPolicy &policy, const Point3D *src, size_t n, tf2Scalar threshold, uint8_t *mask) const {
+    TF2_GEOMETRY_KERNEL(kPlane3DClassify, n);
+    std::atomic<size_t> count{0};
+    policy.for_each(n, [&](size_t begin, size_t end) {
+        count.fetch_add(classify_points(m_floats, src + begin, end - begin, threshold, mask + begin), std::memory_order_relaxed);
+    });
+    return count.load();
+}
+
+size_t Plane3D::inliers(const Point3D *src, size_t n, tf2Scalar threshold, uint32_t *inliers, uint32_t *outliers) const {
+    tf2Scalar distances[kBlockSize];
+    size_t count = 0, count_outliers = 0;
+    for (size_t i0 = 0; i0 < n; i0 += kBlockSize) {
+        const size_t m = std::min(kBlockSize, n - i0);
+        plane_distances(m_floats, src + i0, m, distances);
+        for (size_t k = 0; k < m; k++) {
+            if (std::fabs(distances[k]) <= threshold) {
+                inliers[count++] = static_cast<uint32_t>(i0 + k);
+            } else if (outliers) {
+                outliers[count_outliers++] = static_cast<uint32_t>(i0 + k);
+            }
+        }
+    }
+    return count;
+}
+
+bool Plane3D::classify(const Plane3D *planes, size_t m, const Point3D *src, size_t n, tf2Scalar threshold, uint8_t *mask) {
+    /// one bit per plane
+    if (m > 8) {
+        return false;
+    }
+    TF2_GEOMETRY_KERNEL(kPlane3DClassify, n * m);
+    tf2Scalar distances[kBlockSize];
+    for (size_t i0 = 0; i0 < n; i0 += kBlockSize) {
+        const size_t l = std::min(kBlockSize, n - i0);
+        std::fill(mask + i0, mask + i0 + l, 0);
+        for (size_t j = 0; j < m; j++) {
+            plane_distances(planes[j].m_floats, src + i0, l, distances);
+            const uint8_t bit = static_cast<uint8_t>(1u << j);
+            for (size_t k = 0; k < l; k++) {
+                mask[i0 + k] |= (std::fabs(distances[k]) <= threshold) ? bit : 0;
+            }
+        }
+    }
+    return true;
 }
 
 Point3D &Plane3D::closest_point_on_plane(const Point3D &src, Point3D &des) const {
@@ -0,0 +1,133 @@
+#include "tf2_geometry/plane3d_array.hpp"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/instrumentation.hpp"
+#include <algorithm>
+#include <atomic>
+
+using namespace tf2;
+
+Plane3DArray::Plane3DArray() : m_size(0) {}
+
+Plane3DArray::Plane3DArray(const Plane3D *planes, size_t n) : m_size(0) {
+    assign(planes, n);
+}
+
+void Plane3DArray::assign(const Plane3D *planes, size_t n) {
+    clear();
+    m_lanes.reserve((n + 3) / 4);
+    for (size_t i = 0; i < n; i++) {
+        push_back(planes[i]);
+    }
+}
+
+void Plane3DArray::push_back(const Plane3D &plane) {
+    const size_t k = m_size % 4;
+    if (k == 0) {
+        m_lanes.push_back(Lane{{0., 0., 0., 0.}, {0., 0., 0., 0.}, {0., 0., 0., 0.}, {1., 1., 1., 1.}});
+    }
+    Lane &lane = m_lanes.back();
+    lane.a[k] = plane.a(), lane.b[k] = plane.b(), lane.c[k] = plane.c(), lane.d[k] = plane.d();
+    m_size++;
+}
+
+void Plane3DArray::clear() {
+    m_lanes.clear();
+    m_size = 0;
+}
+
+size_t Plane3DArray::size() const {
+    return m_size;
+}
+
+Plane3D Plane3DArray::plane(size_t i) const {
+    const Lane &lane = m_lanes[i / 4];
+    const size_t k = i % 4;
+    return Plane3D(lane.a[k], lane.b[k], lane.c[k], lane.d[k]);
+}
+
+const std::vector<Plane3DArray::Lane> &Plane3DArray::lanes() const {
+    return m_lanes;
+}
+
+void Plane3DArray::distances_to(const Point3D &p, tf2Scalar *des) const {
+    const tf2Scalar x = p.m_floats[0], y = p.m_floats[1], z = p.m_floats[2];
+    for (size_t l = 0; l < m_lanes.size(); l++) {
+        const Lane &lane = m_lanes[l];
+        const size_t m = std::min<size_t>(4, m_size - 4 * l);
+        for (size_t k = 0; k < m; k++) {
+            des[4 * l + k] = lane.a[k] * x + lane.b[k] * y + lane.c[k] * z + lane.d[k];
+        }
+    }
+}
+
+bool Plane3DArray::contains(const Point3D &p, tf2Scalar tolerance) const {
+    const tf2Scalar x = p.m_floats[0], y = p.m_floats[1], z = p.m_floats[2];
+#if defined(TF2_GEOMETRY_SIMD_AVX)
+    const __m256d vx = _mm256_set1_pd(x), vy = _mm256_set1_pd(y), vz = _mm256_set1_pd(z), vt = _mm256_set1_pd(-tolerance);
+    for (const Lane &lane : m_lanes) {
+        const __m256d d = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_load_pd(lane.a), vx), _mm256_mul_pd(_mm256_load_pd(lane.b), vy)),
+                                        _mm256_add_pd(_mm256_mul_pd(_mm256_load_pd(lane.c), vz), _mm256_load_pd(lane.d)));
+        if (_mm256_movemask_pd(_mm256_cmp_pd(d, vt, _CMP_LT_OQ))) {
+            return false;
+        }
+    }
+#elif defined(TF2_GEOMETRY_SIMD_SSE2)
+    const __m128d vx = _mm_set1_pd(x), vy = _mm_set1_pd(y), vz = _mm_set1_pd(z), vt = _mm_set1_pd(-tolerance);
+    for (const Lane &lane : m_lanes) {
+        for (size_t k = 0; k < 4; k += 2) {
+            const __m128d d = _mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_load_pd(lane.a + k), vx), _mm_mul_pd(_mm_load_pd(lane.b + k), vy)),
+                                         _mm_add_pd(_mm_mul_pd(_mm_load_pd(lane.c + k), vz), _mm_load_pd(lane.d + k)));
+            if (_mm_movemask_pd(_mm_cmplt_pd(d, vt))) {
+                return false;
+            }
+        }
+    }
+#elif defined(TF2_GEOMETRY_SIMD_NEON)
+    const float64x2_t vt = vdupq_n_f64(-tolerance);
+    for (const Lane &lane : m_lanes) {
+        for (size_t k = 0; k < 4; k += 2) {
+            float64x2_t d = vfmaq_n_f64(vld1q_f64(lane.d + k), vld1q_f64(lane.a + k), x);
+            d = vfmaq_n_f64(d, vld1q_f64(lane.b + k), y);
+            d = vfmaq_n_f64(d, vld1q_f64(lane.c + k), z);
+            /// there is no across vector max for u64, the two lanes are combined instead
+            const uint64x2_t outside = vcltq_f64(d, vt);
+            if (vgetq_lane_u64(outside, 0) | vgetq_lane_u64(outside, 1)) {
+                return false;
+            }
+        }
+    }
+#else
+    for (const Lane &lane : m_lanes) {
+        for (size_t k = 0; k < 4; k++) {
+            if (lane.a[k] * x + lane.b[k] * y + lane.c[k] * z + lane.d[k] < -tolerance) {
+                return false;
+            }
+        }
+    }
+#endif
+    return true;
+}
+
+size_t Plane3DArray::contains(const Point3D *points, size_t n, uint8_t *mask, tf2Scalar tolerance) const {
+    TF2_GEOMETRY_KERNEL(kPlane3DArrayContains, n);
+    return contains_range(points, n, mask, tolerance);
+}
+
+size_t Plane3DArray::contains(const ExecutionPolicy &policy, const Point3D *points, size_t n, uint8_t *mask, tf2Scalar tolerance) const {
+    TF2_GEOMETRY_KERNEL(kPlane3DArrayContains, n);
+    std::atomic<size_t> count{0};
+    policy.for_each(n, [&](size_t begin, size_t end) {
+        count.fetch_add(contains_range(points + begin, end - begin, mask + begin, tolerance), std::memory_order_relaxed);
+    });
+    return count.load();
+}
+
+size_t Plane3DArray::contains_range(const Point3D *points, size_t n, uint8_t *mask, tf2Scalar tolerance) const {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        const uint8_t inside = contains(points[i], tolerance);
+        mask[i] = inside;
+        count += inside;
+    }
+    return count;
+}
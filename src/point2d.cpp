@@ -35,6 +35,15 @@ tf2Scalar Point2D::distance_to(const tf2Scalar &x0, const tf2Scalar &y0) const {
     return  Vector2(x0 - this->x(), y0 - this->y()).length();
 }
 
+tf2Scalar Point2D::distance_to_sqrt(const Point2D &p0) const {
+    return distance_to_sqrt(p0.x(), p0.y());
+}
+
+tf2Scalar Point2D::distance_to_sqrt(const tf2Scalar &x0, const tf2Scalar &y0) const {
+    const tf2Scalar dx = x0 - this->x(), dy = y0 - this->y();
+    return dx * dx + dy * dy;
+}
+
 Point2D& Point2D::operator=(const Vector2 &v) {
     m_floats[0] = v[0];
     m_floats[1] = v[1];
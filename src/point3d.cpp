@@ -21,10 +21,10 @@ tf2Scalar &Point3D::y() {
 }
 
 const tf2Scalar &Point3D::z() const {
-    return m_floats[1];
+    return m_floats[2];
 }
 tf2Scalar &Point3D::z() {
-    return m_floats[1];
+    return m_floats[2];
 }
 /**
  * returns the distance to an other point
@@ -0,0 +1,198 @@
+#include "tf2_geometry/ransac_plane3d.hpp"
+#include "tf2_geometry/instrumentation.hpp"
+#include "tf2_geometry/moments3d.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace tf2;
+
+namespace {
+/// points scored per block
+constexpr size_t kBlockSize = 256;
+
+/**
+ * splitmix64 step used to draw reproducible samples
+ * @param state generator state
+ * @return random number
+ **/
+uint64_t splitmix64(uint64_t &state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+}  // namespace
+
+RansacPlane3D::RansacPlane3D() : m_iterations(0), m_cost(0) {
+    configure(Config());
+}
+
+RansacPlane3D::RansacPlane3D(const Config &config) : m_iterations(0), m_cost(0) {
+    configure(config);
+}
+
+RansacPlane3D::RansacPlane3D(const Config &config, std::pmr::memory_resource *resource)
+    : m_batch_cost(resource), m_batch_inliers(resource), m_batch_planes(resource), m_inliers(resource),
+      m_refined_inliers(resource), m_iterations(0), m_cost(0) {
+    configure(config);
+}
+
+void RansacPlane3D::configure(const Config &config) {
+    m_config = config;
+    m_config.batch_size = std::max<size_t>(1, m_config.batch_size);
+    m_config.num_threads = std::max<size_t>(1, m_config.num_threads);
+    m_batch_cost.resize(m_config.batch_size);
+    m_batch_inliers.resize(m_config.batch_size);
+    m_batch_planes.resize(m_config.batch_size, Plane3D(0., 0., 0., 0.));
+}
+
+const RansacPlane3D::Config &RansacPlane3D::config() const {
+    return m_config;
+}
+
+void RansacPlane3D::set_execution_policy(const ExecutionPolicy &policy) {
+    m_execution = policy;
+}
+
+const std::pmr::vector<uint32_t> &RansacPlane3D::inliers() const {
+    return m_inliers;
+}
+
+size_t RansacPlane3D::iterations() const {
+    return m_iterations;
+}
+
+tf2Scalar RansacPlane3D::cost() const {
+    return m_cost;
+}
+
+bool RansacPlane3D::estimate(const std::vector<Point3D> &points, Plane3D &des) {
+    return estimate(points.data(), points.size(), des);
+}
+
+bool RansacPlane3D::estimate(const Point3D *points, size_t n, Plane3D &des) {
+    TF2_GEOMETRY_KERNEL(kRansacPlane3DEstimate, n);
+    const tf2Scalar infinity = std::numeric_limits<tf2Scalar>::infinity();
+    m_inliers.clear();
+    m_iterations = 0;
+    m_cost = infinity;
+    if (n < 3) {
+        return false;
+    }
+
+    Plane3D best(0., 0., 0., 0.);
+    size_t best_inliers = 0;
+    size_t limit = m_config.max_iterations;
+    for (size_t k0 = 0; k0 < limit; k0 += m_config.batch_size) {
+        const size_t b = std::min(m_config.batch_size, limit - k0);
+        /// the bailout only depends on previous batches to keep the result independent of the thread timing
+        const tf2Scalar bailout = m_cost;
+        const size_t num_tasks = std::min(m_config.num_threads, b);
+        if (num_tasks == 1) {
+            for (size_t s = 0; s < b; s++) {
+                evaluate(points, n, k0 + s, bailout, s);
+            }
+        } else {
+            const ExecutionPolicy policy = m_execution ? *m_execution : ExecutionPolicy::thread_pool(ThreadPool::shared());
+            policy.for_each(b, (b + num_tasks - 1) / num_tasks, [this, points, n, k0, bailout](size_t begin, size_t end) {
+                for (size_t s = begin; s < end; s++) {
+                    evaluate(points, n, k0 + s, bailout, s);
+                }
+            });
+        }
+        for (size_t s = 0; s < b; s++) {
+            if (m_batch_cost[s] < m_cost) {
+                m_cost = m_batch_cost[s];
+                best_inliers = m_batch_inliers[s];
+                best = m_batch_planes[s];
+            }
+        }
+        m_iterations = k0 + b;
+
+        /// adapts the number of iterations to the inlier ratio
+        if (best_inliers >= 3) {
+            const tf2Scalar w = static_cast<tf2Scalar>(best_inliers) / static_cast<tf2Scalar>(n);
+            const tf2Scalar p = w * w * w;
+            if (p >= 1.0) {
+                limit = m_iterations;
+            } else if (p > 0.0) {
+                const tf2Scalar required = std::log(1.0 - m_config.confidence) / std::log(1.0 - p);
+                if (required < static_cast<tf2Scalar>(limit)) {
+                    limit = std::max(m_iterations, static_cast<size_t>(std::ceil(required)));
+                }
+            }
+        }
+    }
+    if (m_cost == infinity) {
+        return false;
+    }
+
+    des = best;
+    des.inliers(points, n, m_config.threshold, m_inliers);
+    if (m_config.refine) {
+        Plane3D refined(0., 0., 0., 0.);
+        if (fit(points, m_inliers.data(), m_inliers.size(), refined)) {
+            std::pmr::vector<uint32_t> &inliers = m_refined_inliers;
+            refined.inliers(points, n, m_config.threshold, inliers);
+            if (inliers.size() >= m_inliers.size()) {
+                des = refined;
+                m_inliers.swap(inliers);
+            }
+        }
+    }
+    return true;
+}
+
+void RansacPlane3D::evaluate(const Point3D *points, size_t n, uint64_t k, tf2Scalar bailout, size_t slot) {
+    const tf2Scalar infinity = std::numeric_limits<tf2Scalar>::infinity();
+    m_batch_cost[slot] = infinity;
+    m_batch_inliers[slot] = 0;
+
+    /// the sample depends only on the seed and the hypothesis index
+    uint64_t state = m_config.seed ^ (k * 0xD1B54A32D192ED03ull);
+    uint32_t idx[3];
+    for (int j = 0; j < 3; j++) {
+        int attempts = 0;
+        do {
+            idx[j] = static_cast<uint32_t>(splitmix64(state) % n);
+        } while (((j > 0 && idx[j] == idx[0]) || (j > 1 && idx[j] == idx[1])) && ++attempts < 16);
+    }
+    const Vector3 normal = (points[idx[1]] - points[idx[0]]).cross(points[idx[2]] - points[idx[0]]);
+    if (normal.length2() <= std::numeric_limits<tf2Scalar>::epsilon()) {
+        return;  /// degenerated sample
+    }
+    Plane3D &plane = m_batch_planes[slot];
+    plane.create(points[idx[0]], normal);
+
+    tf2Scalar distances[kBlockSize];
+    const tf2Scalar t2 = m_config.threshold * m_config.threshold;
+    tf2Scalar cost = 0;
+    size_t inliers = 0;
+    for (size_t i0 = 0; i0 < n; i0 += kBlockSize) {
+        const size_t m = std::min(kBlockSize, n - i0);
+        plane.distances_to(points + i0, m, distances);
+        for (size_t i = 0; i < m; i++) {
+            const tf2Scalar d2 = distances[i] * distances[i];
+            if (d2 <= t2) {
+                inliers++;
+                cost += m_config.msac ? d2 : 0.0;
+            } else {
+                cost += t2;
+            }
+        }
+        if (cost > bailout) {
+            return;  /// can not beat the best hypothesis anymore
+        }
+    }
+    m_batch_cost[slot] = cost;
+    m_batch_inliers[slot] = inliers;
+}
+
+bool RansacPlane3D::fit(const Point3D *points, const uint32_t *indices, size_t n, Plane3D &des) {
+    Moments3D moments;
+    for (size_t i = 0; i < n; i++) {
+        moments.add(points[indices[i]]);
+    }
+    return moments.fit(des);
+}
@@ -0,0 +1,157 @@
+#include "tf2_geometry/scan_matcher2d.hpp"
+#include "tf2_geometry/instrumentation.hpp"
+#include "tf2_geometry/utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+using namespace tf2;
+
+namespace {
+/// budgets above this many seconds count as no limit, the deadline stays within the clock range
+constexpr tf2Scalar kMaxTimeBudget = 1e6;
+
+/**
+ * inverts a symmetric 3 x 3 matrix
+ * @return false if the matrix is singular
+ **/
+bool invert3(const tf2Scalar *m, tf2Scalar *des) {
+    const tf2Scalar c00 = m[4] * m[8] - m[5] * m[7], c01 = m[5] * m[6] - m[3] * m[8], c02 = m[3] * m[7] - m[4] * m[6];
+    const tf2Scalar det = m[0] * c00 + m[1] * c01 + m[2] * c02;
+    if (!(std::fabs(det) > 0.0)) {
+        return false;
+    }
+    const tf2Scalar s = 1.0 / det;
+    des[0] = c00 * s, des[1] = (m[2] * m[7] - m[1] * m[8]) * s, des[2] = (m[1] * m[5] - m[2] * m[4]) * s;
+    des[3] = c01 * s, des[4] = (m[0] * m[8] - m[2] * m[6]) * s, des[5] = (m[2] * m[3] - m[0] * m[5]) * s;
+    des[6] = c02 * s, des[7] = (m[1] * m[6] - m[0] * m[7]) * s, des[8] = (m[0] * m[4] - m[1] * m[3]) * s;
+    return true;
+}
+}  // namespace
+
+ScanMatcher2D::ScanMatcher2D() {
+    configure(Config());
+}
+
+ScanMatcher2D::ScanMatcher2D(const Config &config) {
+    configure(config);
+}
+
+void ScanMatcher2D::configure(const Config &config) {
+    m_config = config;
+    if (!(m_config.time_budget > 0.0 && m_config.time_budget <= kMaxTimeBudget)) {
+        m_config.time_budget = 0.0;
+    }
+}
+
+const ScanMatcher2D::Config &ScanMatcher2D::config() const {
+    return m_config;
+}
+
+void ScanMatcher2D::set_reference(const Point2D *points, size_t n) {
+    const tf2Scalar gap2 = m_config.max_gap * m_config.max_gap;
+    m_segments.clear();
+    for (size_t i = 1; i < n; i++) {
+        const Point2D &p0 = points[i - 1], &p1 = points[i];
+        const tf2Scalar dx = p1.x() - p0.x(), dy = p1.y() - p0.y();
+        if (dx * dx + dy * dy <= gap2) {
+            m_segments.push_back(SegmentIndex2D::Segment{p0.x(), p0.y(), p1.x(), p1.y()});
+        }
+    }
+    m_reference.build(m_segments.data(), m_segments.size(), m_config.cell_size);
+}
+
+const SegmentIndex2D &ScanMatcher2D::reference() const {
+    return m_reference;
+}
+
+bool ScanMatcher2D::match(const Point2D *scan, size_t n, const Transform2D &guess, Result &des) {
+    return match(m_reference, scan, n, guess, des);
+}
+
+bool ScanMatcher2D::match(const SegmentIndex2D &map, const Point2D *scan, size_t n, const Transform2D &guess, Result &des) {
+    TF2_GEOMETRY_KERNEL(kScanMatcher2DMatch, n);
+    using clock = std::chrono::steady_clock;
+    const bool limited = m_config.time_budget > 0.0;
+    const clock::time_point deadline =
+        limited ? clock::now() + std::chrono::duration_cast<clock::duration>(std::chrono::duration<tf2Scalar>(m_config.time_budget))
+                : clock::time_point::max();
+    const SegmentIndex2D::Segment *segments = map.segments();
+    const tf2Scalar huber = m_config.huber;
+    tf2Scalar x = guess.x(), y = guess.y(), theta = guess.rotation();
+    tf2Scalar H[9], H_inv[9], g[3];
+    bool valid = false;
+    des.iterations = 0, des.correspondences = 0, des.error = 0.0, des.converged = false;
+    des.covariance.fill(0.0);
+
+    for (size_t it = 0; it < m_config.max_iterations; it++) {
+        const tf2Scalar c = std::cos(theta), s = std::sin(theta);
+        std::fill(H, H + 9, 0.0), std::fill(g, g + 3, 0.0);
+        size_t m = 0;
+        tf2Scalar sum_r2 = 0.0, sum_wr2 = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            const tf2Scalar qx = c * scan[i].x() - s * scan[i].y(), qy = s * scan[i].x() + c * scan[i].y();
+            const Point2D p(qx + x, qy + y);
+            const size_t k = map.nearest(p, m_config.max_correspondence_distance);
+            if (k == SegmentIndex2D::npos) {
+                continue;
+            }
+            /// normal of the line through the segment, a degenerated segment acts as a point
+            const SegmentIndex2D::Segment &seg = segments[k];
+            tf2Scalar nx = seg.y0 - seg.y1, ny = seg.x1 - seg.x0;
+            tf2Scalar norm = std::sqrt(nx * nx + ny * ny);
+            if (norm == 0.0) {
+                nx = p.x() - seg.x0, ny = p.y() - seg.y0, norm = std::sqrt(nx * nx + ny * ny);
+                if (norm == 0.0) {
+                    nx = 1.0, norm = 1.0;
+                }
+            }
+            nx /= norm, ny /= norm;
+            const tf2Scalar r = nx * (p.x() - seg.x0) + ny * (p.y() - seg.y0);
+            const tf2Scalar w = (huber > 0.0 && std::fabs(r) > huber) ? huber / std::fabs(r) : 1.0;
+            /// d r / d (x, y, theta), the rotation moves the point along the perpendicular of q
+            const tf2Scalar J[3] = {nx, ny, ny * qx - nx * qy};
+            for (int a = 0; a < 3; a++) {
+                g[a] += w * J[a] * r;
+                for (int b = a; b < 3; b++) {
+                    H[a * 3 + b] += w * J[a] * J[b];
+                }
+            }
+            sum_r2 += r * r, sum_wr2 += w * r * r;
+            m++;
+        }
+        H[3] = H[1], H[6] = H[2], H[7] = H[5];
+        des.correspondences = m;
+        des.error = m > 0 ? std::sqrt(sum_r2 / m) : 0.0;
+        if (m < std::max<size_t>(3, m_config.min_correspondences)) {
+            valid = false;
+            break;
+        }
+        /// a little damping keeps degenerated geometries such as corridors solvable
+        const tf2Scalar damping = 1e-9 * (H[0] + H[4] + H[8]);
+        H[0] += damping, H[4] += damping, H[8] += damping;
+        if (!invert3(H, H_inv)) {
+            valid = false;
+            break;
+        }
+        valid = true;
+        const tf2Scalar variance = sum_wr2 / static_cast<tf2Scalar>(std::max<size_t>(1, m - 3));
+        for (int a = 0; a < 9; a++) {
+            des.covariance[a] = variance * H_inv[a];
+        }
+        const tf2Scalar dx = -(H_inv[0] * g[0] + H_inv[1] * g[1] + H_inv[2] * g[2]);
+        const tf2Scalar dy = -(H_inv[3] * g[0] + H_inv[4] * g[1] + H_inv[5] * g[2]);
+        const tf2Scalar dtheta = -(H_inv[6] * g[0] + H_inv[7] * g[1] + H_inv[8] * g[2]);
+        x += dx, y += dy, theta += dtheta;
+        des.iterations = it + 1;
+        if (std::sqrt(dx * dx + dy * dy) < m_config.epsilon_translation && std::fabs(dtheta) < m_config.epsilon_rotation) {
+            des.converged = true;
+            break;
+        }
+        if (limited && clock::now() > deadline) {
+            break;
+        }
+    }
+    des.pose.set(x, y, angle_normalize(theta));
+    return valid && des.converged;
+}
@@ -0,0 +1,219 @@
+#include "tf2_geometry/segment_index2d.hpp"
+#include "tf2_geometry/execution.hpp"
+#include <atomic>
+#include <cmath>
+
+using namespace tf2;
+
+constexpr size_t SegmentIndex2D::npos;
+
+namespace {
+/// upper limit for the grid cells, bounds the memory of the cell offsets
+constexpr tf2Scalar kMaxCells = 1 << 24;
+}  // namespace
+
+SegmentIndex2D::SegmentIndex2D() : m_segments(nullptr), m_size(0), m_cells(nullptr), m_items(nullptr) {}
+
+bool SegmentIndex2D::build(const LineSegment2D *segments, size_t n, tf2Scalar cell_size) {
+    std::vector<Segment> records(n);
+    for (size_t i = 0; i < n; i++) {
+        records[i] = Segment{segments[i].x0(), segments[i].y0(), segments[i].x1(), segments[i].y1()};
+    }
+    return build(records.data(), n, cell_size);
+}
+
+bool SegmentIndex2D::build(const Segment *segments, size_t n, tf2Scalar cell_size) {
+    auto reject = [this]() {
+        m_segment_storage.clear(), m_cell_storage.clear(), m_item_storage.clear();
+        view(Grid(), nullptr, 0, nullptr, nullptr);
+        return false;
+    };
+    if (!(cell_size > 0)) {
+        return reject();
+    }
+    Grid grid;
+    grid.cell_size = cell_size;
+    if (n > 0) {
+        tf2Scalar x_min = segments[0].x0, y_min = segments[0].y0, x_max = x_min, y_max = y_min;
+        for (size_t i = 0; i < n; i++) {
+            const Segment &s = segments[i];
+            if (!std::isfinite(s.x0) || !std::isfinite(s.y0) || !std::isfinite(s.x1) || !std::isfinite(s.y1)) {
+                return reject();
+            }
+            x_min = std::min({x_min, s.x0, s.x1}), x_max = std::max({x_max, s.x0, s.x1});
+            y_min = std::min({y_min, s.y0, s.y1}), y_max = std::max({y_max, s.y0, s.y1});
+        }
+        /// the cell counts are checked as floating point values before the casts
+        const tf2Scalar cols = std::floor((x_max - x_min) / cell_size) + 1.0;
+        const tf2Scalar rows = std::floor((y_max - y_min) / cell_size) + 1.0;
+        if (!(cols * rows <= kMaxCells)) {
+            return reject();
+        }
+        grid.origin_x = x_min, grid.origin_y = y_min;
+        grid.cols = static_cast<uint32_t>(cols), grid.rows = static_cast<uint32_t>(rows);
+    }
+    m_segment_storage.assign(segments, segments + n);
+    m_grid = grid;
+    const size_t cells = static_cast<size_t>(grid.cols) * grid.rows;
+
+    /// a segment is registered in a cell if it passes the circle around the cell
+    const tf2Scalar half_diagonal = cell_size * std::sqrt(0.5);
+    const tf2Scalar r2 = half_diagonal * half_diagonal;
+    auto for_each_cell = [&](const Segment &s, auto f) {
+        const uint32_t c0 = static_cast<uint32_t>((std::min(s.x0, s.x1) - grid.origin_x) / cell_size);
+        const uint32_t c1 = static_cast<uint32_t>((std::max(s.x0, s.x1) - grid.origin_x) / cell_size);
+        const uint32_t r0 = static_cast<uint32_t>((std::min(s.y0, s.y1) - grid.origin_y) / cell_size);
+        const uint32_t r1 = static_cast<uint32_t>((std::max(s.y0, s.y1) - grid.origin_y) / cell_size);
+        for (uint32_t r = r0; r <= r1 && r < grid.rows; r++) {
+            const tf2Scalar y = grid.origin_y + (r + 0.5) * cell_size;
+            for (uint32_t c = c0; c <= c1 && c < grid.cols; c++) {
+                const tf2Scalar x = grid.origin_x + (c + 0.5) * cell_size;
+                if (distance_sqrt(s, x, y) <= r2) {
+                    f(static_cast<size_t>(r) * grid.cols + c);
+                }
+            }
+        }
+    };
+
+    /// two passes, counting and filling, build the compressed rows without reallocation
+    m_cell_storage.assign(cells + 1, 0);
+    for (size_t i = 0; i < n; i++) {
+        for_each_cell(segments[i], [this](size_t cell) { m_cell_storage[cell + 1]++; });
+    }
+    for (size_t i = 0; i < cells; i++) {
+        m_cell_storage[i + 1] += m_cell_storage[i];
+    }
+    m_item_storage.resize(m_cell_storage[cells]);
+    std::vector<uint32_t> fill(m_cell_storage.begin(), m_cell_storage.end() - 1);
+    for (size_t i = 0; i < n; i++) {
+        for_each_cell(segments[i], [this, &fill, i](size_t cell) { m_item_storage[fill[cell]++] = static_cast<uint32_t>(i); });
+    }
+    view(grid, m_segment_storage.data(), n, m_cell_storage.data(), m_item_storage.data());
+    return true;
+}
+
+void SegmentIndex2D::view(const Grid &grid, const Segment *segments, size_t n, const uint32_t *cells, const uint32_t *items) {
+    m_grid = grid;
+    m_segments = segments, m_size = n;
+    m_cells = cells, m_items = items;
+}
+
+size_t SegmentIndex2D::size() const {
+    return m_size;
+}
+
+const SegmentIndex2D::Grid &SegmentIndex2D::grid() const {
+    return m_grid;
+}
+
+const SegmentIndex2D::Segment *SegmentIndex2D::segments() const {
+    return m_segments;
+}
+
+const uint32_t *SegmentIndex2D::cells() const {
+    return m_cells;
+}
+
+const uint32_t *SegmentIndex2D::items() const {
+    return m_items;
+}
+
+LineSegment2D SegmentIndex2D::segment(size_t i) const {
+    const Segment &s = m_segments[i];
+    return LineSegment2D(s.x0, s.y0, s.x1, s.y1);
+}
+
+tf2Scalar SegmentIndex2D::distance_sqrt(const Segment &s, tf2Scalar x, tf2Scalar y) {
+    const tf2Scalar px = s.x1 - s.x0, py = s.y1 - s.y0;
+    const tf2Scalar l2 = px * px + py * py;
+    tf2Scalar u = l2 > 0 ? ((x - s.x0) * px + (y - s.y0) * py) / l2 : 0;
+    u = std::min<tf2Scalar>(1, std::max<tf2Scalar>(0, u));
+    const tf2Scalar dx = s.x0 + u * px - x, dy = s.y0 + u * py - y;
+    return dx * dx + dy * dy;
+}
+
+bool SegmentIndex2D::cell_range(tf2Scalar x0, tf2Scalar y0, tf2Scalar x1, tf2Scalar y1, uint32_t &c0, uint32_t &r0, uint32_t &c1, uint32_t &r1) const {
+    const tf2Scalar s = m_grid.cell_size;
+    const tf2Scalar fc0 = std::floor((x0 - m_grid.origin_x) / s), fc1 = std::floor((x1 - m_grid.origin_x) / s);
+    const tf2Scalar fr0 = std::floor((y0 - m_grid.origin_y) / s), fr1 = std::floor((y1 - m_grid.origin_y) / s);
+    if (m_grid.cols == 0 || fc1 < 0 || fr1 < 0 || fc0 >= m_grid.cols || fr0 >= m_grid.rows) {
+        return false;
+    }
+    c0 = static_cast<uint32_t>(std::max<tf2Scalar>(0, fc0)), c1 = static_cast<uint32_t>(std::min<tf2Scalar>(m_grid.cols - 1, fc1));
+    r0 = static_cast<uint32_t>(std::max<tf2Scalar>(0, fr0)), r1 = static_cast<uint32_t>(std::min<tf2Scalar>(m_grid.rows - 1, fr1));
+    return true;
+}
+
+size_t SegmentIndex2D::nearest(const Point2D &p, tf2Scalar max_distance, tf2Scalar *distance) const {
+    size_t best = npos;
+    tf2Scalar best_d2 = max_distance * max_distance;
+    /// NaN or infinite points and NaN or negative radii find nothing, an infinite radius searches the whole grid
+    if (m_grid.cols == 0 || !std::isfinite(p.x()) || !std::isfinite(p.y()) || !(max_distance >= 0)) {
+        return npos;
+    }
+    const tf2Scalar s = m_grid.cell_size;
+    const tf2Scalar fc = std::floor((p.x() - m_grid.origin_x) / s), fr = std::floor((p.y() - m_grid.origin_y) / s);
+    const tf2Scalar gap_x = std::max<tf2Scalar>(0, std::max(-fc, fc - (m_grid.cols - 1)) - 1) * s;
+    const tf2Scalar gap_y = std::max<tf2Scalar>(0, std::max(-fr, fr - (m_grid.rows - 1)) - 1) * s;
+    if (gap_x * gap_x + gap_y * gap_y > best_d2) {
+        return npos;
+    }
+    /// points outside of the grid start next to it, rings around that cell still bound the distance from below
+    const int64_t pc = static_cast<int64_t>(std::min<tf2Scalar>(m_grid.cols, std::max<tf2Scalar>(-1, fc)));
+    const int64_t pr = static_cast<int64_t>(std::min<tf2Scalar>(m_grid.rows, std::max<tf2Scalar>(-1, fr)));
+    /// the grid lies within max(cols, rows) + 1 rings of that cell
+    const int64_t rings = static_cast<int64_t>(std::min<tf2Scalar>(std::ceil(max_distance / s), std::max(m_grid.cols, m_grid.rows))) + 1;
+    /// searches ring by ring around the cell of p, segments outside of ring k are at least k cells away
+    for (int64_t k = 0; k <= rings; k++) {
+        if (best != npos && best_d2 <= (k - 1) * s * (k - 1) * s) {
+            break;
+        }
+        for (int64_t r = pr - k; r <= pr + k; r++) {
+            if (r < 0 || r >= m_grid.rows) {
+                continue;
+            }
+            const bool edge_row = (r == pr - k) || (r == pr + k);
+            for (int64_t c = pc - k; c <= pc + k; c += (edge_row || k == 0) ? 1 : 2 * k) {
+                if (c < 0 || c >= m_grid.cols) {
+                    continue;
+                }
+                const size_t cell = static_cast<size_t>(r) * m_grid.cols + static_cast<size_t>(c);
+                for (uint32_t j = m_cells[cell]; j < m_cells[cell + 1]; j++) {
+                    const uint32_t i = m_items[j];
+                    const tf2Scalar d2 = distance_sqrt(m_segments[i], p.x(), p.y());
+                    if (d2 <= best_d2 && (best == npos || d2 < best_d2 || i < best)) {
+                        best = i, best_d2 = d2;
+                    }
+                }
+            }
+        }
+    }
+    if (best != npos && distance) {
+        *distance = std::sqrt(best_d2);
+    }
+    return best;
+}
+
+size_t SegmentIndex2D::nearest(const Point2D *points, size_t n, tf2Scalar max_distance, size_t *indices, tf2Scalar *distances) const {
+    const tf2Scalar infinity = std::numeric_limits<tf2Scalar>::infinity();
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        tf2Scalar d = infinity;
+        indices[i] = nearest(points[i], max_distance, &d);
+        if (distances) {
+            distances[i] = indices[i] == npos ? infinity : d;
+        }
+        count += indices[i] != npos;
+    }
+    return count;
+}
+
+size_t SegmentIndex2D::nearest(const ExecutionPolicy &policy, const Point2D *points, size_t n, tf2Scalar max_distance, size_t *indices,
+                               tf2Scalar *distances) const {
+    std::atomic<size_t> count{0};
+    policy.for_each(n, [&](size_t begin, size_t end) {
+        const size_t c = nearest(points + begin, end - begin, max_distance, indices + begin, distances ? distances + begin : nullptr);
+        count.fetch_add(c, std::memory_order_relaxed);
+    });
+    return count.load();
+}
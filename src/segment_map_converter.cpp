@@ -0,0 +1,83 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "tf2_geometry/segment_map_file.hpp"
+
+/**
+ * converts a text segment map into a binary segment map with a prebuilt index and back.
+ * The text format has one segment "x0 y0 x1 y1" per line, lines starting with # are ignored.
+ * usage: segment_map_converter <input> <output> [cell_size]
+ * The direction is detected from the input, a binary input is written as text.
+ **/
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <input> <output> [cell_size]" << std::endl;
+        return 1;
+    }
+    const std::string input = argv[1], output = argv[2];
+    const double cell_size = argc > 3 ? std::atof(argv[3]) : 1.0;
+    if (!(cell_size > 0)) {
+        std::cerr << "cell_size must be positive" << std::endl;
+        return 1;
+    }
+
+    char magic[8] = {0};
+    std::ifstream probe(input, std::ios::binary);
+    if (!probe) {
+        std::cerr << "failed to open " << input << std::endl;
+        return 1;
+    }
+    probe.read(magic, sizeof(magic));
+    probe.close();
+
+    tf2::SegmentMapFile file;
+    if (std::memcmp(magic, "TF2SEGM", 8) == 0) {
+        if (!file.read(input)) {
+            std::cerr << file.error() << std::endl;
+            return 1;
+        }
+        std::ofstream text(output);
+        const tf2::SegmentIndex2D &index = file.index();
+        text << "# x0 y0 x1 y1" << std::endl << std::setprecision(17);
+        for (size_t i = 0; i < index.size(); i++) {
+            const tf2::SegmentIndex2D::Segment &s = index.segments()[i];
+            text << s.x0 << ' ' << s.y0 << ' ' << s.x1 << ' ' << s.y1 << '\n';
+        }
+        std::cout << "wrote " << index.size() << " segments to " << output << std::endl;
+        return text ? 0 : 1;
+    }
+
+    std::ifstream text(input);
+    std::vector<tf2::SegmentIndex2D::Segment> segments;
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(text, line)) {
+        line_number++;
+        const size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        std::istringstream ss(line);
+        tf2::SegmentIndex2D::Segment s;
+        if (!(ss >> s.x0 >> s.y0 >> s.x1 >> s.y1)) {
+            std::cerr << input << ":" << line_number << ": expected x0 y0 x1 y1" << std::endl;
+            return 1;
+        }
+        segments.push_back(s);
+    }
+    tf2::SegmentIndex2D index;
+    if (!index.build(segments.data(), segments.size(), cell_size)) {
+        std::cerr << "cell size must be positive" << std::endl;
+        return 1;
+    }
+    if (!file.write(output, index)) {
+        std::cerr << file.error() << std::endl;
+        return 1;
+    }
+    std::cout << "wrote " << index.size() << " segments in " << index.grid().cols << " x " << index.grid().rows << " cells to " << output
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,293 @@
+#include "tf2_geometry/segment_map_file.hpp"
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TF2_GEOMETRY_HAS_MMAP
+#endif
+
+using namespace tf2;
+
+constexpr uint32_t SegmentMapFile::kVersion;
+constexpr uint32_t SegmentMapFile::kEndianMarker;
+
+namespace {
+
+static_assert(std::is_same<tf2Scalar, double>::value, "the file stores doubles");
+static_assert(sizeof(SegmentIndex2D::Segment) == 4 * sizeof(double), "segment records must be packed");
+
+const char kMagic[8] = {'T', 'F', '2', 'S', 'E', 'G', 'M', '\0'};
+/// alignment of the data blocks
+constexpr uint64_t kBlockAlignment = 64;
+
+uint64_t align(uint64_t offset) {
+    return (offset + kBlockAlignment - 1) & ~(kBlockAlignment - 1);
+}
+
+uint32_t swap_bytes(uint32_t v) {
+    return ((v & 0xFF) << 24) | ((v & 0xFF00) << 8) | ((v >> 8) & 0xFF00) | (v >> 24);
+}
+
+uint64_t swap_bytes(uint64_t v) {
+    return (static_cast<uint64_t>(swap_bytes(static_cast<uint32_t>(v))) << 32) | swap_bytes(static_cast<uint32_t>(v >> 32));
+}
+
+double swap_bytes(double v) {
+    uint64_t u;
+    std::memcpy(&u, &v, sizeof(u));
+    u = swap_bytes(u);
+    std::memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+void swap_header(SegmentMapFile::Header &h) {
+    h.version = swap_bytes(h.version), h.endian = swap_bytes(h.endian);
+    h.file_size = swap_bytes(h.file_size), h.segment_count = swap_bytes(h.segment_count), h.item_count = swap_bytes(h.item_count);
+    h.segments_offset = swap_bytes(h.segments_offset), h.cells_offset = swap_bytes(h.cells_offset), h.items_offset = swap_bytes(h.items_offset);
+    h.origin_x = swap_bytes(h.origin_x), h.origin_y = swap_bytes(h.origin_y), h.cell_size = swap_bytes(h.cell_size);
+    h.cols = swap_bytes(h.cols), h.rows = swap_bytes(h.rows);
+}
+
+/**
+ * swaps the data blocks of a file in place
+ * @param data file content
+ * @param h header in native byte order
+ **/
+void swap_blocks(uint8_t *data, const SegmentMapFile::Header &h) {
+    uint64_t *segments = reinterpret_cast<uint64_t *>(data + h.segments_offset);
+    for (uint64_t i = 0; i < 4 * h.segment_count; i++) segments[i] = swap_bytes(segments[i]);
+    uint32_t *cells = reinterpret_cast<uint32_t *>(data + h.cells_offset);
+    for (uint64_t i = 0; i < static_cast<uint64_t>(h.cols) * h.rows + 1; i++) cells[i] = swap_bytes(cells[i]);
+    uint32_t *items = reinterpret_cast<uint32_t *>(data + h.items_offset);
+    for (uint64_t i = 0; i < h.item_count; i++) items[i] = swap_bytes(items[i]);
+}
+
+/**
+ * checks that count elements at offset lie within size bytes without overflowing
+ **/
+bool fits(uint64_t offset, uint64_t count, uint64_t element, uint64_t size) {
+    return offset <= size && count <= (size - offset) / element;
+}
+
+/**
+ * checks that a header in native byte order describes a file of the given size
+ **/
+bool validate(const SegmentMapFile::Header &h, uint64_t size, std::string &error) {
+    const uint64_t cells = static_cast<uint64_t>(h.cols) * h.rows + 1;
+    if (h.version != SegmentMapFile::kVersion) {
+        error = "unsupported version " + std::to_string(h.version);
+    } else if (h.file_size != size) {
+        error = "file size mismatch";
+    } else if (h.segments_offset % 8 || h.cells_offset % 8 || h.items_offset % 8) {
+        error = "misaligned data block";
+    } else if (!fits(h.segments_offset, h.segment_count, sizeof(SegmentIndex2D::Segment), size) ||
+               !fits(h.cells_offset, cells, sizeof(uint32_t), size) || !fits(h.items_offset, h.item_count, sizeof(uint32_t), size)) {
+        error = "data block exceeds the file";
+    } else if (!(h.cell_size > 0)) {
+        error = "invalid cell size";
+    } else {
+        return true;
+    }
+    return false;
+}
+
+/**
+ * checks that the cell offsets ascend from 0 to item_count and that all items refer to a segment
+ **/
+bool validate_blocks(const SegmentMapFile::Header &h, const uint32_t *cells, const uint32_t *items, std::string &error) {
+    const uint64_t n = static_cast<uint64_t>(h.cols) * h.rows;
+    if (cells[0] != 0) {
+        error = "inconsistent cell offsets";
+        return false;
+    }
+    for (uint64_t i = 0; i < n; i++) {
+        if (cells[i] > cells[i + 1]) {
+            error = "inconsistent cell offsets";
+            return false;
+        }
+    }
+    for (uint64_t i = 0; i < h.item_count; i++) {
+        if (items[i] >= h.segment_count) {
+            error = "cell item exceeds the segments";
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+SegmentMapFile::SegmentMapFile() : m_header(), m_mapping(nullptr), m_mapping_size(0) {}
+
+SegmentMapFile::~SegmentMapFile() {
+    close();
+}
+
+bool SegmentMapFile::write(const std::string &path, const SegmentIndex2D &index, bool swap_byte_order) {
+    const SegmentIndex2D::Grid &grid = index.grid();
+    const uint64_t cells = static_cast<uint64_t>(grid.cols) * grid.rows + 1;
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.endian = kEndianMarker;
+    h.segment_count = index.size();
+    h.item_count = index.cells() ? index.cells()[cells - 1] : 0;
+    h.segments_offset = align(sizeof(Header));
+    h.cells_offset = align(h.segments_offset + h.segment_count * sizeof(SegmentIndex2D::Segment));
+    h.items_offset = align(h.cells_offset + cells * sizeof(uint32_t));
+    h.file_size = h.items_offset + h.item_count * sizeof(uint32_t);
+    h.origin_x = grid.origin_x, h.origin_y = grid.origin_y, h.cell_size = grid.cell_size;
+    h.cols = grid.cols, h.rows = grid.rows;
+
+    std::vector<uint64_t> buffer((h.file_size + 7) / 8, 0);
+    uint8_t *data = reinterpret_cast<uint8_t *>(buffer.data());
+    std::memcpy(data + h.segments_offset, index.segments(), h.segment_count * sizeof(SegmentIndex2D::Segment));
+    if (index.cells()) {
+        std::memcpy(data + h.cells_offset, index.cells(), cells * sizeof(uint32_t));
+        std::memcpy(data + h.items_offset, index.items(), h.item_count * sizeof(uint32_t));
+    }
+    if (swap_byte_order) {
+        swap_blocks(data, h);
+        swap_header(h);
+    }
+    std::memcpy(data, &h, sizeof(Header));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(swap_byte_order ? swap_bytes(h.file_size) : h.file_size));
+    if (!file) {
+        m_error = "failed to write " + path;
+        return false;
+    }
+    return true;
+}
+
+bool SegmentMapFile::open(const std::string &path, bool verify) {
+    close();
+#if defined(TF2_GEOMETRY_HAS_MMAP)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        m_error = "failed to open " + path;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(fd);
+        m_error = "invalid file " + path;
+        return false;
+    }
+    void *mapping = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        m_error = "failed to map " + path;
+        return false;
+    }
+    m_mapping = mapping, m_mapping_size = static_cast<size_t>(st.st_size);
+    if (!attach(static_cast<const uint8_t *>(m_mapping), m_mapping_size, verify)) {
+        close();
+        return false;
+    }
+    return true;
+#else
+    return read(path);
+#endif
+}
+
+bool SegmentMapFile::read(const std::string &path) {
+    close();
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        m_error = "failed to open " + path;
+        return false;
+    }
+    const uint64_t size = static_cast<uint64_t>(file.tellg());
+    if (size < sizeof(Header)) {
+        m_error = "invalid file " + path;
+        return false;
+    }
+    m_data.assign((size + 7) / 8, 0);
+    uint8_t *data = reinterpret_cast<uint8_t *>(m_data.data());
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(data), static_cast<std::streamsize>(size));
+    if (!file) {
+        m_error = "failed to read " + path;
+        return false;
+    }
+    Header h;
+    std::memcpy(&h, data, sizeof(Header));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) == 0 && h.endian == swap_bytes(kEndianMarker)) {
+        swap_header(h);
+        if (!validate(h, size, m_error)) {
+            m_data.clear();
+            return false;
+        }
+        swap_blocks(data, h);
+        std::memcpy(data, &h, sizeof(Header));
+    }
+    if (!attach(data, size, true)) {
+        m_data.clear();
+        return false;
+    }
+    return true;
+}
+
+bool SegmentMapFile::attach(const uint8_t *data, size_t size, bool verify) {
+    std::memcpy(&m_header, data, sizeof(Header));
+    const Header &h = m_header;
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) {
+        m_error = "not a segment map file";
+        return false;
+    }
+    if (h.endian != kEndianMarker) {
+        m_error = "byte order differs from this machine, use read()";
+        return false;
+    }
+    if (!validate(h, size, m_error)) {
+        return false;
+    }
+    const uint32_t *cells = reinterpret_cast<const uint32_t *>(data + h.cells_offset);
+    const uint32_t *items = reinterpret_cast<const uint32_t *>(data + h.items_offset);
+    if (cells[static_cast<uint64_t>(h.cols) * h.rows] != h.item_count) {
+        m_error = "inconsistent cell offsets";
+        return false;
+    }
+    if (verify && !validate_blocks(h, cells, items, m_error)) {
+        return false;
+    }
+    SegmentIndex2D::Grid grid;
+    grid.origin_x = h.origin_x, grid.origin_y = h.origin_y, grid.cell_size = h.cell_size;
+    grid.cols = h.cols, grid.rows = h.rows;
+    m_index.view(grid, reinterpret_cast<const SegmentIndex2D::Segment *>(data + h.segments_offset), h.segment_count, cells, items);
+    return true;
+}
+
+void SegmentMapFile::close() {
+    m_index.view(SegmentIndex2D::Grid(), nullptr, 0, nullptr, nullptr);
+#if defined(TF2_GEOMETRY_HAS_MMAP)
+    if (m_mapping) {
+        munmap(m_mapping, m_mapping_size);
+    }
+#endif
+    m_mapping = nullptr, m_mapping_size = 0;
+    m_data.clear();
+    m_header = Header();
+}
+
+bool SegmentMapFile::mapped() const {
+    return m_mapping != nullptr;
+}
+
+const SegmentMapFile::Header &SegmentMapFile::header() const {
+    return m_header;
+}
+
+const SegmentIndex2D &SegmentMapFile::index() const {
+    return m_index;
+}
+
+const std::string &SegmentMapFile::error() const {
+    return m_error;
+}
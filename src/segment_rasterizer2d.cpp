@@ -0,0 +1,292 @@
+#include "tf2_geometry/segment_rasterizer2d.hpp"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/instrumentation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace tf2;
+
+namespace {
+/// upper limit for the radius of thick segments in cells, keeps the clipped coordinates within int64
+constexpr tf2Scalar kMaxRadius = 1 << 30;
+
+/**
+ * clips a line segment to a box with the Liang-Barsky algorithm
+ * @return false if the segment is outside of the box
+ **/
+bool clip(tf2Scalar &x0, tf2Scalar &y0, tf2Scalar &x1, tf2Scalar &y1, tf2Scalar x_min, tf2Scalar y_min, tf2Scalar x_max,
+          tf2Scalar y_max) {
+    const tf2Scalar dx = x1 - x0, dy = y1 - y0;
+    const tf2Scalar p[4] = {-dx, dx, -dy, dy};
+    const tf2Scalar q[4] = {x0 - x_min, x_max - x0, y0 - y_min, y_max - y0};
+    tf2Scalar t0 = 0.0, t1 = 1.0;
+    for (int k = 0; k < 4; k++) {
+        if (p[k] == 0.0) {
+            if (q[k] < 0.0) {
+                return false;
+            }
+        } else {
+            const tf2Scalar t = q[k] / p[k];
+            if (p[k] < 0.0) {
+                t0 = std::max(t0, t);
+            } else {
+                t1 = std::min(t1, t);
+            }
+        }
+    }
+    if (t0 > t1) {
+        return false;
+    }
+    x1 = x0 + t1 * dx, y1 = y0 + t1 * dy;
+    x0 = x0 + t0 * dx, y0 = y0 + t0 * dy;
+    return true;
+}
+
+/**
+ * intersects the interval [lo, hi] with the solutions of l <= a * u + b <= h
+ **/
+void restrict(tf2Scalar a, tf2Scalar b, tf2Scalar l, tf2Scalar h, tf2Scalar &lo, tf2Scalar &hi) {
+    if (a == 0.0) {
+        if (b < l || b > h) {
+            lo = std::numeric_limits<tf2Scalar>::infinity();
+        }
+        return;
+    }
+    tf2Scalar u0 = (l - b) / a, u1 = (h - b) / a;
+    if (a < 0.0) {
+        std::swap(u0, u1);
+    }
+    lo = std::max(lo, u0), hi = std::min(hi, u1);
+}
+
+/**
+ * range [i0, i1] of major axis steps which fall into the cells [lo, hi] of the major axis
+ * @return false if the range is empty
+ **/
+bool step_range(int64_t a0, int32_t sa, int64_t length, int64_t lo, int64_t hi, int64_t &i0, int64_t &i1) {
+    if (sa > 0) {
+        i0 = lo - a0, i1 = hi - a0;
+    } else {
+        i0 = a0 - hi, i1 = a0 - lo;
+    }
+    i0 = std::max<int64_t>(i0, 0), i1 = std::min<int64_t>(i1, length);
+    return i0 <= i1;
+}
+}  // namespace
+
+SegmentRasterizer2D::SegmentRasterizer2D() {
+    configure(Config());
+}
+
+SegmentRasterizer2D::SegmentRasterizer2D(const Config &config) {
+    configure(config);
+}
+
+void SegmentRasterizer2D::configure(const Config &config) {
+    m_config = config;
+    m_config.tile_size = std::max<uint32_t>(1, m_config.tile_size);
+    if (!(m_config.resolution > 0.0) || !std::isfinite(m_config.resolution)) {
+        m_config.resolution = Config().resolution;
+    }
+    if (!std::isfinite(m_config.thickness)) {
+        m_config.thickness = Config().thickness;
+    }
+    m_config.thickness = std::clamp<tf2Scalar>(m_config.thickness, 0.0, 2.0 * kMaxRadius * m_config.resolution);
+    m_tiles_x = (m_config.width + m_config.tile_size - 1) / m_config.tile_size;
+    m_tiles_y = (m_config.height + m_config.tile_size - 1) / m_config.tile_size;
+    m_radius = 0.5 * m_config.thickness / m_config.resolution;
+}
+
+const SegmentRasterizer2D::Config &SegmentRasterizer2D::config() const {
+    return m_config;
+}
+
+size_t SegmentRasterizer2D::size() const {
+    return static_cast<size_t>(m_config.width) * m_config.height;
+}
+
+void SegmentRasterizer2D::rasterize(const LineSegment2D *segments, size_t n, int8_t *grid) {
+    TF2_GEOMETRY_KERNEL(kSegmentRasterizer2DRasterize, n);
+    prepare(segments, n);
+    const size_t tiles = static_cast<size_t>(m_tiles_x) * m_tiles_y;
+    for (size_t t = 0; t < tiles; t++) {
+        rasterize_tile(t, grid, 0, 0, m_config.width - 1, m_config.height - 1);
+    }
+}
+
+void SegmentRasterizer2D::rasterize(const ExecutionPolicy &policy, const LineSegment2D *segments, size_t n, int8_t *grid) {
+    TF2_GEOMETRY_KERNEL(kSegmentRasterizer2DRasterize, n);
+    prepare(segments, n);
+    policy.for_each(static_cast<size_t>(m_tiles_x) * m_tiles_y, 1, [this, grid](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; t++) {
+            rasterize_tile(t, grid, 0, 0, m_config.width - 1, m_config.height - 1);
+        }
+    });
+}
+
+void SegmentRasterizer2D::rasterize(const LineSegment2D *segments, size_t n, int8_t *grid, uint32_t x0, uint32_t y0, uint32_t x1,
+                                    uint32_t y1) {
+    TF2_GEOMETRY_KERNEL(kSegmentRasterizer2DRasterize, n);
+    if (size() == 0) {
+        return;
+    }
+    x1 = std::min(x1, m_config.width - 1), y1 = std::min(y1, m_config.height - 1);
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+    prepare(segments, n);
+    const uint32_t tile = m_config.tile_size;
+    for (uint32_t ty = y0 / tile; ty <= y1 / tile; ty++) {
+        for (uint32_t tx = x0 / tile; tx <= x1 / tile; tx++) {
+            rasterize_tile(static_cast<size_t>(ty) * m_tiles_x + tx, grid, x0, y0, x1, y1);
+        }
+    }
+}
+
+void SegmentRasterizer2D::prepare(const LineSegment2D *segments, size_t n) {
+    const tf2Scalar scale = 1.0 / m_config.resolution;
+    /// clipping to a slightly larger box keeps the cells of the thick segments and the integers small
+    const tf2Scalar margin = std::ceil(m_radius) + 1.0;
+    const tf2Scalar x_max = m_config.width + margin, y_max = m_config.height + margin;
+    m_records.clear();
+    m_records.reserve(n);
+    Point2D p0, p1;
+    for (size_t i = 0; i < n; i++) {
+        m_config.origin.transform_into_child(segments[i].p0(), p0);
+        m_config.origin.transform_into_child(segments[i].p1(), p1);
+        Record r;
+        r.x0 = p0.x() * scale, r.y0 = p0.y() * scale, r.x1 = p1.x() * scale, r.y1 = p1.y() * scale;
+        /// the clip lets NaN through, the casts of the cells below need finite end points
+        if (!std::isfinite(r.x0) || !std::isfinite(r.y0) || !std::isfinite(r.x1) || !std::isfinite(r.y1)) {
+            continue;
+        }
+        if (!clip(r.x0, r.y0, r.x1, r.y1, -margin, -margin, x_max, y_max)) {
+            continue;
+        }
+        const int64_t cx0 = static_cast<int64_t>(std::floor(r.x0)), cy0 = static_cast<int64_t>(std::floor(r.y0));
+        const int64_t cx1 = static_cast<int64_t>(std::floor(r.x1)), cy1 = static_cast<int64_t>(std::floor(r.y1));
+        const int64_t dx = cx1 - cx0, dy = cy1 - cy0;
+        r.x_major = std::abs(dx) >= std::abs(dy);
+        const int64_t da = r.x_major ? dx : dy, db = r.x_major ? dy : dx;
+        r.a0 = r.x_major ? cx0 : cy0, r.b0 = r.x_major ? cy0 : cx0;
+        r.length = std::abs(da), r.minor = std::abs(db);
+        r.sa = da < 0 ? -1 : 1, r.sb = db < 0 ? -1 : 1;
+        m_records.push_back(r);
+    }
+
+    /// two passes, counting and filling, build the compressed rows without reallocation
+    const size_t tiles = static_cast<size_t>(m_tiles_x) * m_tiles_y;
+    m_tiles.assign(tiles + 1, 0);
+    for (const Record &r : m_records) {
+        for_each_tile(r, [this](size_t t) { m_tiles[t + 1]++; });
+    }
+    for (size_t t = 0; t < tiles; t++) {
+        m_tiles[t + 1] += m_tiles[t];
+    }
+    m_items.resize(m_tiles[tiles]);
+    std::vector<uint32_t> fill(m_tiles.begin(), m_tiles.end() - 1);
+    for (size_t i = 0; i < m_records.size(); i++) {
+        for_each_tile(m_records[i], [this, &fill, i](size_t t) { m_items[fill[t]++] = static_cast<uint32_t>(i); });
+    }
+}
+
+template<typename F>
+void SegmentRasterizer2D::for_each_tile(const Record &r, F f) const {
+    const int64_t tile = m_config.tile_size;
+    /// the cells of a thick segment lie within the radius around the center line, which is at most one cell off
+    const int64_t pad = m_radius > 0.0 ? static_cast<int64_t>(std::ceil(m_radius)) + 1 : 0;
+    const int64_t tiles_a = r.x_major ? m_tiles_x : m_tiles_y, tiles_b = r.x_major ? m_tiles_y : m_tiles_x;
+    const int64_t a_end = r.a0 + r.sa * r.length;
+    const int64_t ka0 = std::max<int64_t>(0, (std::min(r.a0, a_end) - pad) / tile);
+    const int64_t ka1 = std::min<int64_t>(tiles_a - 1, (std::max(r.a0, a_end) + pad) / tile);
+    for (int64_t ka = ka0; ka <= ka1; ka++) {
+        int64_t i0, i1;
+        if (!step_range(r.a0, r.sa, r.length, ka * tile - pad, (ka + 1) * tile - 1 + pad, i0, i1)) {
+            continue;
+        }
+        /// the minor axis cell is monotonic in the step
+        const int64_t b_i0 = r.length == 0 ? r.b0 : r.b0 + r.sb * ((2 * i0 * r.minor + r.length) / (2 * r.length));
+        const int64_t b_i1 = r.length == 0 ? r.b0 : r.b0 + r.sb * ((2 * i1 * r.minor + r.length) / (2 * r.length));
+        const int64_t b_lo = std::min(b_i0, b_i1) - pad, b_hi = std::max(b_i0, b_i1) + pad;
+        if (b_hi < 0) {
+            continue;
+        }
+        const int64_t kb0 = std::max<int64_t>(0, b_lo) / tile, kb1 = std::min<int64_t>(tiles_b - 1, b_hi / tile);
+        for (int64_t kb = kb0; kb <= kb1; kb++) {
+            f(r.x_major ? static_cast<size_t>(kb * m_tiles_x + ka) : static_cast<size_t>(ka * m_tiles_x + kb));
+        }
+    }
+}
+
+void SegmentRasterizer2D::rasterize_tile(size_t tile, int8_t *grid, int64_t x0, int64_t y0, int64_t x1, int64_t y1) const {
+    const int64_t width = m_config.width;
+    const int64_t tile_x = static_cast<int64_t>(tile % m_tiles_x) * m_config.tile_size;
+    const int64_t tile_y = static_cast<int64_t>(tile / m_tiles_x) * m_config.tile_size;
+    const int64_t x_lo = std::max(x0, tile_x), x_hi = std::min(x1, tile_x + m_config.tile_size - 1);
+    const int64_t y_lo = std::max(y0, tile_y), y_hi = std::min(y1, tile_y + m_config.tile_size - 1);
+    const int8_t value = m_config.value;
+    const tf2Scalar radius = m_radius, radius2 = m_radius * m_radius;
+    for (uint32_t j = m_tiles[tile]; j < m_tiles[tile + 1]; j++) {
+        const Record &r = m_records[m_items[j]];
+
+        /// center line, the Bresenham error term is computed in closed form at the first step inside the tile
+        const int64_t a_lo = r.x_major ? x_lo : y_lo, a_hi = r.x_major ? x_hi : y_hi;
+        const int64_t b_lo = r.x_major ? y_lo : x_lo, b_hi = r.x_major ? y_hi : x_hi;
+        int64_t i0, i1;
+        if (step_range(r.a0, r.sa, r.length, a_lo, a_hi, i0, i1)) {
+            const int64_t den = 2 * std::max<int64_t>(1, r.length);
+            const int64_t num = 2 * i0 * r.minor + r.length;
+            int64_t b = r.b0 + r.sb * (num / den), rem = num % den;
+            int64_t a = r.a0 + r.sa * i0;
+            for (int64_t i = i0; i <= i1; i++) {
+                if (b >= b_lo && b <= b_hi) {
+                    grid[r.x_major ? b * width + a : a * width + b] = value;
+                }
+                a += r.sa;
+                rem += 2 * r.minor;
+                if (rem >= den) {
+                    rem -= den, b += r.sb;
+                }
+            }
+        }
+        if (radius <= 0.0) {
+            continue;
+        }
+
+        /// thick segment, every row through the cell centers cuts the capsule around the segment in one interval
+        const tf2Scalar dx = r.x1 - r.x0, dy = r.y1 - r.y0, len2 = dx * dx + dy * dy, rl = radius * std::sqrt(len2);
+        const int64_t row0 = std::max<int64_t>(y_lo, static_cast<int64_t>(std::floor(std::min(r.y0, r.y1) - radius)));
+        const int64_t row1 = std::min<int64_t>(y_hi, static_cast<int64_t>(std::floor(std::max(r.y0, r.y1) + radius)));
+        for (int64_t y = row0; y <= row1; y++) {
+            const tf2Scalar yc = y + 0.5;
+            tf2Scalar lo = std::numeric_limits<tf2Scalar>::infinity(), hi = -lo;
+            const tf2Scalar e0 = yc - r.y0, e1 = yc - r.y1;
+            if (e0 * e0 <= radius2) {
+                const tf2Scalar h = std::sqrt(radius2 - e0 * e0);
+                lo = std::min(lo, r.x0 - h), hi = std::max(hi, r.x0 + h);
+            }
+            if (e1 * e1 <= radius2) {
+                const tf2Scalar h = std::sqrt(radius2 - e1 * e1);
+                lo = std::min(lo, r.x1 - h), hi = std::max(hi, r.x1 + h);
+            }
+            if (len2 > 0.0) {
+                /// u = x - x0 with a projection onto the segment in [0, len2] and a normal distance <= radius
+                tf2Scalar u0 = -std::numeric_limits<tf2Scalar>::infinity(), u1 = -u0;
+                restrict(dx, e0 * dy, 0.0, len2, u0, u1);
+                restrict(dy, -e0 * dx, -rl, rl, u0, u1);
+                if (u0 <= u1) {
+                    lo = std::min(lo, r.x0 + u0), hi = std::max(hi, r.x0 + u1);
+                }
+            }
+            if (lo > hi) {
+                continue;
+            }
+            const int64_t c0 = std::max<int64_t>(x_lo, static_cast<int64_t>(std::ceil(lo - 0.5)));
+            const int64_t c1 = std::min<int64_t>(x_hi, static_cast<int64_t>(std::floor(hi - 0.5)));
+            for (int64_t c = c0; c <= c1; c++) {
+                grid[y * width + c] = value;
+            }
+        }
+    }
+}
@@ -0,0 +1,147 @@
+#include "tf2_geometry/trajectory2d.hpp"
+#include "tf2_geometry/utils.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace tf2;
+
+namespace {
+/// segments the cursor walks before it falls back to the binary search
+constexpr size_t kCursorSteps = 4;
+/// upper limit for the samples of a resampling, bounds the cast of the sample count
+constexpr tf2Scalar kMaxSamples = 4294967296.0;
+}  // namespace
+
+Trajectory2D::Trajectory2D() {}
+
+void Trajectory2D::clear() {
+    m_time.clear(), m_x.clear(), m_y.clear(), m_theta.clear(), m_arc.clear(), m_dtheta.clear();
+}
+
+void Trajectory2D::reserve(size_t n) {
+    m_time.reserve(n), m_x.reserve(n), m_y.reserve(n), m_theta.reserve(n), m_arc.reserve(n), m_dtheta.reserve(n);
+}
+
+bool Trajectory2D::push_back(tf2Scalar time, const Transform2D &pose) {
+    if (!std::isfinite(time) || (!m_time.empty() && !(time > m_time.back()))) {
+        return false;
+    }
+    if (m_time.empty()) {
+        m_arc.push_back(0.0);
+    } else {
+        const tf2Scalar dx = pose.x() - m_x.back(), dy = pose.y() - m_y.back();
+        m_arc.push_back(m_arc.back() + std::sqrt(dx * dx + dy * dy));
+        m_dtheta.back() = angle_difference(pose.rotation(), m_theta.back());
+    }
+    m_time.push_back(time);
+    m_x.push_back(pose.x()), m_y.push_back(pose.y()), m_theta.push_back(pose.rotation());
+    m_dtheta.push_back(0.0);
+    return true;
+}
+
+size_t Trajectory2D::size() const {
+    return m_time.size();
+}
+
+bool Trajectory2D::empty() const {
+    return m_time.empty();
+}
+
+tf2Scalar Trajectory2D::time(size_t i) const {
+    return m_time[i];
+}
+
+tf2Scalar Trajectory2D::arc_length(size_t i) const {
+    return m_arc[i];
+}
+
+Transform2D Trajectory2D::pose(size_t i) const {
+    return Transform2D(m_x[i], m_y[i], m_theta[i]);
+}
+
+tf2Scalar Trajectory2D::length() const {
+    return m_arc.empty() ? 0.0 : m_arc.back();
+}
+
+size_t Trajectory2D::find(const std::vector<tf2Scalar> &keys, tf2Scalar key, Cursor *cursor) const {
+    const size_t n = keys.size();
+    if (n < 2) {
+        return 0;
+    }
+    /// a few steps from the cursor cover sequential queries, otherwise the segment is searched
+    size_t i = cursor ? std::min(cursor->index, n - 2) : 0;
+    bool found = false;
+    for (size_t step = 0; cursor && step < kCursorSteps; step++) {
+        if (key < keys[i] && i > 0) {
+            i--;
+        } else if (key >= keys[i + 1] && i + 2 < n) {
+            i++;
+        } else {
+            found = true;
+            break;
+        }
+    }
+    if (!found) {
+        const size_t upper = static_cast<size_t>(std::upper_bound(keys.begin(), keys.end(), key) - keys.begin());
+        i = std::min(upper > 0 ? upper - 1 : 0, n - 2);
+    }
+    if (cursor) {
+        cursor->index = i;
+    }
+    return i;
+}
+
+size_t Trajectory2D::find_time(tf2Scalar time, Cursor *cursor) const {
+    return find(m_time, time, cursor);
+}
+
+size_t Trajectory2D::find_arc_length(tf2Scalar s, Cursor *cursor) const {
+    return find(m_arc, s, cursor);
+}
+
+Transform2D &Trajectory2D::interpolate(const std::vector<tf2Scalar> &keys, tf2Scalar key, Transform2D &des, Cursor *cursor) const {
+    if (keys.size() < 2) {
+        return keys.empty() ? des.set(0.0, 0.0, 0.0) : des.set(m_x[0], m_y[0], m_theta[0]);
+    }
+    const size_t i = find(keys, key, cursor);
+    const tf2Scalar range = keys[i + 1] - keys[i];
+    const tf2Scalar u = range > 0.0 ? std::min<tf2Scalar>(1.0, std::max<tf2Scalar>(0.0, (key - keys[i]) / range)) : 0.0;
+    return des.set(m_x[i] + u * (m_x[i + 1] - m_x[i]), m_y[i] + u * (m_y[i + 1] - m_y[i]), angle_normalize(m_theta[i] + u * m_dtheta[i]));
+}
+
+Transform2D &Trajectory2D::at_time(tf2Scalar time, Transform2D &des, Cursor *cursor) const {
+    return interpolate(m_time, time, des, cursor);
+}
+
+Transform2D &Trajectory2D::at_arc_length(tf2Scalar s, Transform2D &des, Cursor *cursor) const {
+    return interpolate(m_arc, s, des, cursor);
+}
+
+size_t Trajectory2D::resample(const std::vector<tf2Scalar> &keys, tf2Scalar step, tf2Scalar *x, tf2Scalar *y, tf2Scalar *theta,
+                              size_t capacity) const {
+    if (keys.empty() || !(step > 0.0) || !std::isfinite(step)) {
+        return 0;
+    }
+    /// a small tolerance keeps the last sample if the range is a multiple of the step
+    const tf2Scalar range = keys.back() - keys.front();
+    const tf2Scalar count = std::floor(range / step * (1.0 + 1e-12)) + 1.0;
+    if (!(count <= kMaxSamples)) {
+        return 0;
+    }
+    const size_t n = static_cast<size_t>(count);
+    Cursor cursor;
+    Transform2D pose;
+    for (size_t j = 0; j < std::min(n, capacity); j++) {
+        interpolate(keys, keys.front() + j * step, pose, &cursor);
+        x[j] = pose.x(), y[j] = pose.y(), theta[j] = pose.rotation();
+    }
+    return n;
+}
+
+size_t Trajectory2D::resample_time(tf2Scalar period, tf2Scalar *x, tf2Scalar *y, tf2Scalar *theta, size_t capacity) const {
+    return resample(m_time, period, x, y, theta, capacity);
+}
+
+size_t Trajectory2D::resample_arc_length(tf2Scalar spacing, tf2Scalar *x, tf2Scalar *y, tf2Scalar *theta, size_t capacity) const {
+    return resample(m_arc, spacing, x, y, theta, capacity);
+}
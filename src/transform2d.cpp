@@ -1,12 +1,18 @@
 #include "tf2_geometry/transform2d.hpp"
 #include "tf2_geometry/utils.hpp"
+#include "tf2_geometry/instrumentation.hpp"
 using namespace tf2;
 
-Transform2D::Transform2D() : m_translation(), m_rotation(0) {}
+Transform2D::Transform2D() : m_translation(), m_rotation(0), m_cache_uptodate(false) {}
 
 Transform2D::Transform2D(const Point2D &p, tf2Scalar roation) : m_translation(p), m_rotation(roation), m_cache_uptodate(false) {}
 
-Transform2D::Transform2D(const Transform2D &p) : m_translation(p.m_translation), m_rotation(p.m_rotation), m_cache_uptodate(false) {}
+Transform2D::Transform2D(const Transform2D &p)
+    : m_translation(p.m_translation), m_rotation(p.m_rotation), m_cache_uptodate(p.m_cache_uptodate),
+      m_costheta(p.m_costheta), m_sintheta(p.m_sintheta), m_translation_inv(p.m_translation_inv) {
+    /// the cache is copied, so a copy does not trigger a recomputation
+    TF2_GEOMETRY_COUNT(kTransform2DCopy);
+}
 
 Transform2D::Transform2D(tf2Scalar x, tf2Scalar y, tf2Scalar roation) : m_translation(x, y), m_rotation(roation), m_cache_uptodate(false) {}
 
@@ -18,6 +24,7 @@ Transform2D &Transform2D::set(tf2Scalar x, tf2Scalar y, tf2Scalar rotation) {
     m_translation.set(x, y);
     m_rotation = rotation;
     m_cache_uptodate = false;
+    TF2_GEOMETRY_COUNT(kTransform2DCacheInvalidate);
     return *this;
 }
 
@@ -25,6 +32,7 @@ Transform2D &Transform2D::set(const Point2D &position, tf2Scalar rotation){
     m_translation.set(position);
     m_rotation = rotation;
     m_cache_uptodate = false;
+    TF2_GEOMETRY_COUNT(kTransform2DCacheInvalidate);
     return *this;
 }
 
@@ -32,12 +40,25 @@ Transform2D &Transform2D::set(const Point2D &position, const Point2D &point_ahea
     m_translation.set(position.x(), position.y());
     m_rotation = (point_ahead - position).angle();
     m_cache_uptodate = false;
+    TF2_GEOMETRY_COUNT(kTransform2DCacheInvalidate);
     return *this;
 }
 Transform2D &Transform2D::set(const Transform2D &p) {
     m_translation = p.m_translation;
     m_rotation = p.m_rotation;
-    m_cache_uptodate = false;
+    m_cache_uptodate = p.m_cache_uptodate;
+    m_costheta = p.m_costheta, m_sintheta = p.m_sintheta;
+    m_translation_inv = p.m_translation_inv;
+    TF2_GEOMETRY_COUNT(kTransform2DCopy);
+    return *this;
+}
+
+Transform2D &Transform2D::set(tf2Scalar x, tf2Scalar y, tf2Scalar rotation, tf2Scalar costheta, tf2Scalar sintheta) {
+    m_translation.set(x, y);
+    m_rotation = rotation;
+    m_costheta = costheta, m_sintheta = sintheta;
+    m_translation_inv.set(-(x * costheta + y * sintheta), x * sintheta - y * costheta);
+    m_cache_uptodate = true;
     return *this;
 }
 const Point2D &Transform2D::position() const {
@@ -51,6 +72,7 @@ const tf2Scalar &Transform2D::x() const {
 void Transform2D::set_x(const tf2Scalar x) {
     this->m_translation.m_floats[0] = x;
     m_cache_uptodate = false;
+    TF2_GEOMETRY_COUNT(kTransform2DCacheInvalidate);
 }
 
 const tf2Scalar &Transform2D::y() const {
@@ -60,15 +82,27 @@ const tf2Scalar &Transform2D::y() const {
 void Transform2D::set_y(const tf2Scalar y) {
     this->m_translation.m_floats[1] = y;
     m_cache_uptodate = false;
+    TF2_GEOMETRY_COUNT(kTransform2DCacheInvalidate);
 }
 
 const tf2Scalar &Transform2D::rotation() const {
     return m_rotation;
 }
 
+const tf2Scalar &Transform2D::cos_theta() const {
+    update_cached();
+    return m_costheta;
+}
+
+const tf2Scalar &Transform2D::sin_theta() const {
+    update_cached();
+    return m_sintheta;
+}
+
 void Transform2D::set_rotation(const tf2Scalar roation) {
     this->m_rotation = roation;
     m_cache_uptodate = false;
+    TF2_GEOMETRY_COUNT(kTransform2DCacheInvalidate);
 }
 
 void Transform2D::normalize_roation() {
@@ -76,6 +110,7 @@ void Transform2D::normalize_roation() {
 }
 
 void Transform2D::recompute_cached_cos_sin() const {
+    TF2_GEOMETRY_COUNT(kTransform2DCacheRecompute);
     m_costheta = tf2Cos(m_rotation);
     m_sintheta = tf2Sin(m_rotation);
     Point2D t(m_translation.x() * m_costheta + m_translation.y() * m_sintheta, -m_translation.x() * m_sintheta + m_translation.y() * m_costheta);
@@ -85,6 +120,7 @@ void Transform2D::recompute_cached_cos_sin() const {
 
 void Transform2D::update_cached() const {
     if (m_cache_uptodate) {
+        TF2_GEOMETRY_COUNT(kTransform2DCacheHit);
         return;
     }
     recompute_cached_cos_sin();
@@ -0,0 +1,91 @@
+#include "tf2_geometry/transform2d_sequence.hpp"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/instrumentation.hpp"
+#include "tf2_geometry/utils.hpp"
+#include <algorithm>
+#include <vector>
+
+using namespace tf2;
+
+namespace {
+/**
+ * pose with cos and sin of the rotation
+ **/
+struct Pose {
+    tf2Scalar x, y, rotation, c, s;
+};
+
+/**
+ * a * b, the norm of cos and sin is pulled back to one to stop the drift over long sequences
+ **/
+inline Pose compose(const Pose &a, tf2Scalar x, tf2Scalar y, tf2Scalar rotation, tf2Scalar c, tf2Scalar s) {
+    Pose des;
+    des.x = a.x + a.c * x - a.s * y;
+    des.y = a.y + a.s * x + a.c * y;
+    des.rotation = angle_normalize(a.rotation + rotation);
+    const tf2Scalar cc = a.c * c - a.s * s, ss = a.s * c + a.c * s;
+    const tf2Scalar k = 1.5 - 0.5 * (cc * cc + ss * ss);
+    des.c = cc * k, des.s = ss * k;
+    return des;
+}
+
+inline Pose load(const Transform2D &t) {
+    return Pose{t.x(), t.y(), t.rotation(), t.cos_theta(), t.sin_theta()};
+}
+
+/**
+ * sequential prefix of [begin, end), returns the total
+ **/
+Pose prefix(const Transform2D *src, size_t begin, size_t end, Transform2D *des) {
+    Pose p = load(src[begin]);
+    des[begin].set(p.x, p.y, p.rotation, p.c, p.s);
+    for (size_t i = begin + 1; i < end; i++) {
+        const Transform2D &t = src[i];
+        p = compose(p, t.x(), t.y(), t.rotation(), t.cos_theta(), t.sin_theta());
+        des[i].set(p.x, p.y, p.rotation, p.c, p.s);
+    }
+    return p;
+}
+}  // namespace
+
+void tf2::compose_prefix(const Transform2D *src, size_t n, Transform2D *des) {
+    TF2_GEOMETRY_KERNEL(kComposePrefix, n);
+    if (n > 0) {
+        prefix(src, 0, n, des);
+    }
+}
+
+void tf2::compose_prefix(const ExecutionPolicy &policy, const Transform2D *src, size_t n, Transform2D *des) {
+    TF2_GEOMETRY_KERNEL(kComposePrefix, n);
+    /// a few blocks per worker balance the load, short sequences are not worth the second pass
+    size_t blocks = std::min(n / 1024, 4 * policy.concurrency());
+    if (blocks < 2) {
+        if (n > 0) {
+            prefix(src, 0, n, des);
+        }
+        return;
+    }
+    /// rounding the size up may leave trailing blocks empty, they are dropped so every block starts before n
+    const size_t size = (n + blocks - 1) / blocks;
+    blocks = (n + size - 1) / size;
+    std::vector<Pose> totals(blocks);
+    policy.for_each(blocks, 1, [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; b++) {
+            totals[b] = prefix(src, b * size, std::min(n, (b + 1) * size), des);
+        }
+    });
+    /// carry[b] = total of all blocks before b
+    for (size_t b = 1; b + 1 < blocks; b++) {
+        totals[b] = compose(totals[b - 1], totals[b].x, totals[b].y, totals[b].rotation, totals[b].c, totals[b].s);
+    }
+    policy.for_each(blocks - 1, 1, [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; b++) {
+            const Pose &carry = totals[b];
+            for (size_t i = (b + 1) * size; i < std::min(n, (b + 2) * size); i++) {
+                const Transform2D &t = des[i];
+                const Pose p = compose(carry, t.x(), t.y(), t.rotation(), t.cos_theta(), t.sin_theta());
+                des[i].set(p.x, p.y, p.rotation, p.c, p.s);
+            }
+        }
+    });
+}
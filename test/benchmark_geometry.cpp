@@ -0,0 +1,590 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+#include "tf2_geometry/aabb2d.hpp"
+#include "tf2_geometry/convert.hpp"
+#include "tf2_geometry/convex_hull2d.hpp"
+#include "tf2_geometry/correlative_scan_matcher2d.hpp"
+#include "tf2_geometry/distance_field2d.hpp"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/kd_tree2d.hpp"
+#include "tf2_geometry/linesegment2d.hpp"
+#include "tf2_geometry/obb2d.hpp"
+#include "tf2_geometry/particle_set2d.hpp"
+#include "tf2_geometry/plane3d.hpp"
+#include "tf2_geometry/scan_matcher2d.hpp"
+#include "tf2_geometry/segment_rasterizer2d.hpp"
+#include "tf2_geometry/trajectory2d.hpp"
+#include "tf2_geometry/transform2d.hpp"
+#include "tf2_geometry/transform2d_sequence.hpp"
+#include "tf2_geometry/utils.hpp"
+
+/**
+ * Benchmarks for the geometry kernels.
+ * Every benchmark processes a batch of elements per iteration and reports
+ * bytes_per_point, the memory touched per element, and per_op, the time per element.
+ * JSON results: tf2_geometry_benchmarks --benchmark_out=results.json --benchmark_out_format=json
+ **/
+
+namespace {
+
+std::vector<tf2::Point2D> make_points(size_t n) {
+    std::vector<tf2::Point2D> points(n);
+    for (size_t i = 0; i < n; i++) {
+        points[i].set(std::sin(i * 0.1) * 10.0, std::cos(i * 0.07) * 5.0);
+    }
+    return points;
+}
+
+std::vector<tf2::Point3D> make_points_3d(size_t n) {
+    std::vector<tf2::Point3D> points(n);
+    for (size_t i = 0; i < n; i++) {
+        points[i] = tf2::Point3D(std::sin(i * 0.1) * 10.0, std::cos(i * 0.07) * 5.0, i * 0.001);
+    }
+    return points;
+}
+
+void set_counters(benchmark::State &state, size_t n, size_t bytes_per_point) {
+    const double elements = static_cast<double>(state.iterations() * n);
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * bytes_per_point);
+    state.counters["bytes_per_point"] = static_cast<double>(bytes_per_point);
+    state.counters["per_op"] = benchmark::Counter(elements, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+}  // namespace
+
+/// transform with a valid cos/sin cache
+static void BM_Transform2D_point_warm(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const std::vector<tf2::Point2D> src = make_points(n);
+    std::vector<tf2::Point2D> des(n);
+    tf2::Transform2D tf(1.0, 2.0, 0.3);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            tf.transform_into_parent(src[i], des[i]);
+        }
+        benchmark::DoNotOptimize(des.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, 2 * sizeof(tf2::Point2D));
+}
+BENCHMARK(BM_Transform2D_point_warm)->Arg(1024)->Arg(65536);
+
+/// transform with the cos/sin cache invalidated before every point
+static void BM_Transform2D_point_cold(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const std::vector<tf2::Point2D> src = make_points(n);
+    std::vector<tf2::Point2D> des(n);
+    tf2::Transform2D tf(1.0, 2.0, 0.3);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            tf.set_rotation(0.3 + i * 1e-6);
+            tf.transform_into_parent(src[i], des[i]);
+        }
+        benchmark::DoNotOptimize(des.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, 2 * sizeof(tf2::Point2D));
+}
+BENCHMARK(BM_Transform2D_point_cold)->Arg(1024)->Arg(65536);
+
+static void BM_Transform2D_point_into_child(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const std::vector<tf2::Point2D> src = make_points(n);
+    std::vector<tf2::Point2D> des(n);
+    tf2::Transform2D tf(1.0, 2.0, 0.3);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            tf.transform_into_child(src[i], des[i]);
+        }
+        benchmark::DoNotOptimize(des.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, 2 * sizeof(tf2::Point2D));
+}
+BENCHMARK(BM_Transform2D_point_into_child)->Arg(1024)->Arg(65536);
+
+static void BM_Transform2D_pose(benchmark::State &state) {
+    const size_t n = state.range(0);
+    std::vector<tf2::Transform2D> src(n), des(n);
+    for (size_t i = 0; i < n; i++) {
+        src[i].set(i * 0.01, -(i * 0.02), std::sin(i * 0.1));
+    }
+    tf2::Transform2D tf(1.0, 2.0, 0.3);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            tf.transform_into_parent(src[i], des[i]);
+        }
+        benchmark::DoNotOptimize(des.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, 2 * sizeof(tf2::Transform2D));
+}
+BENCHMARK(BM_Transform2D_pose)->Arg(1024)->Arg(65536);
+
+static void BM_Line2D_distance(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const std::vector<tf2::Point2D> src = make_points(n);
+    std::vector<tf2Scalar> des(n);
+    const tf2::Line2D line(0.0, 0.0, 3.0, 1.0);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            des[i] = line.distance_to(src[i]);
+        }
+        benchmark::DoNotOptimize(des.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, sizeof(tf2::Point2D) + sizeof(tf2Scalar));
+}
+BENCHMARK(BM_Line2D_distance)->Arg(1024)->Arg(65536);
+
+static void BM_Line2D_intersection(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const std::vector<tf2::Point2D> src = make_points(n + 1);
+    std::vector<tf2::Line2D> lines(n);
+    for (size_t i = 0; i < n; i++) {
+        lines[i].create(src[i], src[i + 1]);
+    }
+    std::vector<tf2::Point2D> des(n);
+    const tf2::Line2D line(0.0, 0.0, 3.0, 1.0);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            des[i] = line.intersection(lines[i]);
+        }
+        benchmark::DoNotOptimize(des.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, sizeof(tf2::Line2D) + sizeof(tf2::Point2D));
+}
+BENCHMARK(BM_Line2D_intersection)->Arg(1024)->Arg(65536);
+
+static void BM_LineSegment2D_distance(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const std::vector<tf2::Point2D> src = make_points(n);
+    std::vector<tf2Scalar> des(n);
+    const tf2::LineSegment2D segment(-1.0, -1.0, 3.0, 1.0);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            des[i] = segment.distance_to(src[i]);
+        }
+        benchmark::DoNotOptimize(des.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, sizeof(tf2::Point2D) + sizeof(tf2Scalar));
+}
+BENCHMARK(BM_LineSegment2D_distance)->Arg(1024)->Arg(65536);
+
+static void BM_LineSegment2D_closest_point(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const std::vector<tf2::Point2D> src = make_points(n);
+    std::vector<tf2::Point2D> des(n);
+    const tf2::LineSegment2D segment(-1.0, -1.0, 3.0, 1.0);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            des[i] = segment.closest_point_to(src[i]);
+        }
+        benchmark::DoNotOptimize(des.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, 2 * sizeof(tf2::Point2D));
+}
+BENCHMARK(BM_LineSegment2D_closest_point)->Arg(1024)->Arg(65536);
+
+static void BM_Plane3D_distance(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const std::vector<tf2::Point3D> src = make_points_3d(n);
+    std::vector<tf2Scalar> des(n);
+    const tf2::Plane3D plane(0.1, 0.2, 0.97, -0.5);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            des[i] = plane.distance_to(src[i]);
+        }
+        benchmark::DoNotOptimize(des.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, sizeof(tf2::Point3D) + sizeof(tf2Scalar));
+}
+BENCHMARK(BM_Plane3D_distance)->Arg(1024)->Arg(65536);
+
+static void BM_Plane3D_distances_batch(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const std::vector<tf2::Point3D> src = make_points_3d(n);
+    std::vector<tf2Scalar> des(n);
+    const tf2::Plane3D plane(0.1, 0.2, 0.97, -0.5);
+    for (auto _ : state) {
+        plane.distances_to(src.data(), n, des.data());
+        benchmark::DoNotOptimize(des.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, sizeof(tf2::Point3D) + sizeof(tf2Scalar));
+}
+BENCHMARK(BM_Plane3D_distances_batch)->Arg(1024)->Arg(65536);
+
+static void BM_Plane3D_classify(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const std::vector<tf2::Point3D> src = make_points_3d(n);
+    std::vector<uint8_t> mask(n);
+    const tf2::Plane3D plane(0.1, 0.2, 0.97, -0.5);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(plane.classify(src.data(), n, 0.5, mask.data()));
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, sizeof(tf2::Point3D) + sizeof(uint8_t));
+}
+BENCHMARK(BM_Plane3D_classify)->Arg(1024)->Arg(65536);
+
+/// scaling over range(1) pool threads
+static void BM_Plane3D_classify_pool(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const std::vector<tf2::Point3D> src = make_points_3d(n);
+    std::vector<uint8_t> mask(n);
+    const tf2::Plane3D plane(0.1, 0.2, 0.97, -0.5);
+    tf2::ThreadPool::Config config;
+    config.num_threads = state.range(1);
+    tf2::ThreadPool pool(config);
+    const tf2::ExecutionPolicy policy = tf2::ExecutionPolicy::thread_pool(pool);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(plane.classify(policy, src.data(), n, 0.5, mask.data()));
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, sizeof(tf2::Point3D) + sizeof(uint8_t));
+}
+BENCHMARK(BM_Plane3D_classify_pool)->ArgsProduct({{1 << 20}, {1, 2, 4, 8, 16}})->UseRealTime();
+
+/// range(0) random walls burnt into a 2000 x 2000 grid, bytes_per_point is per segment
+static void BM_SegmentRasterizer2D(benchmark::State &state) {
+    const size_t n = state.range(0);
+    std::vector<tf2::LineSegment2D> segments(n);
+    for (size_t i = 0; i < n; i++) {
+        const double x = 50.0 + 45.0 * std::sin(i * 0.7), y = 50.0 + 45.0 * std::cos(i * 1.3);
+        segments[i].set(tf2::Point2D(x, y), tf2::Point2D(x + 3.0 * std::cos(i * 0.1), y + 3.0 * std::sin(i * 0.1)));
+    }
+    tf2::SegmentRasterizer2D::Config config;
+    config.resolution = 0.05, config.width = 2000, config.height = 2000, config.thickness = 0.1;
+    tf2::SegmentRasterizer2D rasterizer(config);
+    std::vector<int8_t> grid(rasterizer.size(), 0);
+    for (auto _ : state) {
+        rasterizer.rasterize(segments.data(), n, grid.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, sizeof(tf2::LineSegment2D));
+}
+BENCHMARK(BM_SegmentRasterizer2D)->Arg(1024)->Arg(16384);
+
+/// scan of range(0) points in a 20 x 10 room with 200 pillars, matched from a guess 10 cm and 3 deg off
+static void BM_ScanMatcher2D_match(benchmark::State &state) {
+    const size_t n = state.range(0);
+    std::vector<tf2::LineSegment2D> map = {tf2::LineSegment2D(0.0, 0.0, 20.0, 0.0), tf2::LineSegment2D(20.0, 0.0, 20.0, 10.0),
+                                           tf2::LineSegment2D(20.0, 10.0, 0.0, 10.0), tf2::LineSegment2D(0.0, 10.0, 0.0, 0.0)};
+    for (size_t i = 0; i < 200; i++) {
+        const double x = 10.0 + 9.0 * std::sin(i * 0.7), y = 5.0 + 4.5 * std::cos(i * 1.3);
+        map.push_back(tf2::LineSegment2D(x, y, x + 0.2, y));
+        map.push_back(tf2::LineSegment2D(x + 0.2, y, x + 0.2, y + 0.2));
+    }
+    tf2::SegmentIndex2D index;
+    index.build(map.data(), map.size(), 0.5);
+    /// points on the closest segment of samples around the true pose
+    std::vector<tf2::Point2D> scan;
+    const tf2::Transform2D pose(10.0, 5.0, 0.2);
+    for (size_t i = 0; i < n; i++) {
+        const double a = i * 2.0 * M_PI / n;
+        const tf2::Point2D p(10.0 + 3.0 * std::cos(a), 5.0 + 3.0 * std::sin(a));
+        scan.push_back(pose.transform_into_child(map[index.nearest(p, 10.0)].closest_point_to(p)));
+    }
+    tf2::ScanMatcher2D::Config config;
+    config.time_budget = 0.0;
+    tf2::ScanMatcher2D matcher(config);
+    tf2::ScanMatcher2D::Result result;
+    const tf2::Transform2D guess(10.1, 4.95, 0.25);
+    for (auto _ : state) {
+        matcher.match(index, scan.data(), n, guess, result);
+        benchmark::DoNotOptimize(result.pose.x());
+    }
+    state.counters["iterations"] = static_cast<double>(result.iterations);
+    set_counters(state, n, sizeof(tf2::Point2D));
+}
+BENCHMARK(BM_ScanMatcher2D_match)->Arg(360)->Arg(1080);
+
+/// 360 point scan in a 20 x 10 room with pillars, window of +-range(0) cm and +-0.3 rad, 5 cm cells
+static void BM_CorrelativeScanMatcher2D_match(benchmark::State &state) {
+    std::vector<tf2::LineSegment2D> map = {tf2::LineSegment2D(0.0, 0.0, 20.0, 0.0), tf2::LineSegment2D(20.0, 0.0, 20.0, 10.0),
+                                           tf2::LineSegment2D(20.0, 10.0, 0.0, 10.0), tf2::LineSegment2D(0.0, 10.0, 0.0, 0.0)};
+    for (size_t i = 0; i < 50; i++) {
+        const double x = 10.0 + 9.0 * std::sin(i * 0.7), y = 5.0 + 4.5 * std::cos(i * 1.3);
+        map.push_back(tf2::LineSegment2D(x, y, x + 0.2, y));
+        map.push_back(tf2::LineSegment2D(x + 0.2, y, x + 0.2, y + 0.2));
+    }
+    tf2::DistanceField2D::Config field_config;
+    field_config.resolution = 0.05, field_config.width = 420, field_config.height = 220;
+    field_config.origin.set(-0.5, -0.5, 0.0);
+    field_config.max_distance = 0.5, field_config.sigma = 0.1;
+    tf2::DistanceField2D field(field_config);
+    field.build(map.data(), map.size());
+    tf2::SegmentIndex2D index;
+    index.build(map.data(), map.size(), 0.5);
+    std::vector<tf2::Point2D> scan;
+    const tf2::Transform2D pose(10.0, 5.0, 0.2);
+    for (size_t i = 0; i < 360; i++) {
+        const double a = i * 2.0 * M_PI / 360;
+        const tf2::Point2D p(10.0 + 3.0 * std::cos(a), 5.0 + 3.0 * std::sin(a));
+        scan.push_back(pose.transform_into_child(map[index.nearest(p, 10.0)].closest_point_to(p)));
+    }
+    tf2::CorrelativeScanMatcher2D::Config config;
+    config.linear_window = state.range(0) * 0.01, config.angular_window = 0.3;
+    tf2::CorrelativeScanMatcher2D matcher(config);
+    matcher.set_map(field);
+    tf2::CorrelativeScanMatcher2D::Result result;
+    const tf2::Transform2D prior(10.3, 4.8, 0.1);
+    for (auto _ : state) {
+        matcher.match(scan.data(), scan.size(), prior, result);
+        benchmark::DoNotOptimize(result.score);
+    }
+    state.counters["candidates"] = static_cast<double>(result.candidates);
+    set_counters(state, scan.size(), sizeof(tf2::Point2D));
+}
+BENCHMARK(BM_CorrelativeScanMatcher2D_match)->Arg(50)->Arg(200);
+
+/// odometry update of range(0) particles, range(1) = 1 adds sampled noise
+static void BM_ParticleSet2D_move(benchmark::State &state) {
+    const size_t n = state.range(0);
+    tf2::ParticleSet2D particles(n);
+    for (size_t i = 0; i < n; i++) {
+        particles.set(i, tf2::Transform2D(std::sin(i * 0.1), std::cos(i * 0.3), std::sin(i * 0.7)));
+    }
+    std::vector<tf2Scalar> nx(n), ny(n), ntheta(n);
+    for (size_t i = 0; i < n; i++) {
+        nx[i] = 0.01 * std::sin(i * 1.1), ny[i] = 0.01 * std::cos(i * 1.3), ntheta[i] = 0.005 * std::sin(i * 1.7);
+    }
+    const tf2::Transform2D delta(0.05, 0.001, 0.01);
+    for (auto _ : state) {
+        if (state.range(1)) {
+            particles.move(delta, nx.data(), ny.data(), ntheta.data());
+        } else {
+            particles.move(delta);
+        }
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, 5 * sizeof(tf2Scalar));
+}
+BENCHMARK(BM_ParticleSet2D_move)->Args({5000, 0})->Args({5000, 1});
+
+/// the same update on one Transform2D per particle
+static void BM_Transform2D_particles_move(benchmark::State &state) {
+    const size_t n = state.range(0);
+    std::vector<tf2::Transform2D> particles(n);
+    for (size_t i = 0; i < n; i++) {
+        particles[i].set(std::sin(i * 0.1), std::cos(i * 0.3), std::sin(i * 0.7));
+    }
+    const tf2::Transform2D delta(0.05, 0.001, 0.01);
+    tf2::Transform2D moved;
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            particles[i].transform_into_parent(delta, moved);
+            particles[i].set(moved);
+        }
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, sizeof(tf2::Transform2D));
+}
+BENCHMARK(BM_Transform2D_particles_move)->Arg(5000);
+
+/// integration of range(0) odometry increments, range(1) = 0 composes with operator*, 1 with compose_prefix
+static void BM_compose_prefix(benchmark::State &state) {
+    const size_t n = state.range(0);
+    std::vector<tf2::Transform2D> increments(n), poses(n);
+    for (size_t i = 0; i < n; i++) {
+        increments[i].set(0.01 * std::cos(i * 0.1), 0.001 * std::sin(i * 0.3), 0.002 * std::sin(i * 0.01));
+    }
+    for (auto _ : state) {
+        if (state.range(1)) {
+            tf2::compose_prefix(increments.data(), n, poses.data());
+        } else {
+            poses[0].set(increments[0]);
+            for (size_t i = 1; i < n; i++) {
+                poses[i - 1].transform_into_parent(increments[i], poses[i]);
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, sizeof(tf2::Transform2D));
+}
+BENCHMARK(BM_compose_prefix)->Args({100000, 0})->Args({100000, 1});
+
+/// sequential lookups along a trajectory of range(0) samples, range(1) = 0 binary search, 1 with a cursor
+static void BM_Trajectory2D_at_time(benchmark::State &state) {
+    const size_t n = state.range(0), queries = 4 * n;
+    tf2::Trajectory2D trajectory;
+    for (size_t i = 0; i < n; i++) {
+        trajectory.push_back(0.1 * i, tf2::Transform2D(0.1 * i, std::sin(i * 0.01), 0.01 * i));
+    }
+    tf2::Transform2D pose;
+    for (auto _ : state) {
+        tf2::Trajectory2D::Cursor cursor;
+        for (size_t i = 0; i < queries; i++) {
+            trajectory.at_time(0.025 * i, pose, state.range(1) ? &cursor : nullptr);
+        }
+        benchmark::DoNotOptimize(pose);
+    }
+    set_counters(state, queries, sizeof(tf2::Transform2D));
+}
+BENCHMARK(BM_Trajectory2D_at_time)->Args({65536, 0})->Args({65536, 1});
+
+/// hull and min area rectangle of a scan cluster with range(0) points, range(1) = 0 monotone chain, 1 ordered
+static void BM_ConvexHull2D_compute(benchmark::State &state) {
+    const size_t n = state.range(0);
+    std::vector<tf2Scalar> xs(n), ys(n);
+    for (size_t i = 0; i < n; i++) {
+        const tf2Scalar angle = -0.5 + i * 1.0 / n, range = 3.0 + 0.2 * std::sin(i * 0.7) + 0.05 * std::cos(i * 3.1);
+        xs[i] = range * std::cos(angle), ys[i] = range * std::sin(angle);
+    }
+    tf2::ConvexHull2D hull;
+    tf2::Transform2D pose;
+    tf2Scalar length, width;
+    for (auto _ : state) {
+        if (state.range(1)) {
+            hull.compute_ordered(xs.data(), ys.data(), n);
+        } else {
+            hull.compute(xs.data(), ys.data(), n);
+        }
+        benchmark::DoNotOptimize(hull.min_area_rectangle(pose, length, width));
+    }
+    set_counters(state, n, 2 * sizeof(tf2Scalar));
+}
+BENCHMARK(BM_ConvexHull2D_compute)->Args({256, 0})->Args({256, 1})->Args({4096, 0})->Args({4096, 1});
+
+static std::vector<tf2::Point2D> make_cloud2d(size_t n) {
+    std::vector<tf2::Point2D> points(n);
+    for (size_t i = 0; i < n; i++) {
+        points[i] = tf2::Point2D(10.0 * std::sin(i * 0.37) + std::cos(i * 3.1), 5.0 * std::cos(i * 0.11) + std::sin(i * 1.7));
+    }
+    return points;
+}
+
+static void BM_KdTree2D_build(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const std::vector<tf2::Point2D> points = make_cloud2d(n);
+    tf2::KdTree2D tree;
+    for (auto _ : state) {
+        tree.build(points.data(), n);
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, sizeof(tf2::Point2D));
+}
+BENCHMARK(BM_KdTree2D_build)->Arg(1024)->Arg(65536);
+
+/// closest point of n queries in a tree of n points
+static void BM_KdTree2D_nearest(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const std::vector<tf2::Point2D> points = make_cloud2d(n), queries = make_cloud2d(2 * n);
+    tf2::KdTree2D tree;
+    tree.build(points.data(), n);
+    std::vector<size_t> indices(n);
+    std::vector<tf2Scalar> distances(n);
+    for (auto _ : state) {
+        tree.nearest(queries.data() + n, n, 1.0, indices.data(), distances.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, sizeof(tf2::Point2D));
+}
+BENCHMARK(BM_KdTree2D_nearest)->Arg(1024)->Arg(65536);
+
+/// angles with a magnitude of up to range(1) turns, the loop in angle_normalize runs once per turn
+static void BM_angle_normalize(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const tf2Scalar turns = static_cast<tf2Scalar>(state.range(1));
+    std::vector<tf2Scalar> src(n), des(n);
+    for (size_t i = 0; i < n; i++) {
+        src[i] = std::sin(i * 0.37) * turns * 2.0 * M_PI;
+    }
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            des[i] = tf2::angle_normalize(src[i]);
+        }
+        benchmark::DoNotOptimize(des.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, 2 * sizeof(tf2Scalar));
+}
+BENCHMARK(BM_angle_normalize)->Args({1024, 1})->Args({1024, 10})->Args({1024, 1000});
+
+static void BM_to_2D_transform(benchmark::State &state) {
+    const size_t n = state.range(0);
+    std::vector<tf2::Transform> src(n);
+    for (size_t i = 0; i < n; i++) {
+        tf2::Quaternion q;
+        q.setRPY(0.01, -0.02, std::sin(i * 0.1));
+        src[i] = tf2::Transform(q, tf2::Vector3(i * 0.01, -(i * 0.02), 0.1));
+    }
+    std::vector<tf2::Transform2D> des(n);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            tf2::to_2D(src[i], des[i]);
+        }
+        benchmark::DoNotOptimize(des.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, sizeof(tf2::Transform) + sizeof(tf2::Transform2D));
+}
+BENCHMARK(BM_to_2D_transform)->Arg(1024)->Arg(65536);
+
+static void BM_to_2D_point(benchmark::State &state) {
+    const size_t n = state.range(0);
+    std::vector<tf2::Transform> src(n);
+    for (size_t i = 0; i < n; i++) {
+        src[i] = tf2::Transform(tf2::Quaternion(0, 0, 0, 1), tf2::Vector3(i * 0.01, -(i * 0.02), 0.1));
+    }
+    std::vector<tf2::Point2D> des(n);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; i++) {
+            tf2::to_2D(src[i], des[i]);
+        }
+        benchmark::DoNotOptimize(des.data());
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, n, sizeof(tf2::Transform) + sizeof(tf2::Point2D));
+}
+BENCHMARK(BM_to_2D_point)->Arg(1024)->Arg(65536);
+
+/// bounding box of range(0) points, range(1) = 0 scalar loop, 1 Point2D reduction, 2 structure of arrays reduction
+static void BM_AABB2D_extend(benchmark::State &state) {
+    const size_t n = state.range(0);
+    const std::vector<tf2::Point2D> points = make_cloud2d(n);
+    std::vector<tf2Scalar> xs(n), ys(n);
+    for (size_t i = 0; i < n; i++) {
+        xs[i] = points[i].x(), ys[i] = points[i].y();
+    }
+    for (auto _ : state) {
+        tf2::AABB2D box;
+        if (state.range(1) == 0) {
+            for (size_t i = 0; i < n; i++) {
+                box.extend(points[i]);
+            }
+        } else if (state.range(1) == 1) {
+            box.extend(points.data(), n);
+        } else {
+            box.extend(xs.data(), ys.data(), n);
+        }
+        benchmark::DoNotOptimize(box);
+    }
+    set_counters(state, n, sizeof(tf2::Point2D));
+}
+BENCHMARK(BM_AABB2D_extend)->Args({65536, 0})->Args({65536, 1})->Args({65536, 2});
+
+/// separating axis tests of a footprint against range(0) boxes
+static void BM_OBB2D_intersects(benchmark::State &state) {
+    const size_t n = state.range(0);
+    std::vector<tf2::OBB2D> boxes(n);
+    for (size_t i = 0; i < n; i++) {
+        boxes[i].set(tf2::Transform2D(10.0 * std::sin(i * 0.37), 10.0 * std::cos(i * 0.11), i * 0.1), 1.0 + 0.5 * std::sin(i * 1.7), 0.5);
+    }
+    const tf2::OBB2D footprint(tf2::Transform2D(1.0, 2.0, 0.3), 1.2, 0.8);
+    std::vector<uint8_t> mask(n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(footprint.intersects(boxes.data(), n, mask.data()));
+    }
+    set_counters(state, n, sizeof(tf2::OBB2D));
+}
+BENCHMARK(BM_OBB2D_intersects)->Arg(65536);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+#include <cmath>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tf2_geometry/aabb2d.hpp"
+
+TEST(AABB2D, extend)
+{
+  tf2::AABB2D box;
+  EXPECT_TRUE(box.empty());
+  EXPECT_EQ(box.area(), 0.0);
+  box.extend(tf2::Point2D(1.0, 2.0));
+  EXPECT_FALSE(box.empty());
+  EXPECT_EQ(box.x_min(), 1.0);
+  EXPECT_EQ(box.y_max(), 2.0);
+  box.extend(tf2::AABB2D(-1.0, 0.0, 0.0, 5.0));
+  EXPECT_EQ(box.x_min(), -1.0);
+  EXPECT_EQ(box.x_max(), 1.0);
+  EXPECT_EQ(box.size_y(), 5.0);
+  EXPECT_DOUBLE_EQ(box.center().y(), 2.5);
+  EXPECT_DOUBLE_EQ(box.inflate(0.5).area(), 3.0 * 6.0);
+  EXPECT_TRUE(box.clear().empty());
+  EXPECT_TRUE(box.inflate(1.0).empty());
+}
+
+TEST(AABB2D, reductions)
+{
+  // 11 points to cover the lanes and the remainder
+  std::vector<tf2::Point2D> points;
+  std::vector<double> xs, ys;
+  for (size_t i = 0; i < 11; i++) {
+    points.push_back(tf2::Point2D(std::sin(i * 1.3) * i, std::cos(i * 0.7) * i));
+    xs.push_back(points.back().x()), ys.push_back(points.back().y());
+  }
+  tf2::AABB2D expected;
+  for (const tf2::Point2D & p : points) {
+    expected.extend(p);
+  }
+  tf2::AABB2D from_points, from_arrays;
+  from_points.extend(points.data(), points.size());
+  from_arrays.extend(xs.data(), ys.data(), xs.size());
+  for (const tf2::AABB2D & box : {from_points, from_arrays}) {
+    EXPECT_EQ(box.x_min(), expected.x_min());
+    EXPECT_EQ(box.y_min(), expected.y_min());
+    EXPECT_EQ(box.x_max(), expected.x_max());
+    EXPECT_EQ(box.y_max(), expected.y_max());
+  }
+
+  // an existing box is kept, no points change nothing
+  tf2::AABB2D box(-100.0, -100.0, -99.0, -99.0);
+  box.extend(xs.data(), ys.data(), 0);
+  EXPECT_EQ(box.x_max(), -99.0);
+  box.extend(points.data(), 3);
+  EXPECT_EQ(box.x_min(), -100.0);
+  EXPECT_EQ(box.x_max(), std::max(std::max(points[0].x(), points[1].x()), points[2].x()));
+
+  std::vector<tf2::LineSegment2D> segments = {tf2::LineSegment2D(0.0, 0.0, 2.0, -1.0), tf2::LineSegment2D(-3.0, 4.0, 1.0, 1.0)};
+  box.clear().extend(segments.data(), segments.size());
+  EXPECT_EQ(box.x_min(), -3.0);
+  EXPECT_EQ(box.y_min(), -1.0);
+  EXPECT_EQ(box.x_max(), 2.0);
+  EXPECT_EQ(box.y_max(), 4.0);
+
+  // NaN coordinates are ignored by every overload, in the lanes and in the remainder
+  const double nan = std::nan("");
+  for (size_t i : {1u, 9u}) {
+    points[i].x() = nan, xs[i] = nan;
+  }
+  from_points.clear().extend(points.data(), points.size());
+  from_arrays.clear().extend(xs.data(), ys.data(), xs.size());
+  expected.clear();
+  for (const tf2::Point2D & p : points) {
+    expected.extend(p);
+  }
+  for (const tf2::AABB2D & b : {from_points, from_arrays}) {
+    EXPECT_EQ(b.x_min(), expected.x_min());
+    EXPECT_EQ(b.y_min(), expected.y_min());
+    EXPECT_EQ(b.x_max(), expected.x_max());
+    EXPECT_EQ(b.y_max(), expected.y_max());
+  }
+  EXPECT_FALSE(std::isnan(expected.x_min()));
+  std::vector<tf2::LineSegment2D> nan_segments = {tf2::LineSegment2D(nan, 0.0, 2.0, nan), segments[1]};
+  box.clear().extend(nan_segments.data(), nan_segments.size());
+  EXPECT_EQ(box.x_min(), -3.0);
+  EXPECT_EQ(box.y_min(), 0.0);
+  EXPECT_EQ(box.x_max(), 2.0);
+  EXPECT_EQ(box.y_max(), 4.0);
+}
+
+TEST(AABB2D, intersects)
+{
+  const tf2::AABB2D box(0.0, 0.0, 2.0, 1.0);
+  EXPECT_TRUE(box.contains(tf2::Point2D(2.0, 0.5)));
+  EXPECT_FALSE(box.contains(tf2::Point2D(2.1, 0.5)));
+  EXPECT_TRUE(box.intersects(tf2::AABB2D(1.0, 0.5, 3.0, 3.0)));
+  EXPECT_TRUE(box.intersects(tf2::AABB2D(2.0, 1.0, 3.0, 3.0)));
+  EXPECT_FALSE(box.intersects(tf2::AABB2D(2.5, 0.0, 3.0, 1.0)));
+  EXPECT_FALSE(box.intersects(tf2::AABB2D()));
+}
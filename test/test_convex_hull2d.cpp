@@ -0,0 +1,106 @@
+#include <cmath>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tf2_geometry/convex_hull2d.hpp"
+
+TEST(ConvexHull2D, compute)
+{
+  // square with points on the edges and inside
+  std::vector<tf2::Point2D> points = {
+    {1.0, 1.0}, {0.0, 0.0}, {2.0, 0.0}, {1.0, 0.0}, {2.0, 2.0}, {0.5, 1.5}, {0.0, 2.0}, {0.0, 1.0}, {2.0, 2.0}};
+  tf2::ConvexHull2D hull;
+  EXPECT_EQ(hull.compute(points.data(), points.size()), 4u);
+  // counter clockwise from the lowest x
+  const double expected_x[] = {0.0, 2.0, 2.0, 0.0}, expected_y[] = {0.0, 0.0, 2.0, 2.0};
+  for (size_t i = 0; i < 4; i++) {
+    EXPECT_EQ(hull.x()[i], expected_x[i]);
+    EXPECT_EQ(hull.y()[i], expected_y[i]);
+    EXPECT_EQ(points[hull.indices()[i]].x(), expected_x[i]);
+  }
+  EXPECT_DOUBLE_EQ(hull.area(), 4.0);
+
+  // structure of arrays input
+  std::vector<double> xs, ys;
+  for (const tf2::Point2D & p : points) {
+    xs.push_back(p.x()), ys.push_back(p.y());
+  }
+  EXPECT_EQ(hull.compute(xs.data(), ys.data(), xs.size()), 4u);
+  EXPECT_EQ(hull.point(2).y(), 2.0);
+
+  // degenerate inputs
+  EXPECT_EQ(hull.compute(xs.data(), ys.data(), 0), 0u);
+  EXPECT_EQ(hull.compute(xs.data(), ys.data(), 1), 1u);
+  std::vector<double> line_x = {0.0, 3.0, 1.0, 3.0}, line_y = {0.0, 3.0, 1.0, 3.0};
+  EXPECT_EQ(hull.compute(line_x.data(), line_y.data(), line_x.size()), 2u);
+  EXPECT_EQ(hull.compute(line_x.data() + 1, line_y.data() + 1, 1), 1u);
+  std::vector<double> same_x = {1.0, 1.0, 1.0}, same_y = {2.0, 2.0, 2.0};
+  EXPECT_EQ(hull.compute(same_x.data(), same_y.data(), 3), 1u);
+}
+
+TEST(ConvexHull2D, compute_ordered)
+{
+  // scan of a wall with a box in front, ordered by angle
+  std::vector<tf2::Point2D> scan;
+  for (int i = -40; i <= 40; i++) {
+    const double angle = i * 0.02;
+    const double range = std::abs(angle) < 0.2 ? 2.0 / std::cos(angle) : 3.0 / std::cos(angle);
+    scan.push_back(tf2::Point2D(range * std::cos(angle), range * std::sin(angle)));
+  }
+  tf2::ConvexHull2D ordered, unordered;
+  EXPECT_EQ(ordered.compute_ordered(scan.data(), scan.size()), unordered.compute(scan.data(), scan.size()));
+  EXPECT_NEAR(ordered.area(), unordered.area(), 1e-12);
+  // same vertices, possibly with a different start
+  size_t offset = 0;
+  while (offset < ordered.size() && ordered.indices()[offset] != unordered.indices()[0]) {
+    offset++;
+  }
+  ASSERT_LT(offset, ordered.size());
+  for (size_t i = 0; i < ordered.size(); i++) {
+    EXPECT_EQ(ordered.indices()[(i + offset) % ordered.size()], unordered.indices()[i]);
+  }
+
+  // collinear start and collinear points
+  std::vector<double> xs = {0.0, 1.0, 2.0, 3.0, 3.0, 1.5, -1.0}, ys = {0.0, 0.0, 0.0, 0.0, 1.0, 2.0, 1.0};
+  EXPECT_EQ(ordered.compute_ordered(xs.data(), ys.data(), xs.size()), unordered.compute(xs.data(), ys.data(), xs.size()));
+  EXPECT_NEAR(ordered.area(), unordered.area(), 1e-12);
+  EXPECT_EQ(ordered.compute_ordered(xs.data(), ys.data(), 4), 2u);
+  EXPECT_EQ(ordered.compute_ordered(xs.data(), ys.data(), 1), 1u);
+}
+
+TEST(ConvexHull2D, rectangles)
+{
+  // points of a rotated 4 x 1 rectangle
+  const tf2::Transform2D box(1.0, -2.0, 0.4);
+  std::vector<tf2::Point2D> points;
+  for (int i = 0; i <= 8; i++) {
+    for (int j = 0; j <= 2; j++) {
+      points.push_back(box * tf2::Point2D(-2.0 + 0.5 * i, -0.5 + 0.5 * j));
+    }
+  }
+  tf2::ConvexHull2D hull;
+  hull.compute(points.data(), points.size());
+  tf2::Transform2D pose;
+  double length, width;
+  EXPECT_NEAR(hull.min_area_rectangle(pose, length, width), 4.0, 1e-9);
+  EXPECT_NEAR(pose.x(), 1.0, 1e-9);
+  EXPECT_NEAR(pose.y(), -2.0, 1e-9);
+  EXPECT_NEAR(std::abs(std::sin(pose.rotation() - 0.4)), 0.0, 1e-9);
+  EXPECT_NEAR(length, 4.0, 1e-9);
+  EXPECT_NEAR(width, 1.0, 1e-9);
+  EXPECT_NEAR(hull.min_width_rectangle(pose, length, width), 1.0, 1e-9);
+
+  // the min width of a triangle is its smallest height, its min area rectangle has twice its area
+  std::vector<double> xs = {0.0, 4.0, 1.0}, ys = {0.0, 0.0, 1.0};
+  hull.compute(xs.data(), ys.data(), 3);
+  EXPECT_NEAR(hull.min_width_rectangle(pose, length, width), 1.0, 1e-9);
+  EXPECT_NEAR(length, 4.0, 1e-9);
+  EXPECT_NEAR(pose.x(), 2.0, 1e-9);
+  EXPECT_NEAR(pose.y(), 0.5, 1e-9);
+  EXPECT_NEAR(hull.min_area_rectangle(pose, length, width), 4.0, 1e-9);
+
+  // a segment
+  hull.compute(xs.data(), ys.data(), 2);
+  EXPECT_EQ(hull.min_area_rectangle(pose, length, width), 0.0);
+  EXPECT_NEAR(length, 4.0, 1e-12);
+  EXPECT_NEAR(pose.x(), 2.0, 1e-12);
+}
@@ -0,0 +1,181 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tf2_geometry/correlative_scan_matcher2d.hpp"
+#include "tf2_geometry/distance_field2d.hpp"
+
+namespace {
+std::vector<tf2::LineSegment2D> make_map()
+{
+  // an L shaped room with a pillar, not symmetric
+  return {
+    tf2::LineSegment2D(0.0, 0.0, 8.0, 0.0), tf2::LineSegment2D(8.0, 0.0, 8.0, 3.0),
+    tf2::LineSegment2D(8.0, 3.0, 3.0, 3.0), tf2::LineSegment2D(3.0, 3.0, 3.0, 6.0),
+    tf2::LineSegment2D(3.0, 6.0, 0.0, 6.0), tf2::LineSegment2D(0.0, 6.0, 0.0, 0.0),
+    tf2::LineSegment2D(5.0, 1.0, 5.5, 1.0), tf2::LineSegment2D(5.5, 1.0, 5.5, 1.6),
+    tf2::LineSegment2D(5.5, 1.6, 5.0, 1.6), tf2::LineSegment2D(5.0, 1.6, 5.0, 1.0)};
+}
+
+// casts rays from a pose and returns the hits in the frame of the pose
+std::vector<tf2::Point2D> make_scan(const std::vector<tf2::LineSegment2D> & map, double x, double y, double theta)
+{
+  std::vector<tf2::Point2D> scan;
+  for (int i = 0; i < 180; i++) {
+    const double a = theta + i * M_PI / 90.0, dx = std::cos(a), dy = std::sin(a);
+    double t_min = std::numeric_limits<double>::max();
+    for (const tf2::LineSegment2D & s : map) {
+      const double ex = s.x1() - s.x0(), ey = s.y1() - s.y0();
+      const double det = dx * ey - dy * ex;
+      if (std::fabs(det) < 1e-12) {
+        continue;
+      }
+      const double wx = s.x0() - x, wy = s.y0() - y;
+      const double t = (wx * ey - wy * ex) / det, u = (wx * dy - wy * dx) / det;
+      if (t > 0.0 && u >= 0.0 && u <= 1.0) {
+        t_min = std::min(t_min, t);
+      }
+    }
+    const double b = i * M_PI / 90.0;
+    scan.push_back(tf2::Point2D(t_min * std::cos(b), t_min * std::sin(b)));
+  }
+  return scan;
+}
+
+tf2::DistanceField2D make_field(const std::vector<tf2::LineSegment2D> & map)
+{
+  tf2::DistanceField2D::Config config;
+  config.resolution = 0.05, config.width = 180, config.height = 140;
+  config.origin.set(-0.5, -0.5, 0.0);
+  config.max_distance = 0.5, config.sigma = 0.1;
+  tf2::DistanceField2D field(config);
+  field.build(map.data(), map.size());
+  return field;
+}
+}  // namespace
+
+TEST(CorrelativeScanMatcher2D, pyramid)
+{
+  const float grid[6] = {0.1f, 0.5f, 0.2f, 0.3f, 0.0f, 0.9f};
+  tf2::CorrelativeScanMatcher2D::Config config;
+  config.levels = 3;
+  tf2::CorrelativeScanMatcher2D matcher(config);
+  matcher.set_map(grid, 3, 2, 1.0, tf2::Transform2D());
+  ASSERT_EQ(matcher.levels(), 3u);
+  // level 1 has a padding of one cell, cell (x, y) is the max of [x, x + 2) x [y, y + 2)
+  const std::vector<float> & level1 = matcher.level(1);
+  ASSERT_EQ(level1.size(), 4u * 3u);
+  EXPECT_FLOAT_EQ(level1[0], 0.1f);           // (-1, -1)
+  EXPECT_FLOAT_EQ(level1[1 * 4 + 1], 0.5f);   // (0, 0)
+  EXPECT_FLOAT_EQ(level1[1 * 4 + 2], 0.9f);   // (1, 0)
+  EXPECT_FLOAT_EQ(level1[2 * 4 + 3], 0.9f);   // (2, 1)
+  // level 2 covers the whole grid from (-1, -1)
+  EXPECT_FLOAT_EQ(matcher.level(2)[2 * 6 + 2], 0.9f);
+
+  // coarser levels than the grid or the window are not built
+  config.levels = 16;
+  matcher.configure(config);
+  ASSERT_EQ(matcher.levels(), 3u);
+  std::vector<float> large(1000 * 800, 0.5f);
+  matcher.set_map(large.data(), 1000, 800, 0.1, tf2::Transform2D());
+  // window of 10 cells to each side, 2^5 > 21
+  ASSERT_EQ(matcher.levels(), 6u);
+}
+
+TEST(CorrelativeScanMatcher2D, match)
+{
+  std::vector<tf2::LineSegment2D> map = make_map();
+  tf2::DistanceField2D field = make_field(map);
+  std::vector<tf2::Point2D> scan = make_scan(map, 1.5, 1.2, 0.4);
+
+  tf2::CorrelativeScanMatcher2D::Config config;
+  config.linear_window = 0.6, config.angular_window = 0.3, config.min_score = 0.3;
+  tf2::CorrelativeScanMatcher2D matcher(config);
+  matcher.set_execution_policy(tf2::ExecutionPolicy::sequential());
+  matcher.set_map(field);
+  tf2::CorrelativeScanMatcher2D::Result result;
+  ASSERT_TRUE(matcher.match(scan.data(), scan.size(), tf2::Transform2D(1.9, 0.9, 0.2), result));
+  // within a cell
+  EXPECT_NEAR(result.pose.x(), 1.5, 0.075);
+  EXPECT_NEAR(result.pose.y(), 1.2, 0.075);
+  EXPECT_NEAR(result.pose.rotation(), 0.4, 0.03);
+  EXPECT_GT(result.score, 0.8);
+
+  // branch and bound finds the same pose as the exhaustive search on level 0 with fewer candidates
+  config.levels = 1;
+  tf2::CorrelativeScanMatcher2D exhaustive(config);
+  exhaustive.set_map(field);
+  tf2::CorrelativeScanMatcher2D::Result expected;
+  ASSERT_TRUE(exhaustive.match(scan.data(), scan.size(), tf2::Transform2D(1.9, 0.9, 0.2), expected));
+  EXPECT_DOUBLE_EQ(result.score, expected.score);
+  EXPECT_DOUBLE_EQ(result.pose.x(), expected.pose.x());
+  EXPECT_DOUBLE_EQ(result.pose.y(), expected.pose.y());
+  EXPECT_DOUBLE_EQ(result.pose.rotation(), expected.pose.rotation());
+  EXPECT_LT(result.candidates * 10, expected.candidates);
+
+  // the true pose is outside of the window
+  config.levels = 7, config.min_score = 0.8;
+  matcher.configure(config);
+  EXPECT_FALSE(matcher.match(scan.data(), scan.size(), tf2::Transform2D(3.0, 2.0, 0.2), result));
+}
+
+TEST(CorrelativeScanMatcher2D, invalid_config)
+{
+  std::vector<tf2::LineSegment2D> map = make_map();
+  tf2::DistanceField2D field = make_field(map);
+  std::vector<tf2::Point2D> scan = make_scan(map, 1.5, 1.2, 0.4);
+  tf2::CorrelativeScanMatcher2D::Result result;
+
+  // non-finite windows fall back to the default, negative ones search the prior only
+  tf2::CorrelativeScanMatcher2D::Config config;
+  config.min_score = 0.0;
+  for (double window : {-1.0, std::nan("")}) {
+    config.linear_window = window, config.angular_window = window;
+    tf2::CorrelativeScanMatcher2D matcher(config);
+    matcher.set_execution_policy(tf2::ExecutionPolicy::sequential());
+    ASSERT_TRUE(matcher.set_map(field));
+    EXPECT_GE(matcher.config().linear_window, 0.0);
+    EXPECT_GE(matcher.config().angular_window, 0.0);
+    EXPECT_TRUE(matcher.match(scan.data(), scan.size(), tf2::Transform2D(1.5, 1.2, 0.4), result));
+  }
+  config.linear_window = -1.0, config.angular_window = -1.0;
+  tf2::CorrelativeScanMatcher2D matcher(config);
+  matcher.set_execution_policy(tf2::ExecutionPolicy::sequential());
+  matcher.set_map(field);
+  ASSERT_TRUE(matcher.match(scan.data(), scan.size(), tf2::Transform2D(1.5, 1.2, 0.4), result));
+  EXPECT_EQ(result.candidates, 1u);
+
+  // a tiny step is coarsened and a huge window is bounded by the grid
+  config.linear_window = 1e12, config.angular_window = 1e12, config.angular_step = 1e-12, config.levels = 16;
+  matcher.configure(config);
+  EXPECT_DOUBLE_EQ(matcher.config().angular_window, M_PI);
+  EXPECT_TRUE(matcher.match(scan.data(), scan.size(), tf2::Transform2D(1.5, 1.2, 0.4), result));
+
+  // non-finite and far scan points score like points outside of the map
+  config = tf2::CorrelativeScanMatcher2D::Config();
+  config.linear_window = 0.6, config.angular_window = 0.3, config.angular_step = 0.02, config.min_score = 0.3;
+  matcher.configure(config);
+  ASSERT_TRUE(matcher.set_map(field));
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector<tf2::Point2D> invalid = scan, outside = scan;
+  invalid[3] = tf2::Point2D(std::nan(""), 1.0), invalid[50] = tf2::Point2D(inf, -inf);
+  invalid[90] = tf2::Point2D(1e300, 0.0), invalid[170] = tf2::Point2D(0.0, -1e12);
+  for (size_t i : {3, 50, 90, 170}) {
+    outside[i] = tf2::Point2D(100.0, 100.0);
+  }
+  tf2::CorrelativeScanMatcher2D::Result expected;
+  ASSERT_TRUE(matcher.match(outside.data(), outside.size(), tf2::Transform2D(1.9, 0.9, 0.2), expected));
+  ASSERT_TRUE(matcher.match(invalid.data(), invalid.size(), tf2::Transform2D(1.9, 0.9, 0.2), result));
+  EXPECT_EQ(result.pose.x(), expected.pose.x());
+  EXPECT_EQ(result.pose.y(), expected.pose.y());
+  EXPECT_EQ(result.pose.rotation(), expected.pose.rotation());
+  EXPECT_EQ(result.score, expected.score);
+
+  // invalid resolutions clear the map
+  const float grid[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+  for (double resolution : {0.0, -0.1, std::nan("")}) {
+    EXPECT_FALSE(matcher.set_map(grid, 2, 2, resolution, tf2::Transform2D()));
+    EXPECT_EQ(matcher.levels(), 0u);
+    EXPECT_FALSE(matcher.match(scan.data(), scan.size(), tf2::Transform2D(), result));
+  }
+}
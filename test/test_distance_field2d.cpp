@@ -0,0 +1,145 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tf2_geometry/distance_field2d.hpp"
+
+namespace {
+std::vector<tf2::LineSegment2D> make_map()
+{
+  // a 6 x 4 room with a wall in the middle and a diagonal
+  return {
+    tf2::LineSegment2D(0.1, 0.1, 6.0, 0.1), tf2::LineSegment2D(6.0, 0.1, 6.0, 4.0),
+    tf2::LineSegment2D(6.0, 4.0, 0.1, 4.0), tf2::LineSegment2D(0.1, 4.0, 0.1, 0.1),
+    tf2::LineSegment2D(3.0, 0.1, 3.0, 2.5), tf2::LineSegment2D(4.0, 3.0, 5.5, 1.0)};
+}
+
+tf2::DistanceField2D::Config make_config()
+{
+  tf2::DistanceField2D::Config config;
+  config.resolution = 0.05, config.width = 130, config.height = 90;
+  config.origin.set(-0.2, -0.1, 0.05);
+  config.max_distance = 0.8, config.sigma = 0.2, config.levels = 3;
+  return config;
+}
+}  // namespace
+
+TEST(DistanceField2D, exact_transform)
+{
+  tf2::DistanceField2D::Config config = make_config();
+  std::vector<tf2::LineSegment2D> map = make_map();
+  tf2::DistanceField2D field(config);
+  field.build(map.data(), map.size());
+
+  // brute force distance between the cell centers and the occupied cells
+  tf2::SegmentRasterizer2D::Config raster;
+  raster.resolution = config.resolution, raster.width = config.width, raster.height = config.height;
+  raster.origin.set(config.origin);
+  tf2::SegmentRasterizer2D rasterizer(raster);
+  std::vector<int8_t> occupied(rasterizer.size(), 0);
+  rasterizer.rasterize(map.data(), map.size(), occupied.data());
+  std::vector<std::pair<int, int>> cells;
+  for (int y = 0; y < static_cast<int>(config.height); y++) {
+    for (int x = 0; x < static_cast<int>(config.width); x++) {
+      if (occupied[y * config.width + x]) {
+        cells.push_back({x, y});
+      }
+    }
+  }
+  const std::vector<float> & distances = field.distances();
+  for (int y = 0; y < static_cast<int>(config.height); y += 3) {
+    for (int x = 0; x < static_cast<int>(config.width); x += 2) {
+      double d2 = 1e9;
+      for (auto & c : cells) {
+        d2 = std::min(d2, static_cast<double>((c.first - x) * (c.first - x) + (c.second - y) * (c.second - y)));
+      }
+      double d = std::min(config.max_distance, std::sqrt(d2) * config.resolution);
+      ASSERT_NEAR(d, distances[y * config.width + x], 1e-5);
+    }
+  }
+
+  // point lookups, the cells are within one cell diagonal of the segments
+  tf2::Point2D on_wall(3.0, 1.0), free(1.5, 2.0);
+  EXPECT_LT(field.distance(on_wall), config.resolution);
+  EXPECT_NEAR(0.8, field.distance(free), 1e-6);
+  EXPECT_NEAR(1.0, field.likelihood(on_wall), 0.05);
+  EXPECT_NEAR(0.8, field.distance(tf2::Point2D(-5.0, 0.0)), 1e-6);
+  std::vector<tf2::Point2D> points = {on_wall, free};
+  std::vector<double> d(2);
+  field.distances(points.data(), points.size(), d.data());
+  EXPECT_EQ(field.distance(free), d[1]);
+  EXPECT_NEAR(field.likelihood(on_wall) + field.likelihood(free), field.score(points.data(), points.size()), 1e-9);
+
+  // coarse levels are lower bounds
+  for (size_t k = 1; k < config.levels; k++) {
+    ASSERT_EQ((config.width + (1u << k) - 1) >> k, field.width(k));
+    for (uint32_t y = 0; y < config.height; y++) {
+      for (uint32_t x = 0; x < config.width; x++) {
+        ASSERT_LE(field.distances(k)[(y >> k) * field.width(k) + (x >> k)], distances[y * config.width + x]);
+      }
+    }
+  }
+}
+
+TEST(DistanceField2D, update)
+{
+  tf2::DistanceField2D::Config config = make_config();
+  std::vector<tf2::LineSegment2D> map = make_map();
+  tf2::DistanceField2D field(config);
+  field.build(map.data(), map.size());
+  EXPECT_EQ(0u, field.update(map.data(), map.size()));
+
+  // moves the diagonal and adds a short wall
+  map[5].set(tf2::Point2D(4.2, 3.0), tf2::Point2D(5.5, 1.5));
+  map.push_back(tf2::LineSegment2D(1.0, 3.0, 1.5, 3.0));
+  size_t cells = field.update(map.data(), map.size());
+  EXPECT_GT(cells, 0u);
+  EXPECT_LT(cells, static_cast<size_t>(config.width) * config.height);
+
+  tf2::DistanceField2D reference(config);
+  reference.build(map.data(), map.size());
+  for (size_t k = 0; k < config.levels; k++) {
+    ASSERT_EQ(reference.distances(k), field.distances(k));
+  }
+  ASSERT_EQ(reference.likelihoods(), field.likelihoods());
+}
+
+TEST(DistanceField2D, no_likelihood)
+{
+  tf2::DistanceField2D::Config config = make_config();
+  config.sigma = 0.0;
+  std::vector<tf2::LineSegment2D> map = make_map();
+  tf2::DistanceField2D field(config);
+  field.build(map.data(), map.size());
+  EXPECT_TRUE(field.likelihoods().empty());
+
+  // inside and outside the grid
+  std::vector<tf2::Point2D> points = {tf2::Point2D(3.0, 1.0), tf2::Point2D(-5.0, 0.0)};
+  EXPECT_EQ(0.0, field.likelihood(points[0]));
+  EXPECT_EQ(0.0, field.likelihood(points[1]));
+  EXPECT_EQ(0.0, field.score(points.data(), points.size()));
+}
+
+TEST(DistanceField2D, invalid_config)
+{
+  std::vector<tf2::LineSegment2D> map = make_map();
+  for (double value : {0.0, -0.1, std::nan(""), std::numeric_limits<double>::infinity()}) {
+    tf2::DistanceField2D::Config config = make_config();
+    config.resolution = value, config.max_distance = value;
+    tf2::DistanceField2D field(config);
+    ASSERT_EQ(tf2::DistanceField2D::Config().resolution, field.config().resolution);
+    ASSERT_EQ(tf2::DistanceField2D::Config().max_distance, field.config().max_distance);
+    field.build(map.data(), map.size());
+    ASSERT_GT(field.update(map.data(), map.size() - 1), 0u);
+  }
+
+  // levels stop at a single cell, 2^8 >= 130
+  tf2::DistanceField2D::Config config = make_config();
+  config.levels = 100;
+  tf2::DistanceField2D field(config);
+  ASSERT_EQ(9u, field.config().levels);
+  ASSERT_EQ(1u, field.width(8));
+  ASSERT_EQ(1u, field.height(8));
+  field.build(map.data(), map.size());
+  ASSERT_GE(field.distances(8)[0], 0.0f);
+}
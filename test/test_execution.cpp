@@ -0,0 +1,104 @@
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/pixel_ray_table.hpp"
+#include "tf2_geometry/plane3d.hpp"
+#include "tf2_geometry/segment_index2d.hpp"
+
+TEST(ThreadPool, parallel_for)
+{
+  tf2::ThreadPool::Config config;
+  config.num_threads = 4;
+  tf2::ThreadPool pool(config);
+  ASSERT_EQ(4u, pool.size());
+
+  // every index is visited exactly once, also if the pool is reused
+  std::vector<std::atomic<int>> visits(10007);
+  for (int run = 0; run < 3; run++) {
+    pool.parallel_for(visits.size(), 13 * run, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        visits[i]++;
+      }
+    });
+  }
+  for (auto & v : visits) {
+    ASSERT_EQ(3, v.load());
+  }
+
+  // nested calls run inline
+  std::atomic<size_t> nested{0};
+  pool.parallel_for(8, 1, [&](size_t, size_t) {
+    pool.parallel_for(10, 3, [&](size_t begin, size_t end) {nested += end - begin;});
+  });
+  ASSERT_EQ(80u, nested.load());
+
+  // exceptions are rethrown on the caller
+  EXPECT_THROW(
+    pool.parallel_for(100, 1, [](size_t begin, size_t) {
+      if (begin == 42) {
+        throw std::runtime_error("chunk 42");
+      }
+    }), std::runtime_error);
+}
+
+TEST(ExecutionPolicy, kernels)
+{
+  tf2::ThreadPool::Config config;
+  config.num_threads = 3;
+  tf2::ThreadPool pool(config);
+  std::vector<tf2::ExecutionPolicy> policies = {
+    tf2::ExecutionPolicy::sequential(), tf2::ExecutionPolicy::parallel_unsequenced(100),
+    tf2::ExecutionPolicy::thread_pool(pool), tf2::ExecutionPolicy::thread_pool(pool, 7)};
+  ASSERT_EQ(1u, policies[0].concurrency());
+  ASSERT_EQ(3u, policies[2].concurrency());
+
+  // plane classification
+  tf2::Plane3D plane(0., 0., 1., -0.5);
+  std::vector<tf2::Point3D> points3d;
+  for (int i = 0; i < 1000; i++) {
+    points3d.push_back(tf2::Point3D(0.01 * i, -0.02 * i, 0.001 * i));
+  }
+  std::vector<uint8_t> expected(points3d.size()), mask(points3d.size());
+  size_t inliers = plane.classify(points3d.data(), points3d.size(), 0.1, expected.data());
+
+  // point to segment scoring
+  std::vector<tf2::LineSegment2D> segments = {
+    tf2::LineSegment2D(0., 0., 10., 0.), tf2::LineSegment2D(10., 0., 10., 6.),
+    tf2::LineSegment2D(10., 6., 0., 6.), tf2::LineSegment2D(0., 6., 0., 0.)};
+  tf2::SegmentIndex2D index;
+  index.build(segments.data(), segments.size(), 1.0);
+  std::vector<tf2::Point2D> points2d;
+  for (int i = 0; i < 500; i++) {
+    points2d.push_back(tf2::Point2D(-1.0 + 0.025 * i, 0.013 * i));
+  }
+  std::vector<size_t> expected_idx(points2d.size()), idx(points2d.size());
+  std::vector<double> expected_d(points2d.size()), d(points2d.size());
+  size_t found = index.nearest(points2d.data(), points2d.size(), 1.5, expected_idx.data(), expected_d.data());
+
+  // ray casting
+  tf2::PixelRayTable::Intrinsics intrinsics;
+  intrinsics.fx = 100, intrinsics.fy = 100, intrinsics.cx = 50, intrinsics.cy = 40;
+  intrinsics.width = 101, intrinsics.height = 81;
+  tf2::PixelRayTable rays(intrinsics);
+  rays.set_pose(tf2::Transform(tf2::Matrix3x3(0, 0, 1, -1, 0, 0, 0, -1, 0), tf2::Vector3(0, 0, 1)));
+  tf2::Plane3D ground(0., 0., 1., 0.);
+  std::vector<tf2::Point2D> expected_hits(rays.size()), hits(rays.size());
+  std::vector<uint8_t> expected_valid(rays.size()), valid(rays.size());
+  size_t n_hits = rays.project(ground, expected_hits.data(), expected_valid.data());
+
+  for (const auto & policy : policies) {
+    ASSERT_EQ(inliers, plane.classify(policy, points3d.data(), points3d.size(), 0.1, mask.data()));
+    ASSERT_EQ(expected, mask);
+    ASSERT_EQ(found, index.nearest(policy, points2d.data(), points2d.size(), 1.5, idx.data(), d.data()));
+    ASSERT_EQ(expected_idx, idx);
+    ASSERT_EQ(expected_d, d);
+    ASSERT_EQ(n_hits, rays.project(policy, ground, hits.data(), valid.data()));
+    ASSERT_EQ(expected_valid, valid);
+    for (size_t i = 0; i < hits.size(); i++) {
+      ASSERT_EQ(expected_hits[i].x(), hits[i].x());
+      ASSERT_EQ(expected_hits[i].y(), hits[i].y());
+    }
+  }
+}
@@ -0,0 +1,77 @@
+#include <cmath>
+#include <limits>
+#include "gtest/gtest.h"
+#include "tf2_geometry/hough2d.hpp"
+
+
+TEST(HoughLines2D, detect)
+{
+  double tolerance = 0.05;
+  std::vector<tf2::Point2D> points;
+  for (int i = 0; i < 100; i++) {
+    points.push_back(tf2::Point2D(2.0, -2.0 + i * 0.04));  // x = 2
+    points.push_back(tf2::Point2D(-3.0 + i * 0.05, 1.0));  // y = 1
+  }
+  points.push_back(tf2::Point2D(50.0, 50.0));  // out of range
+
+  tf2::HoughLines2D::Config config;
+  config.threshold = 50;
+  tf2::HoughLines2D hough(config);
+  std::vector<tf2::Line2D> lines;
+  ASSERT_EQ(2u, hough.detect(points, lines));
+  ASSERT_EQ(2u, hough.peaks().size());
+  for (const auto & l : lines) {
+    ASSERT_NEAR(1.0, l.a() * l.a() + l.b() * l.b(), tolerance);
+    ASSERT_NEAR(0.0, l.distance_to(tf2::Point2D(2.0, 1.0)), tolerance);
+  }
+  // y = 1 gets one more vote from the shared point (2, 1)
+  ASSERT_EQ(101u, hough.peaks()[0].votes);
+  ASSERT_NEAR(0.0, lines[0].distance_to(tf2::Point2D(-3.0, 1.0)), tolerance);
+  ASSERT_NEAR(0.0, lines[1].distance_to(tf2::Point2D(2.0, -2.0)), tolerance);
+
+  // invalid resolutions fall back to the default
+  for (double resolution : {0.0, -0.1, std::nan("")}) {
+    config.rho_resolution = resolution;
+    hough.configure(config);
+    ASSERT_EQ(tf2::HoughLines2D::Config().rho_resolution, hough.config().rho_resolution);
+    ASSERT_EQ(1001u, hough.rho_bins());
+    ASSERT_EQ(2u, hough.detect(points, lines));
+  }
+
+  // non-finite ranges fall back to the default, huge ones coarsen the resolution
+  for (double rho_max : {std::nan(""), std::numeric_limits<double>::infinity()}) {
+    config.rho_max = rho_max;
+    hough.configure(config);
+    ASSERT_EQ(tf2::HoughLines2D::Config().rho_max, hough.config().rho_max);
+    ASSERT_EQ(1001u, hough.rho_bins());
+  }
+  config.rho_max = 1e12;
+  hough.configure(config);
+  ASSERT_EQ(2u * 32768u + 1u, hough.rho_bins());
+  ASSERT_DOUBLE_EQ(1e12 / 32768, hough.config().rho_resolution);
+}
+
+TEST(HoughLines2D, parallel)
+{
+  std::vector<tf2::Point2D> points;
+  for (int i = 0; i < 2000; i++) {
+    points.push_back(tf2::Point2D(-4.0 + i * 0.004, 1.0 - 4.0 + i * 0.004));  // y = x + 1
+  }
+  tf2::HoughLines2D::Config config;
+  config.threshold = 1000;
+  tf2::HoughLines2D single(config);
+  config.num_threads = 4;
+  config.block_size = 64;
+  tf2::HoughLines2D parallel(config);
+  std::vector<tf2::Line2D> lines_single, lines_parallel;
+  single.detect(points, lines_single);
+  parallel.detect(points, lines_parallel);
+  ASSERT_EQ(single.accumulator(), parallel.accumulator());
+  ASSERT_EQ(1u, lines_parallel.size());
+  ASSERT_NEAR(0.0, lines_parallel[0].distance_to(tf2::Point2D(0.0, 1.0)), 0.05);
+
+  // the voting tasks give the same result on the calling thread
+  parallel.set_execution_policy(tf2::ExecutionPolicy::sequential());
+  parallel.detect(points, lines_parallel);
+  ASSERT_EQ(single.accumulator(), parallel.accumulator());
+}
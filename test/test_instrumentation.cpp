@@ -0,0 +1,103 @@
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/instrumentation.hpp"
+#include "tf2_geometry/map2d.hpp"
+#include "tf2_geometry/obb2d.hpp"
+#include "tf2_geometry/plane3d.hpp"
+#include "tf2_geometry/plane3d_array.hpp"
+#include "tf2_geometry/transform2d.hpp"
+
+namespace {
+size_t g_trace_begin = 0, g_trace_end = 0;
+void trace(tf2::instrumentation::Kernel, size_t, bool begin)
+{
+  (begin ? g_trace_begin : g_trace_end)++;
+}
+}  // namespace
+
+TEST(Instrumentation, counters)
+{
+  using namespace tf2::instrumentation;
+  ASSERT_EQ(std::string("transform2d_cache_hit"), name(kTransform2DCacheHit));
+  ASSERT_EQ(std::string("plane3d_distances"), name(kPlane3DDistances));
+  reset();
+  set_trace_callback(trace);
+
+  tf2::Transform2D tf(1.0, 2.0, 0.5);
+  tf2::Point2D p = tf * tf2::Point2D(1.0, 0.0);
+  tf2::Transform2D copy(tf);
+  p = copy * p;
+  p = tf * p;
+  tf.set_rotation(0.1);
+
+  tf2::Plane3D plane(0., 0., 1., 0.);
+  std::vector<tf2::Point3D> points(10);
+  std::vector<tf2Scalar> distances(points.size());
+  plane.distances_to(points.data(), points.size(), distances.data());
+  set_trace_callback(nullptr);
+
+  Snapshot s;
+  snapshot(s);
+  if (enabled()) {
+    /// the copy keeps the cache, so only the first transform computes cos/sin
+    ASSERT_EQ(1u, s.counters[kTransform2DCacheRecompute]);
+    ASSERT_EQ(2u, s.counters[kTransform2DCacheHit]);
+    ASSERT_EQ(1u, s.counters[kTransform2DCopy]);
+    ASSERT_EQ(1u, s.counters[kTransform2DCacheInvalidate]);
+    ASSERT_EQ(1u, s.calls[kPlane3DDistances]);
+    ASSERT_EQ(10u, s.elements[kPlane3DDistances]);
+  } else {
+    ASSERT_EQ(0u, s.counters[kTransform2DCacheRecompute]);
+    ASSERT_EQ(0u, s.calls[kPlane3DDistances]);
+  }
+#if defined(TF2_GEOMETRY_ENABLE_TRACEPOINTS)
+  ASSERT_EQ(1u, g_trace_begin);
+  ASSERT_EQ(1u, g_trace_end);
+#else
+  ASSERT_EQ(0u, g_trace_begin);
+#endif
+  reset();
+  snapshot(s);
+  ASSERT_EQ(0u, s.elements[kPlane3DDistances]);
+}
+
+TEST(Instrumentation, policy_counts_once)
+{
+  using namespace tf2::instrumentation;
+  tf2::ThreadPool pool;
+  const tf2::ExecutionPolicy policy = tf2::ExecutionPolicy::thread_pool(pool, 16);
+  tf2::Plane3D plane(0., 0., 1., 0.);
+  std::vector<tf2::Point3D> points(100);
+  std::vector<tf2Scalar> distances(points.size());
+  std::vector<uint8_t> mask(points.size());
+  reset();
+  plane.distances_to(policy, points.data(), points.size(), distances.data());
+  plane.classify(policy, points.data(), points.size(), 0.1, mask.data());
+  tf2::Plane3DArray planes;
+  planes.push_back(plane);
+  planes.contains(policy, points.data(), points.size(), mask.data());
+  std::vector<tf2::OBB2D> boxes(points.size(), tf2::OBB2D(tf2::Transform2D(), 1.0, 1.0));
+  tf2::OBB2D(tf2::Transform2D(0.0, 0.0, 0.5), 2.0, 1.0).intersects(policy, boxes.data(), boxes.size(), mask.data());
+  tf2::Map2D map;
+  std::vector<tf2::Point2D> points2d(points.size());
+  map.to_map(policy, points.data(), points.size(), points2d.data());
+  map.to_world(policy, points2d.data(), points2d.size(), points.data(), distances.data());
+
+  Snapshot s;
+  snapshot(s);
+  if (enabled()) {
+    /// one call per policy overload, not one per chunk
+    ASSERT_EQ(1u, s.calls[kPlane3DDistances]);
+    ASSERT_EQ(100u, s.elements[kPlane3DDistances]);
+    ASSERT_EQ(1u, s.calls[kPlane3DClassify]);
+    ASSERT_EQ(100u, s.elements[kPlane3DClassify]);
+    ASSERT_EQ(1u, s.calls[kPlane3DArrayContains]);
+    ASSERT_EQ(1u, s.calls[kOBB2DIntersects]);
+    ASSERT_EQ(1u, s.calls[kMap2DToMap]);
+    ASSERT_EQ(1u, s.calls[kMap2DToWorld]);
+    ASSERT_EQ(100u, s.elements[kMap2DToWorld]);
+  }
+  reset();
+}
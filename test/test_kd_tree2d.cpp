@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/kd_tree2d.hpp"
+
+namespace {
+std::vector<tf2::Point2D> make_points(size_t n)
+{
+  // clustered points with duplicates on a line
+  std::vector<tf2::Point2D> points;
+  for (size_t i = 0; i < n; i++) {
+    if (i % 7 == 0) {
+      points.push_back(tf2::Point2D(1.0, 0.5 * (i % 5)));
+    } else {
+      points.push_back(tf2::Point2D(10.0 * std::sin(i * 0.37) + std::cos(i * 3.1), 5.0 * std::cos(i * 0.11)));
+    }
+  }
+  return points;
+}
+
+std::vector<std::pair<double, size_t>> brute_force(const std::vector<tf2::Point2D> & points, const tf2::Point2D & p)
+{
+  std::vector<std::pair<double, size_t>> des;
+  for (size_t i = 0; i < points.size(); i++) {
+    des.push_back({p.distance_to_sqrt(points[i]), i});
+  }
+  std::sort(des.begin(), des.end());
+  return des;
+}
+}  // namespace
+
+TEST(KdTree2D, queries)
+{
+  std::vector<tf2::Point2D> points = make_points(1000);
+  tf2::KdTree2D tree;
+  tree.build(points.data(), points.size(), 4);
+  EXPECT_EQ(tree.size(), points.size());
+
+  std::vector<size_t> indices(5), found;
+  std::vector<double> distances(5);
+  for (int i = 0; i < 200; i++) {
+    const tf2::Point2D p(12.0 * std::sin(i * 1.7), 6.0 * std::cos(i * 0.9));
+    const std::vector<std::pair<double, size_t>> expected = brute_force(points, p);
+
+    double d;
+    const size_t k = tree.nearest(p, std::numeric_limits<double>::infinity(), &d);
+    ASSERT_NE(k, tf2::KdTree2D::npos);
+    EXPECT_DOUBLE_EQ(d, expected[0].first);
+    EXPECT_DOUBLE_EQ(p.distance_to_sqrt(points[k]), expected[0].first);
+
+    ASSERT_EQ(tree.knn(p, 5, indices.data(), distances.data()), 5u);
+    for (size_t j = 0; j < 5; j++) {
+      EXPECT_DOUBLE_EQ(distances[j], expected[j].first);
+      EXPECT_DOUBLE_EQ(p.distance_to_sqrt(points[indices[j]]), expected[j].first);
+    }
+
+    const double epsilon = 0.5;
+    tree.approximate_nearest(p, epsilon, std::numeric_limits<double>::infinity(), &d);
+    EXPECT_LE(d, (1.0 + epsilon) * (1.0 + epsilon) * expected[0].first + 1e-12);
+
+    const double r2 = 1.5;
+    tree.radius(p, r2, found);
+    std::vector<size_t> inside;
+    for (auto & e : expected) {
+      if (e.first <= r2) {
+        inside.push_back(e.second);
+      }
+    }
+    std::sort(inside.begin(), inside.end());
+    EXPECT_EQ(found, inside);
+  }
+
+  // search radius and missing neighbours
+  const tf2::Point2D far(100.0, 100.0);
+  double d;
+  EXPECT_EQ(tree.nearest(far, 1.0, &d), tf2::KdTree2D::npos);
+  EXPECT_TRUE(std::isinf(d));
+  EXPECT_EQ(tree.knn(tf2::Point2D(1.0, 0.0), 5, indices.data(), distances.data(), 1e-6), 5u);  // duplicates
+  EXPECT_EQ(tree.knn(far, 5, indices.data(), distances.data(), 1.0), 0u);
+  EXPECT_EQ(indices[4], tf2::KdTree2D::npos);
+
+  tf2::KdTree2D empty;
+  empty.build(points.data(), 0);
+  EXPECT_EQ(empty.nearest(far), tf2::KdTree2D::npos);
+  EXPECT_EQ(empty.radius(far, 1e6, found), 0u);
+}
+
+TEST(KdTree2D, non_finite)
+{
+  // invalid returns are skipped, the indices still refer to the input array
+  const double nan = std::nan(""), inf = std::numeric_limits<double>::infinity();
+  std::vector<tf2::Point2D> points = make_points(300), finite;
+  for (size_t i = 0; i < points.size(); i++) {
+    if (i % 5 == 1) {
+      points[i] = tf2::Point2D(i % 2 ? nan : inf, 1.0);
+    } else if (i % 5 == 3) {
+      points[i] = tf2::Point2D(1.0, i % 2 ? -inf : nan);
+    } else {
+      finite.push_back(points[i]);
+    }
+  }
+  tf2::KdTree2D tree;
+  tree.build(points.data(), points.size(), 2);
+  ASSERT_EQ(tree.size(), finite.size());
+  std::vector<size_t> found;
+  for (int i = 0; i < 50; i++) {
+    const tf2::Point2D p(12.0 * std::sin(i * 1.7), 6.0 * std::cos(i * 0.9));
+    const std::vector<std::pair<double, size_t>> expected = brute_force(finite, p);
+    double d;
+    const size_t k = tree.nearest(p, inf, &d);
+    ASSERT_NE(k, tf2::KdTree2D::npos);
+    EXPECT_DOUBLE_EQ(d, expected[0].first);
+    EXPECT_DOUBLE_EQ(p.distance_to_sqrt(points[k]), expected[0].first);
+    tree.radius(p, 2.0, found);
+    for (size_t j : found) {
+      EXPECT_TRUE(std::isfinite(points[j].x()) && std::isfinite(points[j].y()));
+    }
+  }
+
+  // only invalid returns
+  std::vector<tf2::Point2D> invalid(20, tf2::Point2D(nan, nan));
+  tree.build(invalid.data(), invalid.size());
+  EXPECT_EQ(tree.size(), 0u);
+  EXPECT_EQ(tree.nearest(tf2::Point2D(0.0, 0.0)), tf2::KdTree2D::npos);
+}
+
+TEST(KdTree2D, parallel)
+{
+  std::vector<tf2::Point2D> points = make_points(5000), queries = make_points(777);
+  tf2::ThreadPool::Config config;
+  config.num_threads = 4;
+  tf2::ThreadPool pool(config);
+  const tf2::ExecutionPolicy policy = tf2::ExecutionPolicy::thread_pool(pool, 16);
+
+  tf2::KdTree2D sequential, parallel;
+  sequential.build(points.data(), points.size());
+  parallel.build(policy, points.data(), points.size());
+
+  const size_t n = queries.size(), k = 3;
+  std::vector<size_t> i0(n), i1(n), k0(n * k), k1(n * k);
+  std::vector<double> d0(n), d1(n), kd0(n * k), kd1(n * k);
+  EXPECT_EQ(sequential.nearest(queries.data(), n, 4.0, i0.data(), d0.data()), parallel.nearest(policy, queries.data(), n, 4.0, i1.data(), d1.data()));
+  EXPECT_EQ(d0, d1);
+  sequential.knn(queries.data(), n, k, k0.data(), kd0.data());
+  parallel.knn(policy, queries.data(), n, k, k1.data(), kd1.data());
+  EXPECT_EQ(kd0, kd1);
+  for (size_t i = 0; i < n; i++) {
+    EXPECT_DOUBLE_EQ(kd0[i * k], d0[i]);
+  }
+}
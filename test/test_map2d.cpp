@@ -0,0 +1,72 @@
+#include <cmath>
+#include "gtest/gtest.h"
+#include "tf2_geometry/map2d.hpp"
+
+
+TEST(Map2D, ground)
+{
+  double tolerance = 0.0001;
+  tf2::Map2D map;
+  tf2::Point2D p = map.to_map(tf2::Point3D(1.0, 2.0, 3.0));
+  ASSERT_NEAR(1.0, p.x(), tolerance);
+  ASSERT_NEAR(2.0, p.y(), tolerance);
+
+  map.set_origin(tf2::Transform2D(1.0, 1.0, M_PI / 2.0));
+  map.to_map(tf2::Point3D(1.0, 2.0, 3.0), p);
+  ASSERT_NEAR(1.0, p.x(), tolerance);
+  ASSERT_NEAR(0.0, p.y(), tolerance);
+  tf2::Point3D q = map.to_world(p);
+  ASSERT_NEAR(1.0, q.x(), tolerance);
+  ASSERT_NEAR(2.0, q.y(), tolerance);
+  ASSERT_NEAR(0.0, q.z(), tolerance);
+}
+
+TEST(Map2D, ramp)
+{
+  double tolerance = 0.0001;
+  // ramp rising with 45 deg along x starting at (2, 0, 0)
+  tf2::Map2D map;
+  map.create(tf2::Vector3(2.0, 0.0, 0.0), tf2::Vector3(-1.0, 0.0, 1.0));
+  std::vector<tf2::Point3D> points = {
+    tf2::Point3D(3.0, 0.0, 1.0), tf2::Point3D(2.0, 5.0, 0.0), tf2::Point3D(3.0, -1.0, 2.0)};
+  std::vector<tf2::Point2D> map_points(points.size());
+  std::vector<tf2Scalar> heights(points.size());
+  map.to_map(points.data(), points.size(), map_points.data(), heights.data());
+  ASSERT_NEAR(std::sqrt(2.0), map_points[0].x(), tolerance);
+  ASSERT_NEAR(0.0, map_points[0].y(), tolerance);
+  ASSERT_NEAR(0.0, heights[0], tolerance);
+  ASSERT_NEAR(0.0, map_points[1].x(), tolerance);
+  ASSERT_NEAR(5.0, map_points[1].y(), tolerance);
+  ASSERT_NEAR(std::sqrt(0.5), heights[2], tolerance);
+
+  std::vector<tf2::Point3D> lifted(points.size());
+  map.to_world(map_points.data(), map_points.size(), lifted.data(), heights.data());
+  for (size_t i = 0; i < points.size(); i++) {
+    ASSERT_NEAR(points[i].x(), lifted[i].x(), tolerance);
+    ASSERT_NEAR(points[i].y(), lifted[i].y(), tolerance);
+    ASSERT_NEAR(points[i].z(), lifted[i].z(), tolerance);
+  }
+}
+
+TEST(Map2D, degenerate_x_axis)
+{
+  double tolerance = 0.0001;
+  // an x axis parallel to the normal falls back to the default frame
+  tf2::Vector3 p(2.0, 0.0, 0.0), n(-1.0, 0.0, 1.0);
+  tf2::Map2D reference, parallel, non_finite;
+  reference.create(p, n);
+  parallel.create(p, n, n * 3.0);
+  non_finite.create(p, n, tf2::Vector3(std::nan(""), 0.0, 0.0));
+  std::vector<tf2::Point3D> points = {tf2::Point3D(3.0, 0.0, 1.0), tf2::Point3D(3.0, -1.0, 2.0)};
+  for (const tf2::Map2D *map : {&parallel, &non_finite}) {
+    std::vector<tf2::Point2D> expected(points.size()), actual(points.size());
+    std::vector<tf2Scalar> heights(points.size());
+    reference.to_map(points.data(), points.size(), expected.data(), heights.data());
+    map->to_map(points.data(), points.size(), actual.data(), heights.data());
+    for (size_t i = 0; i < points.size(); i++) {
+      ASSERT_TRUE(std::isfinite(actual[i].x()) && std::isfinite(actual[i].y()));
+      ASSERT_NEAR(expected[i].x(), actual[i].x(), tolerance);
+      ASSERT_NEAR(expected[i].y(), actual[i].y(), tolerance);
+    }
+  }
+}
@@ -0,0 +1,106 @@
+#include <new>
+#include "gtest/gtest.h"
+#include "tf2_geometry/hough2d.hpp"
+#include "tf2_geometry/kd_tree2d.hpp"
+#include "tf2_geometry/memory.hpp"
+#include "tf2_geometry/plane3d.hpp"
+
+TEST(MonotonicArena, allocate_reset)
+{
+  tf2::MonotonicArena arena(1024);
+  {
+    std::pmr::vector<uint32_t> v(&arena);
+    v.reserve(64);
+    ASSERT_EQ(256u, arena.used());
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(v.data()) % alignof(uint32_t));
+    ASSERT_THROW(v.reserve(1024), std::bad_alloc);
+  }
+  arena.reset();
+  ASSERT_EQ(0u, arena.used());
+  ASSERT_EQ(256u, arena.peak());
+
+  tf2::MonotonicArena growing(64, std::pmr::new_delete_resource());
+  std::pmr::vector<double> v(&growing);
+  v.resize(100);
+  ASSERT_EQ(800u, growing.overflow());
+}
+
+namespace {
+// forwards to new and delete and counts the blocks
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+  int blocks = 0;
+
+private:
+  void * do_allocate(size_t bytes, size_t alignment) override
+  {
+    blocks++;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void * p, size_t bytes, size_t alignment) override
+  {
+    blocks--;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+}  // namespace
+
+TEST(MonotonicArena, zero_bytes)
+{
+  CountingResource upstream;
+  tf2::MonotonicArena arena(64, &upstream);
+  // zero bytes within the buffer stay in the arena
+  void * empty = arena.allocate(0, 1);
+  arena.deallocate(empty, 0, 1);
+  ASSERT_EQ(0, upstream.blocks);
+
+  // a full arena hands zero byte requests to upstream and returns them there
+  void * full = arena.allocate(arena.capacity() - arena.used(), 1);
+  ASSERT_EQ(64u, arena.used());
+  void * p = arena.allocate(0, 1);
+  ASSERT_EQ(1, upstream.blocks);
+  arena.deallocate(p, 0, 1);
+  arena.deallocate(full, 63, 1);
+  ASSERT_EQ(0, upstream.blocks);
+}
+
+TEST(MonotonicArena, geometry)
+{
+  tf2::MonotonicArena arena(64 * 1024);
+  std::vector<tf2::Point3D> points;
+  for (int i = 0; i < 100; i++) {
+    points.push_back(tf2::Point3D(i * 0.1, i * 0.2, (i % 3) ? 0.0 : 1.0));
+  }
+  tf2::Plane3D ground(0., 0., 1., 0.);
+  std::pmr::vector<uint32_t> inliers(&arena), outliers(&arena);
+  ASSERT_EQ(66u, ground.inliers(points.data(), points.size(), 0.01, inliers, &outliers));
+  ASSERT_EQ(34u, outliers.size());
+  ASSERT_EQ(1u, inliers[0]);
+  ASSERT_EQ(0u, outliers[0]);
+
+  std::pmr::vector<tf2::Point2D> scan(&arena);
+  for (int i = 0; i < 100; i++) {
+    scan.push_back(tf2::Point2D(2.0, -2.0 + i * 0.04));
+  }
+  tf2::HoughLines2D::Config config;
+  config.threshold = 50;
+  std::pmr::unsynchronized_pool_resource pool;
+  tf2::HoughLines2D hough(config, &pool);
+  std::pmr::vector<tf2::Line2D> lines(&arena);
+  ASSERT_EQ(1u, hough.detect(scan, lines));
+  ASSERT_NEAR(0.0, lines[0].distance_to(tf2::Point2D(2.0, 1.0)), 0.05);
+  tf2::Line2D buffer[4];
+  ASSERT_EQ(1u, hough.detect(scan.data(), scan.size(), buffer, 4));
+  ASSERT_EQ(lines[0], buffer[0]);
+
+  tf2::KdTree2D tree;
+  tree.build(scan.data(), scan.size());
+  std::pmr::vector<size_t> found(&arena);
+  ASSERT_EQ(3u, tree.radius(tf2::Point2D(2.0, 0.0), 0.0017, found));
+  ASSERT_EQ(50u, found[1]);
+}
@@ -0,0 +1,65 @@
+#include "gtest/gtest.h"
+#include "tf2_geometry/moments3d.hpp"
+
+
+TEST(Moments3D, add_remove_merge)
+{
+  double tolerance = 0.000001;
+  std::vector<tf2::Point3D> points;
+  for (int i = 0; i < 50; i++) {
+    points.push_back(tf2::Point3D(i * 0.3, std::sin(i), 2.0 - i * 0.1 + std::cos(i) * 0.01));
+  }
+  tf2::Moments3D all, first, second;
+  all.add(points.data(), points.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    (i < 20 ? first : second).add(points[i]);
+  }
+  first.merge(second);
+  ASSERT_EQ(all.count(), first.count());
+  tf2Scalar c0[3][3], c1[3][3];
+  all.covariance(c0);
+  first.covariance(c1);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_NEAR(all.mean()[i], first.mean()[i], tolerance);
+    for (int j = 0; j < 3; j++) {
+      ASSERT_NEAR(c0[i][j], c1[i][j], tolerance);
+    }
+  }
+
+  tf2::Moments3D head;
+  head.add(points.data(), 20);
+  for (size_t i = 20; i < points.size(); i++) {
+    all.remove(points[i]);
+  }
+  ASSERT_EQ(20u, all.count());
+  all.covariance(c0);
+  head.covariance(c1);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_NEAR(head.mean()[i], all.mean()[i], tolerance);
+    for (int j = 0; j < 3; j++) {
+      ASSERT_NEAR(c1[i][j], c0[i][j], tolerance);
+    }
+  }
+}
+
+TEST(Moments3D, fit)
+{
+  double tolerance = 0.0001;
+  tf2::Point3D p0(5.0, -1.0, 7.0), p1(-2.0, 0.0, 6.0), p2(2.0, 4.0, 8.0);
+  tf2::Plane3D reference(p0, p1, p2, true);
+  tf2::Moments3D moments;
+  moments.add(p0).add(p1).add(p2).add(tf2::Point3D(1.75, 1.75, 7.25));  // (p0 + p1 + 2 * p2) / 4
+  tf2::Plane3D plane(0., 0., 0., 0.);
+  ASSERT_TRUE(moments.fit(plane));
+  double s = plane.dot(reference) < 0 ? -1.0 : 1.0;
+  ASSERT_NEAR(reference.a(), s * plane.a(), tolerance);
+  ASSERT_NEAR(reference.b(), s * plane.b(), tolerance);
+  ASSERT_NEAR(reference.c(), s * plane.c(), tolerance);
+  ASSERT_NEAR(reference.d(), s * plane.d(), tolerance);
+  ASSERT_NEAR(0.0, moments.curvature(), tolerance);
+
+  tf2Scalar lambda[3];
+  moments.eigenvalues(lambda);
+  ASSERT_LE(lambda[0], lambda[1]);
+  ASSERT_LE(lambda[1], lambda[2]);
+}
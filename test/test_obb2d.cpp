@@ -0,0 +1,126 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/obb2d.hpp"
+
+namespace
+{
+double cross(const tf2::Point2D & a, const tf2::Point2D & b, const tf2::Point2D & c)
+{
+  return (b.x() - a.x()) * (c.y() - a.y()) - (b.y() - a.y()) * (c.x() - a.x());
+}
+
+// proper or touching intersection of two segments in general position
+bool segments_intersect(const tf2::Point2D & a0, const tf2::Point2D & a1, const tf2::Point2D & b0, const tf2::Point2D & b1)
+{
+  return cross(a0, a1, b0) * cross(a0, a1, b1) <= 0.0 && cross(b0, b1, a0) * cross(b0, b1, a1) <= 0.0;
+}
+
+// reference: convex polygons intersect if an edge crosses or one contains a corner of the other
+bool brute_force(const tf2::OBB2D & a, const tf2::OBB2D & b)
+{
+  for (size_t i = 0; i < 4; i++) {
+    if (a.contains(b.corner(i)) || b.contains(a.corner(i))) {
+      return true;
+    }
+    for (size_t j = 0; j < 4; j++) {
+      if (segments_intersect(a.corner(i), a.corner((i + 1) % 4), b.corner(j), b.corner((j + 1) % 4))) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool brute_force(const tf2::OBB2D & a, const tf2::LineSegment2D & s)
+{
+  if (a.contains(s.p0())) {
+    return true;
+  }
+  for (size_t i = 0; i < 4; i++) {
+    if (segments_intersect(a.corner(i), a.corner((i + 1) % 4), s.p0(), s.p1())) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+TEST(OBB2D, geometry)
+{
+  const tf2::OBB2D box(tf2::Transform2D(1.0, 2.0, M_PI / 2), 4.0, 2.0);
+  EXPECT_EQ(box.length(), 4.0);
+  EXPECT_EQ(box.width(), 2.0);
+  EXPECT_NEAR(box.pose().rotation(), M_PI / 2, 1e-12);
+  EXPECT_NEAR(box.corner(0).x(), 2.0, 1e-12);
+  EXPECT_NEAR(box.corner(0).y(), 0.0, 1e-12);
+  EXPECT_NEAR(box.corner(2).x(), 0.0, 1e-12);
+  EXPECT_NEAR(box.corner(2).y(), 4.0, 1e-12);
+  const tf2::AABB2D aabb = box.aabb();
+  EXPECT_NEAR(aabb.x_min(), 0.0, 1e-12);
+  EXPECT_NEAR(aabb.y_max(), 4.0, 1e-12);
+  EXPECT_TRUE(box.contains(tf2::Point2D(1.5, 3.5)));
+  EXPECT_FALSE(box.contains(tf2::Point2D(2.5, 2.0)));
+
+  const tf2::OBB2D axis_aligned(tf2::AABB2D(0.0, 0.0, 2.0, 1.0));
+  EXPECT_EQ(axis_aligned.center().x(), 1.0);
+  EXPECT_EQ(axis_aligned.length(), 2.0);
+  EXPECT_EQ(axis_aligned.width(), 1.0);
+  EXPECT_FALSE(axis_aligned.empty());
+
+  // an empty AABB2D gives an empty box without NaN
+  const tf2::OBB2D empty{tf2::AABB2D()};
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(empty.center().x(), 0.0);
+  EXPECT_EQ(empty.center().y(), 0.0);
+  EXPECT_EQ(empty.length(), 0.0);
+  EXPECT_EQ(empty.width(), 0.0);
+  EXPECT_TRUE(empty.aabb().empty());
+  EXPECT_FALSE(empty.contains(tf2::Point2D(0.0, 0.0)));
+  EXPECT_FALSE(empty.intersects(box));
+  EXPECT_FALSE(box.intersects(empty));
+  EXPECT_FALSE(empty.intersects(empty));
+  EXPECT_FALSE(empty.intersects(tf2::LineSegment2D(-1.0, 0.0, 1.0, 0.0)));
+  EXPECT_FALSE(empty.intersects(tf2::LineSegment2D(0.0, 0.0, 0.0, 0.0)));
+}
+
+TEST(OBB2D, intersects)
+{
+  const tf2::OBB2D box(tf2::Transform2D(0.0, 0.0, M_PI / 4), 2.0, 2.0);
+  // separated along the diagonal axis only
+  EXPECT_FALSE(box.intersects(tf2::OBB2D(tf2::Transform2D(1.6, 1.6, 0.0), 1.0, 1.0)));
+  EXPECT_TRUE(box.intersects(tf2::OBB2D(tf2::Transform2D(1.0, 1.0, 0.0), 1.0, 1.0)));
+  // the segment passes the corner at x = sqrt(2)
+  EXPECT_FALSE(box.intersects(tf2::LineSegment2D(1.5, -1.0, 1.5, 1.0)));
+  EXPECT_TRUE(box.intersects(tf2::LineSegment2D(1.3, -1.0, 1.3, 1.0)));
+  // segment inside
+  EXPECT_TRUE(box.intersects(tf2::LineSegment2D(0.1, 0.0, -0.1, 0.0)));
+
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> position(-3.0, 3.0), angle(-M_PI, M_PI), extent(0.1, 2.0);
+  std::vector<tf2::OBB2D> boxes;
+  std::vector<tf2::LineSegment2D> segments;
+  for (size_t i = 0; i < 2000; i++) {
+    boxes.push_back(tf2::OBB2D(tf2::Transform2D(position(generator), position(generator), angle(generator)), extent(generator), extent(generator)));
+    segments.push_back(tf2::LineSegment2D(position(generator), position(generator), position(generator), position(generator)));
+  }
+  std::vector<uint8_t> mask(boxes.size());
+  size_t expected_boxes = 0, expected_segments = 0;
+  for (size_t i = 0; i < boxes.size(); i++) {
+    EXPECT_EQ(box.intersects(boxes[i]), brute_force(box, boxes[i]));
+    EXPECT_EQ(box.intersects(segments[i]), brute_force(box, segments[i]));
+    expected_boxes += brute_force(box, boxes[i]), expected_segments += brute_force(box, segments[i]);
+  }
+  EXPECT_EQ(box.intersects(boxes.data(), boxes.size(), mask.data()), expected_boxes);
+  const tf2::ExecutionPolicy policy = tf2::ExecutionPolicy::parallel_unsequenced(64);
+  EXPECT_EQ(box.intersects(policy, boxes.data(), boxes.size(), mask.data()), expected_boxes);
+  for (size_t i = 0; i < boxes.size(); i++) {
+    EXPECT_EQ(mask[i] != 0, box.intersects(boxes[i]));
+  }
+  EXPECT_EQ(box.intersects(segments.data(), segments.size(), mask.data()), expected_segments);
+  EXPECT_EQ(box.intersects(policy, segments.data(), segments.size(), mask.data()), expected_segments);
+  EXPECT_GT(expected_boxes, 100u);
+  EXPECT_LT(expected_boxes, 1900u);
+}
@@ -0,0 +1,93 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/particle_set2d.hpp"
+
+TEST(ParticleSet2D, move)
+{
+  // 7 particles to cover the packs and the remainder
+  tf2::ParticleSet2D particles(7);
+  std::vector<tf2::Transform2D> expected;
+  for (size_t i = 0; i < particles.size(); i++) {
+    expected.push_back(tf2::Transform2D(0.3 * i, -0.2 * i, 0.5 * i - 1.5));
+    particles.set(i, expected.back());
+  }
+  const tf2::Transform2D delta(0.1, 0.02, 0.05);
+  for (int k = 0; k < 100; k++) {
+    particles.move(delta);
+    for (size_t i = 0; i < particles.size(); i++) {
+      expected[i].set(expected[i] * delta);
+    }
+  }
+  for (size_t i = 0; i < particles.size(); i++) {
+    EXPECT_NEAR(particles.x()[i], expected[i].x(), 1e-9);
+    EXPECT_NEAR(particles.y()[i], expected[i].y(), 1e-9);
+    EXPECT_NEAR(particles.theta()[i], expected[i].rotation(), 1e-9);
+    EXPECT_NEAR(particles.cos()[i], std::cos(expected[i].rotation()), 1e-12);
+    EXPECT_NEAR(particles.sin()[i], std::sin(expected[i].rotation()), 1e-12);
+  }
+
+  // explicit noise is added to the delta of every particle
+  std::vector<double> nx(7), ny(7), ntheta(7);
+  for (size_t i = 0; i < 7; i++) {
+    nx[i] = 0.01 * i, ny[i] = -0.02 * i, ntheta[i] = 0.03 * i;
+  }
+  particles.move(delta, nx.data(), ny.data(), ntheta.data());
+  for (size_t i = 0; i < particles.size(); i++) {
+    expected[i].set(expected[i] * tf2::Transform2D(delta.x() + nx[i], delta.y() + ny[i], delta.rotation() + ntheta[i]));
+    EXPECT_NEAR(particles.pose(i).x(), expected[i].x(), 1e-9);
+    EXPECT_NEAR(particles.pose(i).y(), expected[i].y(), 1e-9);
+    EXPECT_NEAR(particles.pose(i).rotation(), expected[i].rotation(), 1e-9);
+  }
+
+  // sampled noise spreads the particles
+  tf2::ParticleSet2D cloud(1000);
+  std::mt19937 generator(42);
+  tf2::ParticleSet2D::Noise noise;
+  noise.x = 0.1, noise.theta = 0.05;
+  cloud.move(tf2::Transform2D(1.0, 0.0, 0.0), noise, generator);
+  double sum = 0.0, sum2 = 0.0;
+  for (size_t i = 0; i < cloud.size(); i++) {
+    sum += cloud.x()[i], sum2 += cloud.x()[i] * cloud.x()[i];
+    EXPECT_EQ(cloud.y()[i], 0.0);
+  }
+  EXPECT_NEAR(sum / 1000.0, 1.0, 0.02);
+  EXPECT_NEAR(std::sqrt(sum2 / 1000.0 - (sum / 1000.0) * (sum / 1000.0)), 0.1, 0.02);
+}
+
+TEST(ParticleSet2D, weigh_and_resample)
+{
+  tf2::ParticleSet2D particles(100);
+  for (size_t i = 0; i < particles.size(); i++) {
+    particles.set(i, tf2::Transform2D(0.01 * i, 0.0, 0.0));
+  }
+  EXPECT_NEAR(particles.effective_size(), 100.0, 1e-9);
+
+  // likelihood of particles close to x = 0.5
+  tf2::ExecutionPolicy policy = tf2::ExecutionPolicy::parallel_unsequenced(16);
+  particles.weigh(policy, [](const tf2::ParticleSet2D & set, size_t begin, size_t end, double * likelihoods) {
+    for (size_t i = begin; i < end; i++) {
+      const double d = set.x()[i] - 0.5;
+      likelihoods[i - begin] = std::exp(-d * d / (2.0 * 0.05 * 0.05));
+    }
+  });
+  EXPECT_GT(particles.normalize(), 0.0);
+  EXPECT_LT(particles.effective_size(), 30.0);
+  EXPECT_NEAR(particles.mean().x(), 0.5, 1e-3);
+
+  particles.resample(0.5);
+  EXPECT_NEAR(particles.effective_size(), 100.0, 1e-9);
+  for (size_t i = 0; i < particles.size(); i++) {
+    EXPECT_NEAR(particles.x()[i], 0.5, 0.2);
+  }
+  EXPECT_NEAR(particles.mean().x(), 0.5, 0.01);
+
+  // zero likelihoods fall back to equal weights
+  particles.weigh([](const tf2::ParticleSet2D &, size_t begin, size_t end, double * likelihoods) {
+    std::fill(likelihoods, likelihoods + end - begin, 0.0);
+  });
+  EXPECT_EQ(particles.normalize(), 0.0);
+  EXPECT_DOUBLE_EQ(particles.weights()[0], 0.01);
+}
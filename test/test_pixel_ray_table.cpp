@@ -0,0 +1,105 @@
+#include <cmath>
+#include <limits>
+#include "gtest/gtest.h"
+#include "tf2_geometry/pixel_ray_table.hpp"
+
+
+TEST(PixelRayTable, project)
+{
+  double tolerance = 0.0001;
+  tf2::PixelRayTable::Intrinsics intrinsics;
+  intrinsics.fx = 100, intrinsics.fy = 100, intrinsics.cx = 50, intrinsics.cy = 50;
+  intrinsics.width = 101, intrinsics.height = 81;
+  tf2::PixelRayTable rays(intrinsics);
+
+  // camera 1m above the ground looking down
+  tf2::Transform pose(tf2::Matrix3x3(1, 0, 0, 0, -1, 0, 0, 0, -1), tf2::Vector3(0, 0, 1));
+  rays.set_pose(pose);
+  tf2::Plane3D ground(0., 0., 1., 0.);
+  std::vector<tf2::Point2D> points(rays.size());
+  std::vector<uint8_t> valid(rays.size());
+  ASSERT_EQ(rays.size(), rays.project(ground, points.data(), valid.data()));
+  ASSERT_NEAR(0.0, points[50 * 101 + 50].x(), tolerance);
+  ASSERT_NEAR(0.0, points[50 * 101 + 50].y(), tolerance);
+  ASSERT_NEAR(0.1, points[50 * 101 + 60].x(), tolerance);
+  ASSERT_NEAR(-0.1, points[60 * 101 + 50].y(), tolerance);
+
+  // same result as a line plane intersection
+  tf2::Vector3 intersection;
+  ASSERT_TRUE(ground.intersection(pose.getOrigin(), pose.getOrigin() + rays.ray(7, 3), intersection));
+  ASSERT_NEAR(intersection.x(), points[3 * 101 + 7].x(), tolerance);
+  ASSERT_NEAR(intersection.y(), points[3 * 101 + 7].y(), tolerance);
+
+  // camera looking forward, only the lower image half hits the ground
+  tf2::Transform forward(tf2::Matrix3x3(0, 0, 1, -1, 0, 0, 0, -1, 0), tf2::Vector3(0, 0, 1));
+  rays.set_pose(forward);
+  std::vector<uint32_t> pixels = {10 * 101 + 50, 50 * 101 + 50, 60 * 101 + 50};
+  ASSERT_EQ(1u, rays.project(ground, pixels.data(), pixels.size(), points.data(), valid.data()));
+  ASSERT_EQ(0, valid[0]);
+  ASSERT_EQ(0, valid[1]);
+  ASSERT_EQ(1, valid[2]);
+  ASSERT_NEAR(10.0, points[2].x(), tolerance);
+  ASSERT_NEAR(0.0, points[2].y(), tolerance);
+}
+
+TEST(PixelRayTable, tilted_plane)
+{
+  double tolerance = 0.0001;
+  tf2::PixelRayTable::Intrinsics intrinsics;
+  intrinsics.fx = 100, intrinsics.fy = 100, intrinsics.cx = 50, intrinsics.cy = 50;
+  intrinsics.width = 101, intrinsics.height = 81;
+  tf2::PixelRayTable rays(intrinsics);
+
+  // ground frame with a downwards normal matches the parent x, y
+  tf2::Transform frame = tf2::PixelRayTable::plane_frame(tf2::Plane3D(0., 0., -2., 1.));
+  ASSERT_NEAR(0.5, frame.getOrigin().z(), tolerance);
+  ASSERT_NEAR(1.0, frame.getBasis()[0][0], tolerance);
+  ASSERT_NEAR(1.0, frame.getBasis()[1][1], tolerance);
+
+  // camera looking forward at a ramp rising along x, not normalized
+  tf2::Transform forward(tf2::Matrix3x3(0, 0, 1, -1, 0, 0, 0, -1, 0), tf2::Vector3(0, 0, 1));
+  rays.set_pose(forward);
+  tf2::Plane3D ramp(-0.6, 0.2, 2.0, -0.4);
+  frame = tf2::PixelRayTable::plane_frame(ramp);
+  std::vector<tf2::Point2D> points(rays.size());
+  std::vector<uint8_t> valid(rays.size());
+  size_t count = rays.project(ramp, points.data(), valid.data());
+  ASSERT_GT(count, 0u);
+  ASSERT_LT(count, rays.size());
+  for (size_t v = 0; v < intrinsics.height; v += 5) {
+    for (size_t u = 0; u < intrinsics.width; u += 5) {
+      size_t i = v * intrinsics.width + u;
+      tf2::Vector3 ray = rays.ray(u, v), intersection;
+      bool hit = ramp.intersection(forward.getOrigin(), forward.getOrigin() + ray, intersection) &&
+        (intersection - forward.getOrigin()).dot(ray) > 0;
+      ASSERT_EQ(hit, valid[i] == 1);
+      if (hit) {
+        // the plane frame maps the 2D coordinates back onto the intersection
+        tf2::Vector3 p = frame * tf2::Vector3(points[i].x(), points[i].y(), 0.);
+        ASSERT_NEAR(intersection.x(), p.x(), tolerance);
+        ASSERT_NEAR(intersection.y(), p.y(), tolerance);
+        ASSERT_NEAR(intersection.z(), p.z(), tolerance);
+      }
+    }
+  }
+}
+
+TEST(PixelRayTable, invalid_intrinsics)
+{
+  // zero and non-finite focal lengths and principal points use the defaults
+  tf2::PixelRayTable::Intrinsics intrinsics;
+  intrinsics.width = 4, intrinsics.height = 3;
+  for (double value : {0.0, std::nan(""), std::numeric_limits<double>::infinity()}) {
+    intrinsics.fx = value, intrinsics.fy = value, intrinsics.cx = std::nan(""), intrinsics.cy = value;
+    tf2::PixelRayTable rays(intrinsics);
+    ASSERT_EQ(tf2::PixelRayTable::Intrinsics().fx, rays.intrinsics().fx);
+    ASSERT_EQ(tf2::PixelRayTable::Intrinsics().fy, rays.intrinsics().fy);
+    ASSERT_EQ(tf2::PixelRayTable::Intrinsics().cx, rays.intrinsics().cx);
+    for (size_t v = 0; v < intrinsics.height; v++) {
+      for (size_t u = 0; u < intrinsics.width; u++) {
+        tf2::Vector3 ray = rays.ray(u, v);
+        ASSERT_TRUE(std::isfinite(ray.x()) && std::isfinite(ray.y()) && std::isfinite(ray.z()));
+      }
+    }
+  }
+}
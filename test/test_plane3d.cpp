@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "tf2_geometry/plane3d.hpp"
+#include "tf2_geometry/plane3d_array.hpp"
 
 TEST(Plane3D, constructor)
 {
@@ -20,3 +21,81 @@ TEST(Plane3D, constructor)
   tf2::Plane3D plane1(p0, p1, p2, true);
   plane0.nomalize();
 }
+
+TEST(Plane3D, batch)
+{
+  double tolerance = 0.001;
+  tf2::Plane3D ground(0.0, 0.0, 1.0, 0.0);
+  std::vector<tf2::Point3D> points;
+  for (int i = 0; i < 1001; i++) {
+    points.push_back(tf2::Point3D(i * 0.1, -i * 0.2, (i % 3) * 0.05));
+  }
+  std::vector<tf2Scalar> distances(points.size());
+  ground.distances_to(points.data(), points.size(), distances.data());
+  for (size_t i = 0; i < points.size(); i++) {
+    ASSERT_NEAR(ground.distance_to(points[i]), distances[i], tolerance);
+  }
+
+  std::vector<uint8_t> mask(points.size());
+  ASSERT_EQ(668u, ground.classify(points.data(), points.size(), 0.06, mask.data()));
+  ASSERT_EQ(1, mask[1]);
+  ASSERT_EQ(0, mask[2]);
+
+  std::vector<uint32_t> inliers, outliers;
+  ASSERT_EQ(334u, ground.inliers(points.data(), points.size(), 0.01, inliers, &outliers));
+  ASSERT_EQ(667u, outliers.size());
+  ASSERT_EQ(3u, inliers[1]);
+
+  tf2::Plane3D planes[2] = {ground, tf2::Plane3D(0.0, 0.0, 1.0, -0.1)};
+  ASSERT_TRUE(tf2::Plane3D::classify(planes, 2, points.data(), points.size(), 0.01, mask.data()));
+  ASSERT_EQ(1, mask[0]);
+  ASSERT_EQ(0, mask[1]);
+  ASSERT_EQ(2, mask[2]);
+
+  // eight planes fill the mask bits, more are rejected and leave the mask untouched
+  std::vector<tf2::Plane3D> levels;
+  for (int j = 0; j < 9; j++) {
+    levels.push_back(tf2::Plane3D(0.0, 0.0, 1.0, -0.1 * (j % 2)));
+  }
+  ASSERT_TRUE(tf2::Plane3D::classify(levels.data(), 8, points.data(), points.size(), 0.01, mask.data()));
+  ASSERT_EQ(0x55, mask[0]);
+  ASSERT_EQ(0xaa, mask[2]);
+  ASSERT_FALSE(tf2::Plane3D::classify(levels.data(), 9, points.data(), points.size(), 0.01, mask.data()));
+  ASSERT_EQ(0x55, mask[0]);
+}
+
+TEST(Plane3D, array)
+{
+  double tolerance = 0.001;
+  // unit box with inwards pointing normals
+  std::vector<tf2::Plane3D> faces = {
+    tf2::Plane3D(1., 0., 0., 0.), tf2::Plane3D(-1., 0., 0., 1.),
+    tf2::Plane3D(0., 1., 0., 0.), tf2::Plane3D(0., -1., 0., 1.),
+    tf2::Plane3D(0., 0., 1., 0.), tf2::Plane3D(0., 0., -1., 1.)};
+  tf2::Plane3DArray box(faces.data(), faces.size());
+  ASSERT_EQ(6u, box.size());
+  ASSERT_EQ(2u, box.lanes().size());
+  ASSERT_TRUE(box.plane(3) == faces[3]);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(box.lanes().data()) % tf2::simd::kAlignment);
+
+  tf2Scalar distances[6];
+  box.distances_to(tf2::Point3D(0.25, 0.5, 2.0), distances);
+  ASSERT_NEAR(0.25, distances[0], tolerance);
+  ASSERT_NEAR(-1.0, distances[5], tolerance);
+
+  std::vector<tf2::Point3D> points = {
+    tf2::Point3D(0.5, 0.5, 0.5), tf2::Point3D(0.5, 0.5, 1.5), tf2::Point3D(-0.0001, 0.2, 0.2)};
+  std::vector<uint8_t> mask(points.size());
+  ASSERT_EQ(1u, box.contains(points.data(), points.size(), mask.data()));
+  ASSERT_EQ(1, mask[0]);
+  ASSERT_EQ(0, mask[1]);
+  ASSERT_TRUE(box.contains(points[2], 0.001));
+}
+
+TEST(Plane3D, distance_to)
+{
+  double tolerance = 0.001;
+  tf2::Plane3D plane(tf2::Point3D(0, 0, 1), tf2::Point3D(1, 0, 1), tf2::Point3D(0, 1, 1));
+  ASSERT_NEAR(1.0, plane.distance_to(tf2::Point3D(3.0, -2.0, 2.0)), tolerance);
+  ASSERT_EQ(0u, alignof(tf2::Plane3D) % 32);
+}
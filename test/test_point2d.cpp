@@ -17,3 +17,11 @@ TEST(Point2D, distance_to)
   tf2Scalar d = p0.distance_to(p1);
   ASSERT_TRUE((d == 2.0));
 }
+
+TEST(Point2D, distance_to_sqrt)
+{
+  tf2::Point2D p0(3.0,1.4);
+  tf2::Point2D p1(1.0,2.4);
+  ASSERT_DOUBLE_EQ(p0.distance_to_sqrt(p1), 5.0);
+  ASSERT_DOUBLE_EQ(p0.distance_to_sqrt(1.0, 2.4), p0.distance_to(p1) * p0.distance_to(p1));
+}
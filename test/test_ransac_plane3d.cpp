@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+#include <random>
+#include "tf2_geometry/ransac_plane3d.hpp"
+
+
+std::vector<tf2::Point3D> create_floor_with_clutter()
+{
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dis(-5.0, 5.0);
+  std::normal_distribution<double> noise(0.0, 0.005);
+  std::vector<tf2::Point3D> points;
+  // floor z = 0.1 * x + 0.5 with 70% of the points
+  for (int i = 0; i < 1400; i++) {
+    double x = dis(gen), y = dis(gen);
+    points.push_back(tf2::Point3D(x, y, 0.1 * x + 0.5 + noise(gen)));
+  }
+  for (int i = 0; i < 600; i++) {
+    points.push_back(tf2::Point3D(dis(gen), dis(gen), dis(gen)));
+  }
+  return points;
+}
+
+TEST(RansacPlane3D, estimate)
+{
+  double tolerance = 0.01;
+  std::vector<tf2::Point3D> points = create_floor_with_clutter();
+  tf2::RansacPlane3D ransac;
+  tf2::Plane3D plane(0., 0., 0., 0.);
+  ASSERT_TRUE(ransac.estimate(points, plane));
+  double s = plane.c() < 0 ? -1.0 : 1.0;
+  double l = std::sqrt(1.0 + 0.1 * 0.1);
+  ASSERT_NEAR(-0.1 / l, s * plane.a(), tolerance);
+  ASSERT_NEAR(0.0, s * plane.b(), tolerance);
+  ASSERT_NEAR(1.0 / l, s * plane.c(), tolerance);
+  ASSERT_NEAR(-0.5 / l, s * plane.d(), tolerance);
+  ASSERT_GE(ransac.inliers().size(), 1390u);
+  ASSERT_LT(ransac.iterations(), 100u);
+}
+
+TEST(RansacPlane3D, deterministic)
+{
+  std::vector<tf2::Point3D> points = create_floor_with_clutter();
+  tf2::RansacPlane3D::Config config;
+  config.seed = 7;
+  config.refine = false;
+  tf2::RansacPlane3D single(config);
+  config.num_threads = 4;
+  tf2::RansacPlane3D parallel(config);
+  tf2::Plane3D plane0(0., 0., 0., 0.), plane1(0., 0., 0., 0.);
+  ASSERT_TRUE(single.estimate(points, plane0));
+  ASSERT_TRUE(parallel.estimate(points, plane1));
+  ASSERT_TRUE(plane0 == plane1);
+  ASSERT_EQ(single.inliers(), parallel.inliers());
+  ASSERT_EQ(single.iterations(), parallel.iterations());
+}
+
+TEST(RansacPlane3D, fit)
+{
+  double tolerance = 0.0001;
+  std::vector<tf2::Point3D> points = {
+    tf2::Point3D(0, 0, 1), tf2::Point3D(1, 0, 1), tf2::Point3D(0, 1, 1), tf2::Point3D(1, 1, 1)};
+  std::vector<uint32_t> indices = {0, 1, 2, 3};
+  tf2::Plane3D plane(0., 0., 0., 0.);
+  ASSERT_TRUE(tf2::RansacPlane3D::fit(points.data(), indices.data(), indices.size(), plane));
+  ASSERT_NEAR(1.0, std::fabs(plane.c()), tolerance);
+  ASSERT_NEAR(0.0, plane.distance_to(points[3]), tolerance);
+  // collinear points do not define a plane
+  points[2] = tf2::Point3D(2, 0, 1), points[3] = tf2::Point3D(3, 0, 1);
+  ASSERT_FALSE(tf2::RansacPlane3D::fit(points.data(), indices.data(), indices.size(), plane));
+}
@@ -0,0 +1,125 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tf2_geometry/scan_matcher2d.hpp"
+
+namespace {
+std::vector<tf2::LineSegment2D> make_map()
+{
+  // a 6 x 4 room with a pillar, so every direction is constrained
+  return {
+    tf2::LineSegment2D(0.0, 0.0, 6.0, 0.0), tf2::LineSegment2D(6.0, 0.0, 6.0, 4.0),
+    tf2::LineSegment2D(6.0, 4.0, 0.0, 4.0), tf2::LineSegment2D(0.0, 4.0, 0.0, 0.0),
+    tf2::LineSegment2D(4.0, 1.0, 4.5, 1.0), tf2::LineSegment2D(4.5, 1.0, 4.5, 1.5),
+    tf2::LineSegment2D(4.5, 1.5, 4.0, 1.5), tf2::LineSegment2D(4.0, 1.5, 4.0, 1.0)};
+}
+
+// casts rays from a pose and returns the hits in the frame of the pose
+std::vector<tf2::Point2D> make_scan(const std::vector<tf2::LineSegment2D> & map, double x, double y, double theta)
+{
+  std::vector<tf2::Point2D> scan;
+  for (int i = 0; i < 360; i++) {
+    const double a = theta + i * M_PI / 180.0, dx = std::cos(a), dy = std::sin(a);
+    double t_min = std::numeric_limits<double>::max();
+    for (const tf2::LineSegment2D & s : map) {
+      const double ex = s.x1() - s.x0(), ey = s.y1() - s.y0();
+      const double det = dx * ey - dy * ex;
+      if (std::fabs(det) < 1e-12) {
+        continue;
+      }
+      const double wx = s.x0() - x, wy = s.y0() - y;
+      const double t = (wx * ey - wy * ex) / det, u = (wx * dy - wy * dx) / det;
+      if (t > 0.0 && u >= 0.0 && u <= 1.0) {
+        t_min = std::min(t_min, t);
+      }
+    }
+    const double r = t_min, b = i * M_PI / 180.0;
+    scan.push_back(tf2::Point2D(r * std::cos(b), r * std::sin(b)));
+  }
+  return scan;
+}
+}  // namespace
+
+TEST(ScanMatcher2D, match_map)
+{
+  std::vector<tf2::LineSegment2D> map = make_map();
+  tf2::SegmentIndex2D index;
+  index.build(map.data(), map.size(), 0.5);
+  std::vector<tf2::Point2D> scan = make_scan(map, 2.0, 1.5, 0.3);
+
+  tf2::ScanMatcher2D::Config config;
+  config.time_budget = 0.0;
+  tf2::ScanMatcher2D matcher(config);
+  tf2::ScanMatcher2D::Result result;
+  ASSERT_TRUE(matcher.match(index, scan.data(), scan.size(), tf2::Transform2D(2.15, 1.4, 0.25), result));
+  EXPECT_TRUE(result.converged);
+  EXPECT_NEAR(result.pose.x(), 2.0, 1e-4);
+  EXPECT_NEAR(result.pose.y(), 1.5, 1e-4);
+  EXPECT_NEAR(result.pose.rotation(), 0.3, 1e-4);
+  EXPECT_EQ(result.correspondences, scan.size());
+  EXPECT_LT(result.error, 1e-4);
+  for (int a = 0; a < 3; a++) {
+    EXPECT_GE(result.covariance[a * 3 + a], 0.0);
+    EXPECT_DOUBLE_EQ(result.covariance[a * 3 + (a + 1) % 3], result.covariance[(a + 1) % 3 * 3 + a]);
+  }
+
+  // too few points within the correspondence distance
+  EXPECT_FALSE(matcher.match(index, scan.data(), scan.size(), tf2::Transform2D(20.0, 20.0, 0.0), result));
+  EXPECT_EQ(result.correspondences, 0u);
+}
+
+TEST(ScanMatcher2D, match_scan)
+{
+  std::vector<tf2::LineSegment2D> map = make_map();
+  std::vector<tf2::Point2D> reference = make_scan(map, 2.0, 2.0, 0.0);
+  std::vector<tf2::Point2D> scan = make_scan(map, 2.1, 1.95, 0.05);
+
+  tf2::ScanMatcher2D::Config config;
+  config.time_budget = 0.0;
+  config.max_gap = 0.5;
+  tf2::ScanMatcher2D matcher(config);
+  matcher.set_reference(reference.data(), reference.size());
+  EXPECT_GT(matcher.reference().size(), 300u);
+  tf2::ScanMatcher2D::Result result;
+  ASSERT_TRUE(matcher.match(scan.data(), scan.size(), tf2::Transform2D(), result));
+  // the reference segments are chords of the walls, so the pose is only approximate
+  EXPECT_NEAR(result.pose.x(), 0.1, 0.01);
+  EXPECT_NEAR(result.pose.y(), -0.05, 0.01);
+  EXPECT_NEAR(result.pose.rotation(), 0.05, 0.005);
+}
+
+TEST(ScanMatcher2D, time_budget)
+{
+  std::vector<tf2::LineSegment2D> map = make_map();
+  tf2::SegmentIndex2D index;
+  index.build(map.data(), map.size(), 0.5);
+  std::vector<tf2::Point2D> scan = make_scan(map, 2.0, 1.5, 0.3);
+
+  tf2::ScanMatcher2D::Config config;
+  config.time_budget = 1e-12;
+  tf2::ScanMatcher2D matcher(config);
+  tf2::ScanMatcher2D::Result result;
+  matcher.match(index, scan.data(), scan.size(), tf2::Transform2D(2.15, 1.4, 0.25), result);
+  EXPECT_EQ(result.iterations, 1u);
+  EXPECT_FALSE(result.converged);
+}
+
+TEST(ScanMatcher2D, unlimited_time_budget)
+{
+  std::vector<tf2::LineSegment2D> map = make_map();
+  tf2::SegmentIndex2D index;
+  index.build(map.data(), map.size(), 0.5);
+  std::vector<tf2::Point2D> scan = make_scan(map, 2.0, 1.5, 0.3);
+
+  // budgets which are not finite and positive mean no limit
+  for (double budget : {-1.0, std::nan(""), std::numeric_limits<double>::infinity(), 1e300}) {
+    tf2::ScanMatcher2D::Config config;
+    config.time_budget = budget;
+    tf2::ScanMatcher2D matcher(config);
+    EXPECT_EQ(0.0, matcher.config().time_budget);
+    tf2::ScanMatcher2D::Result result;
+    ASSERT_TRUE(matcher.match(index, scan.data(), scan.size(), tf2::Transform2D(2.15, 1.4, 0.25), result));
+    EXPECT_TRUE(result.converged);
+  }
+}
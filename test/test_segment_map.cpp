@@ -0,0 +1,182 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include "gtest/gtest.h"
+#include "tf2_geometry/segment_map_file.hpp"
+
+namespace {
+std::vector<tf2::LineSegment2D> make_map()
+{
+  // a 10 x 6 room with a pillar
+  std::vector<tf2::LineSegment2D> segments = {
+    tf2::LineSegment2D(0., 0., 10., 0.), tf2::LineSegment2D(10., 0., 10., 6.),
+    tf2::LineSegment2D(10., 6., 0., 6.), tf2::LineSegment2D(0., 6., 0., 0.)};
+  for (int i = 0; i < 4; i++) {
+    double a0 = i * M_PI / 2, a1 = (i + 1) * M_PI / 2;
+    segments.push_back(tf2::LineSegment2D(5. + 0.5 * std::cos(a0), 3. + 0.5 * std::sin(a0),
+      5. + 0.5 * std::cos(a1), 3. + 0.5 * std::sin(a1)));
+  }
+  return segments;
+}
+}  // namespace
+
+TEST(SegmentIndex2D, nearest_query)
+{
+  double tolerance = 0.000001;
+  std::vector<tf2::LineSegment2D> segments = make_map();
+  tf2::SegmentIndex2D index;
+  index.build(segments.data(), segments.size(), 1.0);
+  ASSERT_EQ(segments.size(), index.size());
+
+  // brute force reference
+  for (double x = -1.0; x <= 11.0; x += 0.37) {
+    for (double y = -1.0; y <= 7.0; y += 0.41) {
+      tf2::Point2D p(x, y);
+      size_t best = 0;
+      for (size_t i = 1; i < segments.size(); i++) {
+        if (segments[i].distance_to(p) < segments[best].distance_to(p)) {
+          best = i;
+        }
+      }
+      double d;
+      size_t i = index.nearest(p, 10.0, &d);
+      ASSERT_NE(tf2::SegmentIndex2D::npos, i);
+      ASSERT_NEAR(segments[best].distance_to(p), d, tolerance);
+    }
+  }
+  ASSERT_EQ(tf2::SegmentIndex2D::npos, index.nearest(tf2::Point2D(2.0, 2.0), 1.0));
+  // unbounded radii and points far from the grid
+  const double inf = std::numeric_limits<double>::infinity(), nan = std::nan("");
+  double d;
+  ASSERT_EQ(index.nearest(tf2::Point2D(2.0, 2.0), 10.0), index.nearest(tf2::Point2D(2.0, 2.0), inf, &d));
+  ASSERT_NEAR(2.0, d, tolerance);
+  ASSERT_EQ(index.nearest(tf2::Point2D(12.0, 3.0), 10.0), index.nearest(tf2::Point2D(12.0, 3.0), inf, &d));
+  ASSERT_NEAR(2.0, d, tolerance);
+  ASSERT_NE(tf2::SegmentIndex2D::npos, index.nearest(tf2::Point2D(1e300, -1e300), inf, &d));
+  ASSERT_EQ(tf2::SegmentIndex2D::npos, index.nearest(tf2::Point2D(1e300, -1e300), 1e10));
+  ASSERT_EQ(tf2::SegmentIndex2D::npos, index.nearest(tf2::Point2D(nan, 2.0), inf));
+  ASSERT_EQ(tf2::SegmentIndex2D::npos, index.nearest(tf2::Point2D(2.0, inf), inf));
+  ASSERT_EQ(tf2::SegmentIndex2D::npos, index.nearest(tf2::Point2D(2.0, 2.0), nan));
+
+  std::vector<uint32_t> candidates;
+  index.query(tf2::Point2D(5.0, 3.0), 0.6, candidates);
+  ASSERT_GE(candidates.size(), 4u);
+  for (uint32_t i = 4; i < 8; i++) {
+    ASSERT_TRUE(std::find(candidates.begin(), candidates.end(), i) != candidates.end());
+  }
+}
+
+TEST(SegmentMapFile, round_trip)
+{
+  std::vector<tf2::LineSegment2D> segments = make_map();
+  tf2::SegmentIndex2D index;
+  index.build(segments.data(), segments.size(), 0.5);
+  std::string path = testing::TempDir() + "tf2_geometry_segment_map.bin";
+  std::string path_swapped = testing::TempDir() + "tf2_geometry_segment_map_swapped.bin";
+
+  tf2::SegmentMapFile file;
+  ASSERT_TRUE(file.write(path, index));
+  ASSERT_TRUE(file.write(path_swapped, index, true));
+
+  for (int mode = 0; mode < 3; mode++) {
+    tf2::SegmentMapFile loaded;
+    bool ok = mode == 0 ? loaded.open(path) : loaded.read(mode == 1 ? path : path_swapped);
+    ASSERT_TRUE(ok) << loaded.error();
+    const tf2::SegmentIndex2D & l = loaded.index();
+    ASSERT_EQ(index.size(), l.size());
+    ASSERT_EQ(index.grid().cols, l.grid().cols);
+    ASSERT_EQ(index.grid().rows, l.grid().rows);
+    ASSERT_EQ(index.grid().origin_x, l.grid().origin_x);
+    size_t cells = static_cast<size_t>(index.grid().cols) * index.grid().rows + 1;
+    ASSERT_TRUE(std::equal(index.cells(), index.cells() + cells, l.cells()));
+    ASSERT_TRUE(std::equal(index.items(), index.items() + index.cells()[cells - 1], l.items()));
+    for (size_t i = 0; i < index.size(); i++) {
+      ASSERT_TRUE(index.segment(i) == l.segment(i));
+    }
+    ASSERT_EQ(index.nearest(tf2::Point2D(4.2, 2.9), 2.0), l.nearest(tf2::Point2D(4.2, 2.9), 2.0));
+  }
+
+  tf2::SegmentMapFile mapped;
+  ASSERT_FALSE(mapped.open(path_swapped));
+  ASSERT_FALSE(mapped.open(testing::TempDir() + "tf2_geometry_missing.bin"));
+  std::remove(path.c_str());
+  std::remove(path_swapped.c_str());
+}
+
+TEST(SegmentMapFile, corrupt)
+{
+  std::vector<tf2::LineSegment2D> segments = make_map();
+  tf2::SegmentIndex2D index;
+  ASSERT_FALSE(index.build(segments.data(), segments.size(), 0.0));
+  ASSERT_EQ(index.size(), 0u);
+  ASSERT_EQ(tf2::SegmentIndex2D::npos, index.nearest(tf2::Point2D(1.0, 1.0), 10.0));
+
+  // non-finite segments and grids with too many cells are rejected as well
+  std::vector<tf2::LineSegment2D> invalid = segments;
+  invalid.push_back(tf2::LineSegment2D(1.0, std::nan(""), 2.0, 2.0));
+  ASSERT_FALSE(index.build(invalid.data(), invalid.size(), 0.5));
+  ASSERT_EQ(index.size(), 0u);
+  invalid.back() = tf2::LineSegment2D(1.0, 1.0, std::numeric_limits<double>::infinity(), 2.0);
+  ASSERT_FALSE(index.build(invalid.data(), invalid.size(), 0.5));
+  invalid.back() = tf2::LineSegment2D(-1e12, 0.0, 1e12, 1e12);
+  ASSERT_FALSE(index.build(invalid.data(), invalid.size(), 0.5));
+  ASSERT_EQ(index.size(), 0u);
+  ASSERT_FALSE(index.build(segments.data(), segments.size(), 1e-6));
+  ASSERT_TRUE(index.build(segments.data(), segments.size(), 0.5));
+  std::string path = testing::TempDir() + "tf2_geometry_segment_map_corrupt.bin";
+  tf2::SegmentMapFile file;
+  ASSERT_TRUE(file.write(path, index));
+  std::ifstream in(path, std::ios::binary);
+  const std::vector<char> original((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+  tf2::SegmentMapFile::Header h;
+  std::memcpy(&h, original.data(), sizeof(h));
+
+  // writes a modified copy of the file
+  auto corrupt = [&](auto modify) {
+    std::vector<char> data = original;
+    modify(data);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+  };
+  auto header = [&](std::vector<char> & data, tf2::SegmentMapFile::Header & modified) {
+    std::memcpy(data.data(), &modified, sizeof(modified));
+  };
+  tf2::SegmentMapFile loaded;
+
+  // an offset close to 2^64 wraps around when the block size is added
+  corrupt([&](std::vector<char> & data) {
+    tf2::SegmentMapFile::Header m = h;
+    m.items_offset = ~uint64_t(0) - 7;
+    header(data, m);
+  });
+  ASSERT_FALSE(loaded.open(path));
+  ASSERT_FALSE(loaded.read(path));
+  ASSERT_EQ(loaded.error(), "data block exceeds the file");
+
+  // descending cell offsets
+  const size_t cells = static_cast<size_t>(h.cols) * h.rows;
+  corrupt([&](std::vector<char> & data) {
+    uint32_t *offsets = reinterpret_cast<uint32_t *>(data.data() + h.cells_offset);
+    offsets[cells / 2] = offsets[cells] + 1;
+  });
+  ASSERT_FALSE(loaded.open(path));
+  ASSERT_EQ(loaded.error(), "inconsistent cell offsets");
+
+  // an item which refers to a segment past the end
+  corrupt([&](std::vector<char> & data) {
+    uint32_t *items = reinterpret_cast<uint32_t *>(data.data() + h.items_offset);
+    items[h.item_count - 1] = static_cast<uint32_t>(h.segment_count);
+  });
+  ASSERT_FALSE(loaded.open(path));
+  ASSERT_EQ(loaded.error(), "cell item exceeds the segments");
+  ASSERT_FALSE(loaded.read(path));
+  // trusted files skip the verification of the index blocks
+  ASSERT_TRUE(loaded.open(path, false));
+  loaded.close();
+  std::remove(path.c_str());
+}
@@ -0,0 +1,173 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/segment_rasterizer2d.hpp"
+
+namespace {
+std::vector<tf2::LineSegment2D> make_segments()
+{
+  std::vector<tf2::LineSegment2D> segments;
+  for (int i = 0; i < 40; i++) {
+    double a = i * 0.37, r = 1.0 + 0.1 * i;
+    segments.push_back(tf2::LineSegment2D(3.0 + std::cos(a), 2.5 + std::sin(a),
+      3.0 + r * std::cos(a + 2.0), 2.5 + r * std::sin(a + 2.0)));
+  }
+  segments.push_back(tf2::LineSegment2D(-10., 1., 10., 1.3));  // leaves the grid on both sides
+  segments.push_back(tf2::LineSegment2D(2., 2., 2., 2.));      // point
+  return segments;
+}
+}  // namespace
+
+TEST(SegmentRasterizer2D, center_line)
+{
+  tf2::SegmentRasterizer2D::Config config;
+  config.resolution = 0.1, config.width = 20, config.height = 10;
+  config.origin.set(1.0, 2.0, 0.0);
+  tf2::SegmentRasterizer2D rasterizer(config);
+  std::vector<int8_t> grid;
+  rasterizer.rasterize({tf2::LineSegment2D(1.05, 2.05, 2.95, 2.05)}, grid);
+  ASSERT_EQ(200u, grid.size());
+  for (size_t x = 0; x < 20; x++) {
+    ASSERT_EQ(100, grid[x]);
+    ASSERT_EQ(-1, grid[20 + x]);
+  }
+
+  // rotated origin, the map x axis is the grid y axis
+  config.origin.set(0.0, 0.0, M_PI / 2);
+  rasterizer.configure(config);
+  grid.assign(200, 0);
+  rasterizer.rasterize({tf2::LineSegment2D(-0.35, 0.05, -0.35, 0.95)}, grid);
+  size_t filled = 0;
+  for (int8_t cell : grid) {
+    filled += cell != 0;
+  }
+  ASSERT_EQ(10u, filled);
+  for (size_t x = 0; x < 10; x++) {
+    ASSERT_EQ(100, grid[3 * 20 + x]);  // map (-0.35, y) is grid (y, 0.35)
+  }
+}
+
+TEST(SegmentRasterizer2D, tiles)
+{
+  std::vector<tf2::LineSegment2D> segments = make_segments();
+  tf2::ThreadPool::Config pool_config;
+  pool_config.num_threads = 3;
+  tf2::ThreadPool pool(pool_config);
+  for (double thickness : {0.0, 0.23}) {
+    tf2::SegmentRasterizer2D::Config config;
+    config.resolution = 0.05, config.width = 123, config.height = 97, config.thickness = thickness;
+    config.origin.set(0.2, -0.1, 0.3);
+    config.tile_size = 1024;
+    tf2::SegmentRasterizer2D single(config);
+    std::vector<int8_t> expected(single.size(), 0);
+    single.rasterize(segments.data(), segments.size(), expected.data());
+
+    // the tiles produce the same cells as one large tile
+    for (uint32_t tile_size : {1u, 7u, 32u}) {
+      config.tile_size = tile_size;
+      tf2::SegmentRasterizer2D tiled(config);
+      std::vector<int8_t> grid(tiled.size(), 0);
+      tiled.rasterize(tf2::ExecutionPolicy::thread_pool(pool), segments.data(), segments.size(), grid.data());
+      ASSERT_EQ(expected, grid);
+    }
+
+    // every cell center within half the thickness is filled
+    for (uint32_t y = 0; y < config.height; y++) {
+      for (uint32_t x = 0; x < config.width; x++) {
+        tf2::Point2D center = config.origin.transform_into_parent(
+          tf2::Point2D((x + 0.5) * config.resolution, (y + 0.5) * config.resolution));
+        double d = 1e9;
+        for (const auto & s : segments) {
+          d = std::min(d, s.distance_to(center));
+        }
+        if (d < 0.5 * thickness - 1e-9) {
+          ASSERT_EQ(100, expected[y * config.width + x]);
+        }
+        if (d > 0.5 * thickness + 2.0 * config.resolution) {
+          ASSERT_EQ(0, expected[y * config.width + x]);
+        }
+      }
+    }
+  }
+}
+
+TEST(SegmentRasterizer2D, window)
+{
+  std::vector<tf2::LineSegment2D> segments = make_segments();
+  tf2::SegmentRasterizer2D::Config config;
+  config.resolution = 0.05, config.width = 123, config.height = 97, config.thickness = 0.23;
+  config.origin.set(0.2, -0.1, 0.3);
+  config.tile_size = 16;
+  tf2::SegmentRasterizer2D rasterizer(config);
+  std::vector<int8_t> expected(rasterizer.size(), 0);
+  rasterizer.rasterize(segments.data(), segments.size(), expected.data());
+
+  // a window has the cells of the full draw inside and leaves the cells outside untouched
+  const uint32_t x0 = 13, y0 = 40, x1 = 70, y1 = 200;
+  std::vector<int8_t> grid(rasterizer.size(), 0);
+  rasterizer.rasterize(segments.data(), segments.size(), grid.data(), x0, y0, x1, y1);
+  size_t filled = 0;
+  for (uint32_t y = 0; y < config.height; y++) {
+    for (uint32_t x = 0; x < config.width; x++) {
+      const size_t i = y * config.width + x;
+      if (x >= x0 && x <= x1 && y >= y0 && y <= y1) {
+        ASSERT_EQ(expected[i], grid[i]);
+        filled += grid[i] != 0;
+      } else {
+        ASSERT_EQ(0, grid[i]);
+      }
+    }
+  }
+  ASSERT_GT(filled, 0u);
+
+  // empty windows draw nothing
+  std::vector<int8_t> empty(rasterizer.size(), 0);
+  rasterizer.rasterize(segments.data(), segments.size(), empty.data(), 50, 0, 40, 96);
+  ASSERT_EQ(std::vector<int8_t>(rasterizer.size(), 0), empty);
+}
+
+TEST(SegmentRasterizer2D, invalid_config)
+{
+  std::vector<tf2::LineSegment2D> segments = make_segments();
+  tf2::SegmentRasterizer2D::Config config;
+  config.width = 40, config.height = 30;
+  tf2::SegmentRasterizer2D reference(config);
+  std::vector<int8_t> expected(reference.size(), 0);
+  reference.rasterize(segments.data(), segments.size(), expected.data());
+
+  // invalid resolutions and thicknesses fall back to the default
+  for (double value : {0.0, -0.1, std::nan(""), std::numeric_limits<double>::infinity()}) {
+    config.resolution = value, config.thickness = value;
+    tf2::SegmentRasterizer2D rasterizer(config);
+    ASSERT_EQ(tf2::SegmentRasterizer2D::Config().resolution, rasterizer.config().resolution);
+    ASSERT_EQ(0.0, rasterizer.config().thickness);
+    std::vector<int8_t> grid(rasterizer.size(), 0);
+    rasterizer.rasterize(segments.data(), segments.size(), grid.data());
+    ASSERT_EQ(expected, grid);
+  }
+
+  // segments with non-finite end points are skipped
+  const double inf = std::numeric_limits<double>::infinity();
+  config = tf2::SegmentRasterizer2D::Config();
+  config.width = 40, config.height = 30, config.thickness = 0.1;
+  tf2::SegmentRasterizer2D thick(config);
+  std::vector<int8_t> expected_thick(thick.size(), 0), grid_thick(thick.size(), 0);
+  thick.rasterize(segments.data(), segments.size(), expected_thick.data());
+  std::vector<tf2::LineSegment2D> invalid = segments;
+  invalid.push_back(tf2::LineSegment2D(std::nan(""), 0.5, 1.0, 0.5));
+  invalid.push_back(tf2::LineSegment2D(0.5, 0.5, 0.5, std::nan("")));
+  invalid.push_back(tf2::LineSegment2D(-inf, 0.5, inf, 0.5));
+  invalid.push_back(tf2::LineSegment2D(0.5, 0.5, 1.0, inf));
+  thick.rasterize(invalid.data(), invalid.size(), grid_thick.data());
+  ASSERT_EQ(expected_thick, grid_thick);
+
+  // huge thicknesses are bounded and fill the whole grid
+  config.resolution = 0.05, config.thickness = 1e300;
+  tf2::SegmentRasterizer2D rasterizer(config);
+  ASSERT_LT(rasterizer.config().thickness, 1e300);
+  std::vector<int8_t> grid(rasterizer.size(), 0);
+  rasterizer.rasterize(segments.data(), segments.size(), grid.data());
+  ASSERT_EQ(std::vector<int8_t>(rasterizer.size(), 100), grid);
+}
@@ -0,0 +1,99 @@
+#include <cmath>
+#include "gtest/gtest.h"
+#include "tf2_geometry/linesegment2d_t.hpp"
+#include "tf2_geometry/plane3d_t.hpp"
+#include "tf2_geometry/transform2d_t.hpp"
+
+TEST(Templates, transform2d)
+{
+  double tolerance = 0.0001;
+  tf2::Transform2D a(1.0, 2.0, 0.5), b(-0.5, 0.3, 3.0);
+  tf2::Transform2Df af(a), bf(b);
+  tf2::Point2D p = a * tf2::Point2D(0.3, -0.7);
+  float x, y;
+  af.transform_into_parent(0.3f, -0.7f, x, y);
+  ASSERT_NEAR(p.x(), x, tolerance);
+  ASSERT_NEAR(p.y(), y, tolerance);
+  af.transform_into_child(x, y, x, y);
+  ASSERT_NEAR(0.3, x, tolerance);
+  ASSERT_NEAR(-0.7, y, tolerance);
+
+  tf2::Transform2D ab = a * b;
+  tf2::Transform2Df abf = af * bf;
+  ASSERT_NEAR(ab.x(), abf.x(), tolerance);
+  ASSERT_NEAR(ab.y(), abf.y(), tolerance);
+  ASSERT_NEAR(ab.rotation(), abf.rotation(), tolerance);
+  ASSERT_NEAR(std::cos(ab.rotation()), abf.cos(), tolerance);
+  ASSERT_NEAR(std::sin(ab.rotation()), abf.sin(), tolerance);
+
+  tf2::Transform2Df i = af.inverse() * af;
+  ASSERT_NEAR(0.0, i.x(), tolerance);
+  ASSERT_NEAR(0.0, i.y(), tolerance);
+  ASSERT_NEAR(0.0, i.rotation(), tolerance);
+  tf2::Transform2D c = a / b;
+  tf2::Transform2Df cf;
+  af.transform_into_child(bf, cf);
+  ASSERT_NEAR(c.x(), cf.x(), tolerance);
+  ASSERT_NEAR(c.rotation(), cf.rotation(), tolerance);
+}
+
+TEST(Templates, transform2d_pack)
+{
+  double tolerance = 0.000001;
+  using Pack = tf2::simd::Pack4d;
+  Pack x, y, r;
+  for (size_t i = 0; i < Pack::size(); i++) {
+    x[i] = i * 0.5, y[i] = -1.0 + i, r[i] = -2.0 + i * 1.3;
+  }
+  tf2::Transform2DT<Pack> tf(x, y, r);
+  Pack dx, dy;
+  tf.transform_into_parent(Pack(1.0), Pack(2.0), dx, dy);
+  tf2::Transform2DT<Pack> tf_sq = tf * tf;
+  for (size_t i = 0; i < Pack::size(); i++) {
+    tf2::Transform2D lane(x[i], y[i], r[i]);
+    tf2::Point2D p = lane * tf2::Point2D(1.0, 2.0);
+    ASSERT_NEAR(p.x(), dx[i], tolerance);
+    ASSERT_NEAR(p.y(), dy[i], tolerance);
+    tf2::Transform2D lane2 = lane * lane;
+    ASSERT_NEAR(lane2.x(), tf_sq.x()[i], tolerance);
+    ASSERT_NEAR(lane2.rotation(), tf_sq.rotation()[i], tolerance);
+  }
+}
+
+TEST(Templates, linesegment2d_pack)
+{
+  double tolerance = 0.0001;
+  using Pack = tf2::simd::Pack8f;
+  float x0[8], y0[8], x1[8], y1[8];
+  for (int i = 0; i < 8; i++) {
+    x0[i] = -1.0f + i, y0[i] = 0.5f * i, x1[i] = 2.5f, y1[i] = 3.0f - i;
+  }
+  tf2::LineSegment2DT<Pack> segments(Pack::load(x0), Pack::load(y0), Pack::load(x1), Pack::load(y1));
+  Pack d = segments.distance_to(Pack(0.5f), Pack(4.0f));
+  float a[8];
+  segments.length().store(a);
+  tf2::Line2DT<Pack> line(Pack(0.f), Pack(0.f), Pack(1.f), Pack(1.f));
+  Pack ix, iy;
+  line.intersection(segments, ix, iy);
+  for (int i = 0; i < 8; i++) {
+    tf2::LineSegment2D segment(x0[i], y0[i], x1[i], y1[i]);
+    ASSERT_NEAR(segment.distance_to(tf2::Point2D(0.5, 4.0)), d[i], tolerance);
+    ASSERT_NEAR(segment.length(), a[i], tolerance);
+    tf2::Point2D p = tf2::Line2D(0., 0., 1., 1.).intersection(segment);
+    ASSERT_NEAR(p.x(), ix[i], tolerance);
+    ASSERT_NEAR(p.y(), iy[i], tolerance);
+  }
+}
+
+TEST(Templates, plane3d)
+{
+  double tolerance = 0.0001;
+  tf2::Plane3D plane(tf2::Point3D(0, 0, 1), tf2::Point3D(1, 0, 2), tf2::Point3D(0, 1, 1));
+  tf2::Plane3Df planef(plane);
+  tf2::Plane3DT<tf2::simd::Pack4f> planes(plane);
+  ASSERT_NEAR(plane.distance_to(tf2::Point3D(3.0, -2.0, 2.0)), planef.distance_to(3.0f, -2.0f, 2.0f), tolerance);
+  ASSERT_NEAR(plane.distance_to(tf2::Point3D(3.0, -2.0, 2.0)), planes.distance_to(3.0f, -2.0f, 2.0f)[3], tolerance);
+  tf2::Plane3Dd p;
+  p.create(0., 0., 2., 0., 0., 4.);
+  ASSERT_NEAR(-1.0, p.distance_to(5., 5., 1.), tolerance);
+}
@@ -0,0 +1,122 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tf2_geometry/trajectory2d.hpp"
+
+TEST(Trajectory2D, push_back)
+{
+  tf2::Trajectory2D trajectory;
+  EXPECT_TRUE(trajectory.empty());
+  EXPECT_EQ(trajectory.length(), 0.0);
+  EXPECT_TRUE(trajectory.push_back(0.0, tf2::Transform2D(0.0, 0.0, 0.0)));
+  EXPECT_TRUE(trajectory.push_back(1.0, tf2::Transform2D(3.0, 4.0, 0.5)));
+  EXPECT_TRUE(trajectory.push_back(3.0, tf2::Transform2D(3.0, 6.0, 1.0)));
+  // time stamps must increase
+  EXPECT_FALSE(trajectory.push_back(3.0, tf2::Transform2D(9.0, 9.0, 0.0)));
+  EXPECT_FALSE(trajectory.push_back(2.0, tf2::Transform2D(9.0, 9.0, 0.0)));
+  EXPECT_EQ(trajectory.size(), 3u);
+  EXPECT_DOUBLE_EQ(trajectory.arc_length(1), 5.0);
+  EXPECT_DOUBLE_EQ(trajectory.arc_length(2), 7.0);
+  EXPECT_DOUBLE_EQ(trajectory.length(), 7.0);
+  EXPECT_DOUBLE_EQ(trajectory.time(2), 3.0);
+  EXPECT_DOUBLE_EQ(trajectory.pose(1).y(), 4.0);
+  trajectory.clear();
+  EXPECT_TRUE(trajectory.empty());
+
+  // non-finite time stamps are rejected, also as the first sample
+  EXPECT_FALSE(trajectory.push_back(std::nan(""), tf2::Transform2D(0.0, 0.0, 0.0)));
+  EXPECT_FALSE(trajectory.push_back(-std::numeric_limits<double>::infinity(), tf2::Transform2D(0.0, 0.0, 0.0)));
+  EXPECT_TRUE(trajectory.empty());
+  EXPECT_TRUE(trajectory.push_back(0.0, tf2::Transform2D(0.0, 0.0, 0.0)));
+  EXPECT_FALSE(trajectory.push_back(std::numeric_limits<double>::infinity(), tf2::Transform2D(1.0, 0.0, 0.0)));
+  EXPECT_TRUE(trajectory.push_back(1.0, tf2::Transform2D(1.0, 0.0, 0.0)));
+  EXPECT_EQ(trajectory.size(), 2u);
+}
+
+TEST(Trajectory2D, interpolate)
+{
+  tf2::Trajectory2D trajectory;
+  trajectory.push_back(1.0, tf2::Transform2D(0.0, 0.0, 3.0));
+  trajectory.push_back(2.0, tf2::Transform2D(2.0, 0.0, -3.0));
+  trajectory.push_back(4.0, tf2::Transform2D(2.0, 2.0, -2.0));
+
+  tf2::Transform2D pose;
+  trajectory.at_time(1.5, pose);
+  EXPECT_DOUBLE_EQ(pose.x(), 1.0);
+  EXPECT_DOUBLE_EQ(pose.y(), 0.0);
+  // the rotation takes the short way over +-pi
+  EXPECT_NEAR(std::cos(pose.rotation()), -1.0, 1e-12);
+  trajectory.at_time(3.0, pose);
+  EXPECT_DOUBLE_EQ(pose.x(), 2.0);
+  EXPECT_DOUBLE_EQ(pose.y(), 1.0);
+  EXPECT_NEAR(pose.rotation(), -2.5, 1e-12);
+  EXPECT_NEAR(trajectory.at_arc_length(3.0, pose).y(), 1.0, 1e-12);
+  EXPECT_NEAR(pose.x(), 2.0, 1e-12);
+
+  // queries outside of the trajectory are clamped
+  EXPECT_DOUBLE_EQ(trajectory.at_time(0.0, pose).x(), 0.0);
+  EXPECT_DOUBLE_EQ(pose.rotation(), 3.0);
+  EXPECT_DOUBLE_EQ(trajectory.at_arc_length(10.0, pose).y(), 2.0);
+  EXPECT_DOUBLE_EQ(pose.rotation(), -2.0);
+
+  // a single sample is constant
+  tf2::Trajectory2D single;
+  single.push_back(0.0, tf2::Transform2D(1.0, 2.0, 0.3));
+  EXPECT_DOUBLE_EQ(single.at_time(5.0, pose).y(), 2.0);
+}
+
+TEST(Trajectory2D, cursor)
+{
+  tf2::Trajectory2D trajectory;
+  for (size_t i = 0; i < 100; i++) {
+    // stationary samples create segments of zero arc length
+    trajectory.push_back(0.1 * i, tf2::Transform2D((i / 2) * 0.5, 0.0, 0.0));
+  }
+  tf2::Trajectory2D::Cursor cursor;
+  for (double t = -1.0; t < 11.0; t += 0.013) {
+    EXPECT_EQ(trajectory.find_time(t, &cursor), trajectory.find_time(t));
+  }
+  for (double s = 30.0; s > -1.0; s -= 0.07) {
+    const size_t i = trajectory.find_arc_length(s, &cursor);
+    EXPECT_EQ(i, trajectory.find_arc_length(s));
+    EXPECT_EQ(cursor.index, i);
+  }
+  // jumps fall back to the binary search
+  cursor.index = 0;
+  EXPECT_EQ(trajectory.find_time(8.05, &cursor), 80u);
+  EXPECT_EQ(trajectory.find_time(0.05, &cursor), 0u);
+  EXPECT_EQ(trajectory.find_time(100.0, &cursor), 98u);
+}
+
+TEST(Trajectory2D, resample)
+{
+  tf2::Trajectory2D trajectory;
+  trajectory.push_back(0.0, tf2::Transform2D(0.0, 0.0, 0.0));
+  trajectory.push_back(2.0, tf2::Transform2D(1.0, 0.0, 0.0));
+  trajectory.push_back(3.0, tf2::Transform2D(1.0, 1.0, M_PI / 2));
+
+  std::vector<double> x(8), y(8), theta(8);
+  EXPECT_EQ(trajectory.resample_arc_length(0.5, x.data(), y.data(), theta.data(), x.size()), 5u);
+  const double expected_x[] = {0.0, 0.5, 1.0, 1.0, 1.0}, expected_y[] = {0.0, 0.0, 0.0, 0.5, 1.0};
+  for (size_t i = 0; i < 5; i++) {
+    EXPECT_NEAR(x[i], expected_x[i], 1e-12);
+    EXPECT_NEAR(y[i], expected_y[i], 1e-12);
+  }
+  EXPECT_NEAR(theta[3], M_PI / 4, 1e-12);
+
+  // only the capacity is written, the return value is the size needed
+  std::fill(x.begin(), x.end(), -1.0);
+  EXPECT_EQ(trajectory.resample_time(0.25, x.data(), y.data(), theta.data(), 4), 13u);
+  EXPECT_NEAR(x[3], 0.375, 1e-12);
+  EXPECT_EQ(x[4], -1.0);
+  EXPECT_EQ(trajectory.resample_time(0.0, x.data(), y.data(), theta.data(), 4), 0u);
+
+  // steps which are not finite or need too many samples are rejected
+  for (double step : {std::nan(""), std::numeric_limits<double>::infinity(), 1e-300,
+      std::numeric_limits<double>::denorm_min()})
+  {
+    EXPECT_EQ(trajectory.resample_time(step, x.data(), y.data(), theta.data(), 4), 0u);
+    EXPECT_EQ(trajectory.resample_arc_length(step, x.data(), y.data(), theta.data(), 4), 0u);
+  }
+}
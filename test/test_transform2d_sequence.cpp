@@ -0,0 +1,57 @@
+#include <cmath>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tf2_geometry/execution.hpp"
+#include "tf2_geometry/transform2d_sequence.hpp"
+
+namespace {
+std::vector<tf2::Transform2D> make_increments(size_t n)
+{
+  std::vector<tf2::Transform2D> increments(n);
+  increments[0].set(1.0, -2.0, 0.5);
+  for (size_t i = 1; i < n; i++) {
+    increments[i].set(0.01 + 0.005 * std::sin(i * 0.1), 0.002 * std::cos(i * 0.3), 0.003 * std::sin(i * 0.01));
+  }
+  return increments;
+}
+}  // namespace
+
+TEST(compose_prefix, sequential)
+{
+  std::vector<tf2::Transform2D> increments = make_increments(1000), poses(1000);
+  tf2::compose_prefix(increments.data(), increments.size(), poses.data());
+  tf2::Transform2D expected(increments[0]);
+  for (size_t i = 0; i < increments.size(); i++) {
+    if (i > 0) {
+      expected.set(expected * increments[i]);
+    }
+    ASSERT_NEAR(poses[i].x(), expected.x(), 1e-9);
+    ASSERT_NEAR(poses[i].y(), expected.y(), 1e-9);
+    ASSERT_NEAR(poses[i].rotation(), expected.rotation(), 1e-9);
+    ASSERT_NEAR(poses[i].cos_theta(), std::cos(poses[i].rotation()), 1e-12);
+    ASSERT_NEAR(poses[i].sin_theta(), std::sin(poses[i].rotation()), 1e-12);
+  }
+
+  // in place
+  tf2::compose_prefix(increments.data(), increments.size(), increments.data());
+  EXPECT_DOUBLE_EQ(increments.back().x(), poses.back().x());
+  EXPECT_DOUBLE_EQ(increments.back().rotation(), poses.back().rotation());
+}
+
+TEST(compose_prefix, parallel)
+{
+  const size_t n = 100000;
+  std::vector<tf2::Transform2D> increments = make_increments(n), expected(n);
+  tf2::compose_prefix(increments.data(), n, expected.data());
+
+  tf2::ThreadPool::Config config;
+  config.num_threads = 3;
+  tf2::ThreadPool pool(config);
+  tf2::compose_prefix(tf2::ExecutionPolicy::thread_pool(pool), increments.data(), n, increments.data());
+  for (size_t i = 0; i < n; i += 97) {
+    ASSERT_NEAR(increments[i].x(), expected[i].x(), 1e-8);
+    ASSERT_NEAR(increments[i].y(), expected[i].y(), 1e-8);
+    ASSERT_NEAR(std::cos(increments[i].rotation() - expected[i].rotation()), 1.0, 1e-12);
+    ASSERT_NEAR(increments[i].cos_theta(), std::cos(increments[i].rotation()), 1e-12);
+  }
+}
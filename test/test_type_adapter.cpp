@@ -0,0 +1,98 @@
+#include <cmath>
+#include "gtest/gtest.h"
+#include "tf2_geometry/type_adapter.hpp"
+
+TEST(TypeAdapter, pose2d)
+{
+  double tolerance = 0.000001;
+  static_assert(tf2::Pose2DAdapter::is_specialized::value, "Pose2D adapter");
+  tf2::Transform2D src(1.5, -2.0, 0.7), des(0., 0., 0.);
+  geometry_msgs::msg::Pose2D msg;
+  tf2::Pose2DAdapter::convert_to_ros_message(src, msg);
+  EXPECT_NEAR(1.5, msg.x, tolerance);
+  EXPECT_NEAR(-2.0, msg.y, tolerance);
+  EXPECT_NEAR(0.7, msg.theta, tolerance);
+  tf2::Pose2DAdapter::convert_to_custom(msg, des);
+  EXPECT_NEAR(src.x(), des.x(), tolerance);
+  EXPECT_NEAR(src.y(), des.y(), tolerance);
+  EXPECT_NEAR(src.rotation(), des.rotation(), tolerance);
+}
+
+TEST(TypeAdapter, transform_stamped)
+{
+  double tolerance = 0.000001;
+  tf2::Transform2DStamped src, des;
+  src.header.frame_id = "map";
+  src.child_frame_id = "base_link";
+  src.transform.set(3.0, 4.0, -2.5);
+  geometry_msgs::msg::TransformStamped msg;
+  tf2::Transform2DStampedAdapter::convert_to_ros_message(src, msg);
+  EXPECT_EQ("map", msg.header.frame_id);
+  EXPECT_EQ("base_link", msg.child_frame_id);
+  EXPECT_NEAR(0.0, msg.transform.translation.z, tolerance);
+  EXPECT_NEAR(std::cos(-1.25), msg.transform.rotation.w, tolerance);
+  tf2::Transform2DStampedAdapter::convert_to_custom(msg, des);
+  EXPECT_EQ("base_link", des.child_frame_id);
+  EXPECT_NEAR(3.0, des.transform.x(), tolerance);
+  EXPECT_NEAR(4.0, des.transform.y(), tolerance);
+  EXPECT_NEAR(-2.5, des.transform.rotation(), tolerance);
+}
+
+TEST(TypeAdapter, point_cloud)
+{
+  double tolerance = 0.0001;
+  tf2::PointCloud2D src, des;
+  src.header.frame_id = "laser";
+  for (int i = 0; i < 10; i++) {
+    src.points.push_back(tf2::Point2D(0.5 * i, -0.25 * i));
+  }
+  sensor_msgs::msg::PointCloud2 msg;
+  tf2::PointCloud2DAdapter::convert_to_ros_message(src, msg);
+  EXPECT_EQ(10u, msg.width);
+  EXPECT_EQ(1u, msg.height);
+  EXPECT_EQ(msg.row_step * msg.height, msg.data.size());
+  tf2::PointCloud2DAdapter::convert_to_custom(msg, des);
+  EXPECT_EQ("laser", des.header.frame_id);
+  ASSERT_EQ(src.points.size(), des.points.size());
+  for (size_t i = 0; i < src.points.size(); i++) {
+    EXPECT_NEAR(src.points[i].x(), des.points[i].x(), tolerance);
+    EXPECT_NEAR(src.points[i].y(), des.points[i].y(), tolerance);
+  }
+
+  // float64 cloud with an extra intensity field in front
+  sensor_msgs::msg::PointCloud2 msg64;
+  msg64.height = 1, msg64.width = 2, msg64.point_step = 24, msg64.row_step = 48;
+  msg64.fields.resize(3);
+  const char * names[3] = {"intensity", "x", "y"};
+  for (uint32_t i = 0; i < 3; i++) {
+    msg64.fields[i].name = names[i];
+    msg64.fields[i].offset = 8 * i;
+    msg64.fields[i].datatype = sensor_msgs::msg::PointField::FLOAT64;
+    msg64.fields[i].count = 1;
+  }
+  double values[6] = {9.0, 1.0, 2.0, 9.0, 3.0, 4.0};
+  msg64.data.resize(sizeof(values));
+  std::memcpy(msg64.data.data(), values, sizeof(values));
+  tf2::PointCloud2DAdapter::convert_to_custom(msg64, des);
+  ASSERT_EQ(2u, des.points.size());
+  EXPECT_NEAR(3.0, des.points[1].x(), tolerance);
+  EXPECT_NEAR(4.0, des.points[1].y(), tolerance);
+
+  // width * point_step wraps in 32 bit and must not pass the size checks
+  sensor_msgs::msg::PointCloud2 wrapped = msg64;
+  wrapped.width = 1u << 29, wrapped.point_step = 24, wrapped.row_step = 48;
+  ASSERT_LT(static_cast<uint32_t>(wrapped.width * wrapped.point_step), wrapped.row_step);
+  tf2::PointCloud2DAdapter::convert_to_custom(wrapped, des);
+  EXPECT_TRUE(des.points.empty());
+
+  // height * row_step wraps in 32 bit
+  wrapped = msg64;
+  wrapped.height = 1u << 28, wrapped.row_step = 48, wrapped.width = 2;
+  tf2::PointCloud2DAdapter::convert_to_custom(wrapped, des);
+  EXPECT_TRUE(des.points.empty());
+
+  // unsupported layout
+  msg64.fields[1].datatype = sensor_msgs::msg::PointField::FLOAT32;
+  tf2::PointCloud2DAdapter::convert_to_custom(msg64, des);
+  EXPECT_TRUE(des.points.empty());
+}
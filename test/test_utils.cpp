@@ -0,0 +1,120 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "tf2_geometry/utils.hpp"
+
+struct QuaternionMsg
+{
+  double x, y, z, w;
+};
+
+// distance of a from the expected value e in units in the last place of e
+double ulps(double a, double e)
+{
+  if (a == e) {
+    return 0.0;
+  }
+  return std::fabs(a - e) / (std::nextafter(std::fabs(e), std::numeric_limits<double>::infinity()) - std::fabs(e));
+}
+
+QuaternionMsg from_euler(double roll, double pitch, double yaw)
+{
+  double cy = std::cos(yaw * 0.5), sy = std::sin(yaw * 0.5);
+  double cp = std::cos(pitch * 0.5), sp = std::sin(pitch * 0.5);
+  double cr = std::cos(roll * 0.5), sr = std::sin(roll * 0.5);
+  return QuaternionMsg{sr * cp * cy - cr * sp * sy, cr * sp * cy + sr * cp * sy,
+    cr * cp * sy - sr * sp * cy, cr * cp * cy + sr * sp * sy};
+}
+
+TEST(Utils, quaternion_to_euler)
+{
+  double tolerance = 0.000001;
+  QuaternionMsg q = from_euler(0.1, -0.2, 0.3);
+  ASSERT_NEAR(0.1, tf2::QuaternionToRoll(q), tolerance);
+  ASSERT_NEAR(-0.2, tf2::QuaternionToPitch(q), tolerance);
+  ASSERT_NEAR(0.3, tf2::QuaternionToYaw(q), tolerance);
+  double roll, pitch, yaw;
+  tf2::QuaternionToEuler(q, roll, pitch, yaw);
+  ASSERT_NEAR(0.1, roll, tolerance);
+  ASSERT_NEAR(-0.2, pitch, tolerance);
+  ASSERT_NEAR(0.3, yaw, tolerance);
+
+  std::vector<QuaternionMsg> src;
+  for (int i = 0; i < 300; i++) {
+    src.push_back(from_euler(0.01 * i - 1.0, 0.005 * i - 0.7, 0.02 * i - 3.0));
+  }
+  std::vector<double> r(src.size()), p(src.size()), y(src.size());
+  tf2::QuaternionToEuler(src.data(), src.size(), r.data(), p.data(), y.data());
+  // the kernels are within 1 and 3 ULP of std::, FMA contraction may round the staged arguments differently
+  const double max_ulps = 4.0;
+  for (size_t i = 0; i < src.size(); i++) {
+    tf2::QuaternionToEuler(src[i], roll, pitch, yaw);
+    ASSERT_LE(ulps(r[i], roll), max_ulps);
+    ASSERT_LE(ulps(p[i], pitch), max_ulps);
+    ASSERT_LE(ulps(y[i], yaw), max_ulps);
+  }
+  tf2::QuaternionToYaw(src.data(), src.size(), y.data());
+  for (size_t i = 0; i < src.size(); i++) {
+    ASSERT_LE(ulps(y[i], tf2::QuaternionToYaw(src[i])), max_ulps);
+  }
+}
+
+TEST(Utils, quaternion_to_yaw_planar)
+{
+  double tolerance = 0.000001;
+  std::vector<QuaternionMsg> src;
+  for (int i = -31; i <= 31; i++) {
+    src.push_back(from_euler(0., 0., 0.1 * i));
+  }
+  std::vector<double> yaw(src.size());
+  tf2::QuaternionToYawPlanar(src.data(), src.size(), yaw.data());
+  for (size_t i = 0; i < src.size(); i++) {
+    ASSERT_NEAR(tf2::QuaternionToYaw(src[i]), tf2::QuaternionToYawPlanar(src[i]), tolerance);
+    // atan2 within 1 ULP of std::, the staged arguments may be contracted into FMA differently
+    ASSERT_LE(ulps(yaw[i], tf2::QuaternionToYawPlanar(src[i])), 4.0);
+  }
+  // negated quaternion represents the same rotation
+  QuaternionMsg q = from_euler(0., 0., 3.0);
+  q = QuaternionMsg{-q.x, -q.y, -q.z, -q.w};
+  ASSERT_NEAR(3.0, tf2::QuaternionToYawPlanar(q), tolerance);
+}
+
+TEST(Utils, simd_atan2_asin)
+{
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0), exponent(-10.0, 10.0);
+  for (int i = 0; i < 100000; i++) {
+    double y[4], x[4], s[4], a[4], b[4];
+    for (int k = 0; k < 4; k++) {
+      y[k] = uniform(gen) * std::pow(10.0, exponent(gen));
+      x[k] = uniform(gen) * std::pow(10.0, exponent(gen));
+      s[k] = uniform(gen);
+    }
+    tf2::simd::atan2_4(y, x, a);
+    tf2::simd::asin4(s, b);
+    for (int k = 0; k < 4; k++) {
+      ASSERT_LE(ulps(a[k], std::atan2(y[k], x[k])), 1.0) << y[k] << " " << x[k];
+      ASSERT_LE(ulps(b[k], std::asin(s[k])), 3.0) << s[k];
+    }
+  }
+  // signed zeros, infinities and equal magnitudes as std::atan2
+  const double inf = std::numeric_limits<double>::infinity();
+  const double y[12] = {0.0, -0.0, 0.0, -0.0, inf, -inf, inf, 1.0, -1.0, inf, 2.0, -2.0};
+  const double x[12] = {0.0, 0.0, -0.0, -0.0, inf, inf, -inf, inf, -inf, 1.0, -2.0, 2.0};
+  double a[12];
+  for (int k = 0; k < 12; k += 4) {
+    tf2::simd::atan2_4(y + k, x + k, a + k);
+  }
+  for (int k = 0; k < 12; k++) {
+    ASSERT_EQ(std::atan2(y[k], x[k]), a[k]) << y[k] << " " << x[k];
+    ASSERT_EQ(std::signbit(std::atan2(y[k], x[k])), std::signbit(a[k])) << y[k] << " " << x[k];
+  }
+  const double s[4] = {1.0, -1.0, 0.0, 1.5};
+  tf2::simd::asin4(s, a);
+  ASSERT_EQ(std::asin(1.0), a[0]);
+  ASSERT_EQ(std::asin(-1.0), a[1]);
+  ASSERT_EQ(0.0, a[2]);
+  ASSERT_TRUE(std::isnan(a[3]));
+}